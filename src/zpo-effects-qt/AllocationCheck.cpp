@@ -0,0 +1,127 @@
+/*
+ * Soubor: AllocationCheck.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "AllocationCheck.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+#include <opencv2/highgui/highgui.hpp> // cv::VideoCapture
+
+#include "FrameProcessor.h"
+#include "MemoryTracker.h"
+
+/**
+ * Spusteni kontroly. Pro kazdy filtr se zpracuje warm-up snimku a pak
+ * zadany pocet snimku, u kterych nesmi dojit k zadne alokaci. Predchozi
+ * vystup se drzi do dalsiho snimku, jako by ho drzelo GUI.
+ *
+ * @param commandLine argumenty prikazove radky
+ * @return 0 - zadny filtr po zahrati nealokuje
+ */
+int AllocationCheck::run(const CommandLine& commandLine)
+{
+    if (!MemoryTracker::isSupported())
+    {
+        std::cerr << "Allocation tracking is not supported on this platform" << std::endl;
+        return 1;
+    }
+
+    cv::VideoCapture capture;
+    std::vector<cv::Mat> frames;
+
+    if (!commandLine.getInputs().empty())
+    {
+        if (!capture.open(commandLine.getInputs().front()))
+        {
+            std::cerr << "Could not load video: " << commandLine.getInputs().front() << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        cv::Size size = commandLine.getSizes().empty() ? cv::Size(640, 480)
+                                                       : commandLine.getSizes().front();
+
+        // Dva ruzne snimky, aby se vstup menil jako u videa
+        for (int i = 0; i < 2; i++)
+        {
+            cv::Mat frame(size, CV_8UC3);
+            cv::randu(frame, cv::Scalar::all(0), cv::Scalar::all(256));
+            frames.push_back(frame);
+        }
+    }
+
+    char line[256];
+    snprintf(line, sizeof(line), "%-20s %14s %16s %16s %6s",
+             "filter", "warm-up allocs", "allocs/frame max", "bytes/frame max", "result");
+    std::cout << line << std::endl;
+
+    int failed = 0;
+    int frameCount = commandLine.getWarmup() + commandLine.getIterations();
+
+    for (ImageFilter::Type filterType : commandLine.getFilterTypes())
+    {
+        FrameProcessor processor;
+        processor.setFilterType(filterType);
+
+        cv::Mat previous;
+        long long warmupAllocations = 0;
+        long long maxAllocations = 0;
+        long long maxBytes = 0;
+
+        if (capture.isOpened())
+        {
+            capture.set(CV_CAP_PROP_POS_FRAMES, 0);
+        }
+
+        for (int i = 0; i < frameCount; i++)
+        {
+            if (capture.isOpened())
+            {
+                if (!capture.read(processor.input()))
+                {
+                    capture.set(CV_CAP_PROP_POS_FRAMES, 0);
+                    capture.read(processor.input());
+                }
+            }
+            else
+            {
+                frames[i % frames.size()].copyTo(processor.input());
+            }
+
+            MemoryTracker::start();
+            cv::Mat output = processor.process();
+            MemoryTracker::Stats stats = MemoryTracker::stop();
+
+            previous = output;
+
+            if (i < commandLine.getWarmup())
+            {
+                warmupAllocations += stats.allocations;
+            }
+            else
+            {
+                maxAllocations = std::max(maxAllocations, stats.allocations);
+                maxBytes = std::max(maxBytes, stats.allocatedBytes);
+            }
+        }
+
+        bool ok = maxAllocations == 0;
+        failed += ok ? 0 : 1;
+
+        snprintf(line, sizeof(line), "%-20s %14lld %16lld %16lld %6s",
+                 ImageFilter::typeName(filterType), warmupAllocations,
+                 maxAllocations, maxBytes, ok ? "OK" : "FAIL");
+        std::cout << line << std::endl;
+    }
+
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,26 @@
+/*
+ * Soubor: AllocationCheck.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef ALLOCATIONCHECK_H
+#define	ALLOCATIONCHECK_H
+
+#include "CommandLine.h"
+
+/**
+ * Kontrola, ze filtrace videa po zahrati (warm-up) nealokuje na halde.
+ * Meri se zpracovani snimku ve FrameProcessor (bez dekodovani vstupu).
+ */
+class AllocationCheck
+{
+    public:
+
+        static int run(const CommandLine& commandLine);
+};
+
+#endif	/* ALLOCATIONCHECK_H */
@@ -0,0 +1,638 @@
+/*
+ * Soubor: Autotuner.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "Autotuner.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "Benchmark.h"
+#include "TaskScheduler.h"
+#include "TiledExecutor.h"
+
+// Pocet typu filtru (Glass je posledni)
+static const int TYPE_COUNT = (int) ImageFilter::Type::Glass + 1;
+
+// Reprezentativni velikosti trid rozliseni (vychozi vstupy autotuningu)
+static const cv::Size CLASS_SIZES[Autotuner::RESOLUTION_CLASSES] = {
+    cv::Size(320, 240), cv::Size(640, 480), cv::Size(1280, 720),
+    cv::Size(1920, 1080), cv::Size(3840, 2160)
+};
+
+// Kandidati vysky pruhu (vychozi -1 je vyska podle velikosti cache)
+static const int STRIP_CANDIDATES[] = {0, 16, 32, 64, 128, 256};
+
+// Kandidat nahradi dosavadni nastaveni, jen pokud je rychlejsi alespon
+// o tolik (jinak by vysledek urcoval sum mereni)
+static const double MIN_GAIN = 0.03;
+
+// Nastaveni filtru v souboru
+struct TuningEntry
+{
+    bool valid;
+    Autotuner::Config config;
+};
+
+/**
+ * Nactena nastaveni. Pro tridy rozliseni bez zaznamu se pouzije zaznam
+ * nejblizsi tridy, aby lookup byl jen indexace tabulky.
+ */
+struct TuningTable
+{
+    TuningEntry entries[TYPE_COUNT][Autotuner::RESOLUTION_CLASSES];
+    const Autotuner::Config* nearest[TYPE_COUNT][Autotuner::RESOLUTION_CLASSES];
+    Autotuner::Config runtime[TYPE_COUNT][Autotuner::RESOLUTION_CLASSES];
+    int count;
+    bool found;
+};
+
+// Pocet aktivnich Scope v aktualnim vlakne. Uvnitr Scope (autotuning,
+// kontrola variant) se nastaveni ze souboru nepouziva.
+static thread_local int tScopes = 0;
+
+/**
+ * Test, zda promenna prostredi neco vynucuje.
+ *
+ * @param name nazev promenne
+ * @return true - promenna je nastavena a neprazdna
+ */
+static bool isForced(const char* name)
+{
+    const char* value = getenv(name);
+    return value != nullptr && *value != '\0';
+}
+
+/**
+ * Prevod nezaporneho cisla ze souboru.
+ *
+ * @param text text pole
+ * @param value vystupni hodnota
+ * @return false - pole neni nezaporne cislo
+ */
+static bool parseCount(const std::string& text, int* value)
+{
+    char* end = nullptr;
+    long parsed = strtol(text.c_str(), &end, 10);
+
+    if (text.empty() || *end != '\0' || parsed < 0 || parsed > 1000000)
+    {
+        return false;
+    }
+
+    *value = (int) parsed;
+    return true;
+}
+
+/**
+ * Nacteni souboru s nastavenim. Radky maji tvar
+ *
+ *     FILTER WxH KERNELS THREADS STRIP_ROWS LAYOUT
+ *
+ * (KERNELS a LAYOUT muze byt default, THREADS all, STRIP_ROWS auto),
+ * '#' uvozuje komentar. Chybne radky se s varovanim preskoci.
+ *
+ * @param path cesta k souboru
+ * @param table vystupni tabulka (zaznamy)
+ */
+static void readTuningFile(const std::string& path, TuningTable& table)
+{
+    table.count = 0;
+    table.found = false;
+
+    for (int t = 0; t < TYPE_COUNT; t++)
+    {
+        for (int c = 0; c < Autotuner::RESOLUTION_CLASSES; c++)
+        {
+            table.entries[t][c].valid = false;
+        }
+    }
+
+    std::ifstream file(path.c_str());
+
+    if (!file)
+    {
+        return;
+    }
+
+    table.found = true;
+
+    std::string line;
+    int lineNumber = 0;
+
+    while (std::getline(file, line))
+    {
+        lineNumber++;
+
+        size_t comment = line.find('#');
+        if (comment != std::string::npos)
+        {
+            line.erase(comment);
+        }
+
+        std::istringstream fields(line);
+        std::string filter, resolution, kernels, threads, stripRows, layout;
+
+        if (!(fields >> filter))
+        {
+            continue;
+        }
+
+        ImageFilter::Type filterType;
+        Autotuner::Config config = {nullptr, 0, -1, -1};
+        int width = 0;
+        int height = 0;
+        bool valid = (bool) (fields >> resolution >> kernels >> threads >> stripRows >> layout)
+                     && ImageFilter::typeFromName(filter, &filterType)
+                     && sscanf(resolution.c_str(), "%dx%d", &width, &height) == 2
+                     && width > 0 && height > 0;
+
+        if (valid && kernels != "default")
+        {
+            config.kernels = KernelDispatch::find(kernels);
+
+            if (config.kernels == nullptr)
+            {
+                std::cerr << path << ":" << lineNumber << ": kernel variant '" << kernels
+                          << "' is not available, using default" << std::endl;
+            }
+        }
+
+        if (valid && threads != "all")
+        {
+            valid = parseCount(threads, &config.threads) && config.threads > 0;
+        }
+
+        if (valid && stripRows != "auto")
+        {
+            valid = parseCount(stripRows, &config.stripRows);
+        }
+
+        if (valid && layout != "default")
+        {
+            valid = layout == "interleaved" || layout == "planar";
+            config.layout = (int) (layout == "planar" ? ImageFilter::Layout::Planar
+                                                      : ImageFilter::Layout::Interleaved);
+        }
+
+        if (!valid)
+        {
+            std::cerr << path << ":" << lineNumber << ": invalid tuning entry, ignored" << std::endl;
+            continue;
+        }
+
+        TuningEntry& entry = table.entries[(int) filterType]
+                                          [Autotuner::resolutionClass(cv::Size(width, height))];
+        table.count += entry.valid ? 0 : 1;
+        entry.valid = true;
+        entry.config = config;
+    }
+}
+
+/**
+ * Priprava tabulky pro lookup: promenne prostredi maji prednost pred
+ * souborem, tridy bez zaznamu prebiraji nejblizsi tridu (pri shode mensi).
+ *
+ * @param table tabulka s nactenymi zaznamy
+ */
+static void prepareLookup(TuningTable& table)
+{
+    bool forcedKernels = isForced("ZPO_KERNELS");
+    bool forcedLayout = isForced("ZPO_LAYOUT");
+
+    for (int t = 0; t < TYPE_COUNT; t++)
+    {
+        for (int c = 0; c < Autotuner::RESOLUTION_CLASSES; c++)
+        {
+            table.nearest[t][c] = nullptr;
+
+            for (int distance = 0; distance < Autotuner::RESOLUTION_CLASSES; distance++)
+            {
+                int k = c - distance >= 0 && table.entries[t][c - distance].valid ? c - distance
+                                                                                  : c + distance;
+
+                if (k < Autotuner::RESOLUTION_CLASSES && table.entries[t][k].valid)
+                {
+                    Autotuner::Config& config = table.runtime[t][c];
+                    config = table.entries[t][k].config;
+                    config.kernels = forcedKernels ? nullptr : config.kernels;
+                    config.layout = forcedLayout ? -1 : config.layout;
+
+                    table.nearest[t][c] = &config;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Nastaveni nactena pri prvnim pouziti.
+ *
+ * @return tabulka nastaveni
+ */
+static const TuningTable& tuningTable()
+{
+    static TuningTable table;
+    static bool loaded = [] {
+        readTuningFile(Autotuner::tuningFile(), table);
+        prepareLookup(table);
+        return true;
+    }();
+    (void) loaded;
+
+    return table;
+}
+
+/**
+ * Ulozeni nastaveni do souboru.
+ *
+ * @param path cesta k souboru
+ * @param table tabulka se zaznamy
+ * @return false - soubor nelze zapsat
+ */
+static bool writeTuningFile(const std::string& path, const TuningTable& table)
+{
+    std::ofstream file(path.c_str());
+
+    file << "# zpo-effect-qt --autotune\n"
+         << "# filter resolution kernels threads strip-rows layout\n";
+
+    for (int t = 0; t < TYPE_COUNT; t++)
+    {
+        for (int c = 0; c < Autotuner::RESOLUTION_CLASSES; c++)
+        {
+            const TuningEntry& entry = table.entries[t][c];
+
+            if (!entry.valid)
+            {
+                continue;
+            }
+
+            const Autotuner::Config& config = entry.config;
+
+            file << ImageFilter::typeName((ImageFilter::Type) t) << " "
+                 << CLASS_SIZES[c].width << "x" << CLASS_SIZES[c].height << " "
+                 << (config.kernels != nullptr ? config.kernels->name : "default") << " ";
+
+            if (config.threads > 0)
+            {
+                file << config.threads << " ";
+            }
+            else
+            {
+                file << "all ";
+            }
+
+            if (config.stripRows >= 0)
+            {
+                file << config.stripRows << " ";
+            }
+            else
+            {
+                file << "auto ";
+            }
+
+            file << (config.layout >= 0 ? ImageFilter::layoutName((ImageFilter::Layout) config.layout)
+                                        : "default")
+                 << "\n";
+        }
+    }
+
+    file.flush();
+
+    return (bool) file;
+}
+
+Autotuner::Scope::Scope(const Config* config)
+    : mActive(config != nullptr)
+    , mKernels(nullptr)
+    , mThreads(0)
+    , mStripRows(-1)
+    , mLayout(-1)
+{
+    if (mActive)
+    {
+        tScopes++;
+        mKernels = KernelDispatch::setLocal(config->kernels);
+        mThreads = TaskScheduler::setLocalConcurrency(config->threads);
+        mStripRows = TiledExecutor::setLocalStripRows(config->stripRows);
+        mLayout = ImageFilter::setLocalLayout(config->layout);
+    }
+}
+
+Autotuner::Scope::~Scope()
+{
+    if (mActive)
+    {
+        KernelDispatch::setLocal(mKernels);
+        TaskScheduler::setLocalConcurrency(mThreads);
+        TiledExecutor::setLocalStripRows(mStripRows);
+        ImageFilter::setLocalLayout(mLayout);
+        tScopes--;
+    }
+}
+
+/**
+ * Spusteni autotuningu. Pro kazdy filtr a rozliseni se nastaveni hleda po
+ * souradnicich: varianta funkci radku, usporadani, vyska pruhu a nakonec
+ * pocet vlaken, vzdy s dosud nejlepsimi hodnotami ostatnich. Vysledky se
+ * slouci s existujicim souborem (ostatni zaznamy zustanou).
+ *
+ * @param commandLine argumenty prikazove radky
+ * @return navratovy kod programu
+ */
+int Autotuner::run(const CommandLine& commandLine)
+{
+    std::vector<cv::Mat> inputs = Benchmark::createInputs(
+        commandLine, std::vector<cv::Size>(CLASS_SIZES, CLASS_SIZES + RESOLUTION_CLASSES));
+
+    if (inputs.empty())
+    {
+        return 1;
+    }
+
+    std::string path = tuningFile();
+    TuningTable table;
+    readTuningFile(path, table);
+
+    std::cout << "threads: " << TaskScheduler::instance().threadCount() << ", kernels:";
+    for (const KernelDispatch::Kernels* kernels : KernelDispatch::available())
+    {
+        std::cout << " " << kernels->name;
+    }
+    std::cout << std::endl;
+
+    for (ImageFilter::Type filterType : commandLine.getFilterTypes())
+    {
+        for (const cv::Mat& src : inputs)
+        {
+            double defaultSeconds = 0.0;
+            double bestSeconds = 0.0;
+            Config best = tune(filterType, src, commandLine.getIterations(),
+                               &defaultSeconds, &bestSeconds);
+
+            TuningEntry& entry = table.entries[(int) filterType][resolutionClass(src.size())];
+            entry.valid = true;
+            entry.config = best;
+
+            char line[256];
+            snprintf(line, sizeof(line), "%-20s %5dx%-5d %-40s %9.2f ms (default %.2f ms)",
+                     ImageFilter::typeName(filterType), src.cols, src.rows, describe(best).c_str(),
+                     bestSeconds * 1000.0, defaultSeconds * 1000.0);
+            std::cout << line << std::endl;
+        }
+    }
+
+    if (!writeTuningFile(path, table))
+    {
+        std::cerr << "Could not write tuning file: " << path << std::endl;
+        return 1;
+    }
+
+    std::cout << "saved: " << path << std::endl;
+
+    return 0;
+}
+
+/**
+ * Nastaveni pro filtr a rozliseni (tabulka se nacte pri prvnim volani).
+ * Uvnitr jineho Scope se nic nevraci, plati nastaveni toho Scope.
+ *
+ * @param filterType typ filtru
+ * @param size velikost vstupniho obrazu
+ * @return nastaveni, nullptr - pro filtr neni nic ulozeno
+ */
+const Autotuner::Config* Autotuner::lookup(ImageFilter::Type filterType, cv::Size size)
+{
+    int type = (int) filterType;
+
+    if (tScopes > 0 || type < 0 || type >= TYPE_COUNT)
+    {
+        return nullptr;
+    }
+
+    return tuningTable().nearest[type][resolutionClass(size)];
+}
+
+/**
+ * Trida rozliseni: nejblizsi reprezentativni velikost podle poctu pixelu
+ * (hranice lezi v geometrickem prumeru sousednich trid).
+ *
+ * @param size velikost obrazu
+ * @return trida rozliseni (0 az RESOLUTION_CLASSES - 1)
+ */
+int Autotuner::resolutionClass(cv::Size size)
+{
+    double area = (double) size.area();
+
+    for (int c = 0; c + 1 < RESOLUTION_CLASSES; c++)
+    {
+        if (area * area <= (double) CLASS_SIZES[c].area() * CLASS_SIZES[c + 1].area())
+        {
+            return c;
+        }
+    }
+
+    return RESOLUTION_CLASSES - 1;
+}
+
+/**
+ * Soubor s nastavenim: ZPO_TUNING_FILE, jinak zpo-tuning.txt v pracovnim
+ * adresari.
+ *
+ * @return cesta k souboru
+ */
+std::string Autotuner::tuningFile()
+{
+    const char* path = getenv("ZPO_TUNING_FILE");
+
+    return path != nullptr && *path != '\0' ? path : "zpo-tuning.txt";
+}
+
+/**
+ * Popis nactenych nastaveni pro vypisy.
+ *
+ * @return soubor a pocet zaznamu
+ */
+std::string Autotuner::status()
+{
+    const TuningTable& table = tuningTable();
+    std::ostringstream text;
+
+    text << tuningFile();
+
+    if (table.found)
+    {
+        text << " (" << table.count << " entries)";
+    }
+    else
+    {
+        text << " (not found, defaults)";
+    }
+
+    return text.str();
+}
+
+/**
+ * Hledani nejrychlejsiho nastaveni filtru pro jeden vstup. Hodnoty
+ * vynucene promennymi prostredi se nezkousi.
+ *
+ * @param filterType typ filtru
+ * @param src vstupni obraz
+ * @param iterations pocet mereni kazdeho kandidata
+ * @param defaultSeconds vystupni cas vychoziho nastaveni
+ * @param bestSeconds vystupni cas nalezeneho nastaveni
+ * @return nejrychlejsi nastaveni
+ */
+Autotuner::Config Autotuner::tune(ImageFilter::Type filterType, const cv::Mat& src, int iterations,
+                                  double* defaultSeconds, double* bestSeconds)
+{
+    int threadCount = TaskScheduler::instance().threadCount();
+
+    Config best = {&KernelDispatch::active(), 0, -1, -1};
+    if (ImageFilter::hasPlanarLayout(filterType))
+    {
+        best.layout = (int) ImageFilter::layout(filterType);
+    }
+
+    *bestSeconds = measure(filterType, src, best, iterations);
+    *defaultSeconds = *bestSeconds;
+
+    std::vector<Config> candidates;
+
+    auto tryCandidates = [&]() {
+        for (const Config& candidate : candidates)
+        {
+            double seconds = measure(filterType, src, candidate, iterations);
+
+            if (seconds < *bestSeconds * (1.0 - MIN_GAIN))
+            {
+                best = candidate;
+                *bestSeconds = seconds;
+            }
+        }
+        candidates.clear();
+    };
+
+    if (!isForced("ZPO_KERNELS"))
+    {
+        const KernelDispatch::Kernels* current = best.kernels;
+
+        for (const KernelDispatch::Kernels* kernels : KernelDispatch::available())
+        {
+            if (kernels != current)
+            {
+                Config candidate = best;
+                candidate.kernels = kernels;
+                candidates.push_back(candidate);
+            }
+        }
+        tryCandidates();
+    }
+
+    if (ImageFilter::hasPlanarLayout(filterType) && !isForced("ZPO_LAYOUT"))
+    {
+        Config candidate = best;
+        candidate.layout = (int) (best.layout == (int) ImageFilter::Layout::Planar
+                                  ? ImageFilter::Layout::Interleaved : ImageFilter::Layout::Planar);
+        candidates.push_back(candidate);
+        tryCandidates();
+    }
+
+    if (ImageFilter::isTiled(filterType) && !isForced("ZPO_TILE_ROWS"))
+    {
+        for (int stripRows : STRIP_CANDIDATES)
+        {
+            Config candidate = best;
+            candidate.stripRows = stripRows;
+            candidates.push_back(candidate);
+        }
+        tryCandidates();
+    }
+
+    // Mocniny dvou rozdeli parallelFor presne (TaskScheduler::parallelFor)
+    for (int threads = 1; threads < threadCount; threads *= 2)
+    {
+        Config candidate = best;
+        candidate.threads = threads;
+        candidates.push_back(candidate);
+    }
+    tryCandidates();
+
+    return best;
+}
+
+/**
+ * Mereni filtru s danym nastavenim: jedno zahrati, pak median z opakovani.
+ *
+ * @param filterType typ filtru
+ * @param src vstupni obraz
+ * @param config nastaveni
+ * @param iterations pocet opakovani
+ * @return cas jednoho volani v sekundach
+ */
+double Autotuner::measure(ImageFilter::Type filterType, const cv::Mat& src,
+                          const Config& config, int iterations)
+{
+    Scope scope(&config);
+    cv::Mat dst;
+    std::vector<double> seconds;
+
+    ImageFilter::filter(src, dst, filterType);
+
+    for (int i = 0; i < iterations; i++)
+    {
+        long long start = cv::getTickCount();
+        ImageFilter::filter(src, dst, filterType);
+        seconds.push_back((cv::getTickCount() - start) / cv::getTickFrequency());
+    }
+
+    std::sort(seconds.begin(), seconds.end());
+
+    return seconds[seconds.size() / 2];
+}
+
+/**
+ * Popis nastaveni pro vypis.
+ *
+ * @param config nastaveni
+ * @return popis
+ */
+std::string Autotuner::describe(const Config& config)
+{
+    std::ostringstream text;
+
+    text << (config.kernels != nullptr ? config.kernels->name : "default") << ", ";
+
+    if (config.threads > 0)
+    {
+        text << config.threads << " threads";
+    }
+    else
+    {
+        text << "all threads";
+    }
+
+    if (config.stripRows >= 0)
+    {
+        text << ", strip " << config.stripRows;
+    }
+
+    if (config.layout >= 0)
+    {
+        text << ", " << ImageFilter::layoutName((ImageFilter::Layout) config.layout);
+    }
+
+    return text.str();
+}
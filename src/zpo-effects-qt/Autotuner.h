@@ -0,0 +1,93 @@
+/*
+ * Soubor: Autotuner.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef AUTOTUNER_H
+#define	AUTOTUNER_H
+
+#include <string>
+
+#include <opencv2/core/core.hpp> // cv::Mat
+
+#include "CommandLine.h"
+#include "ImageFilter.h"
+#include "KernelDispatch.h"
+
+/**
+ * Autotuning: pro kazdy filtr a tridu rozliseni se na danem pocitaci
+ * zmeri varianta funkci radku, usporadani, vyska pruhu a pocet vlaken
+ * a nejrychlejsi nastaveni se ulozi do souboru (ZPO_TUNING_FILE, jinak
+ * zpo-tuning.txt v pracovnim adresari).
+ *
+ * Soubor se nacte pri prvnim volani ImageFilter::filter, ktery pak
+ * nastaveni pro svuj typ a rozliseni najde v tabulce (lookup) a platne
+ * ho nastavi jen pro volajici vlakno (Scope). Promenne prostredi
+ * ZPO_KERNELS, ZPO_LAYOUT a ZPO_TILE_ROWS maji pred souborem prednost,
+ * ZPO_THREADS omezuje pocet vlaken shora.
+ */
+class Autotuner
+{
+    public:
+
+        /**
+         * Nastaveni provadeni filtru.
+         */
+        struct Config
+        {
+            const KernelDispatch::Kernels* kernels; // nullptr - vychozi varianta
+            int threads;                            // nejvyssi pocet vlaken (0 - vsechna)
+            int stripRows;                          // vyska pruhu (-1 - podle velikosti cache)
+            int layout;                             // ImageFilter::Layout (-1 - vychozi)
+        };
+
+        /**
+         * Platnost nastaveni pro aktualni vlakno, na konci bloku se obnovi
+         * predchozi nastaveni. Dokud Scope plati, lookup nic nevraci
+         * (vnorene volani ImageFilter::filter nastaveni nezmeni).
+         */
+        class Scope
+        {
+            private:
+
+                bool mActive;
+                const KernelDispatch::Kernels* mKernels;
+                int mThreads;
+                int mStripRows;
+                int mLayout;
+
+            public:
+
+                explicit Scope(const Config* config);
+                ~Scope();
+
+                Scope(const Scope&) = delete;
+                Scope& operator=(const Scope&) = delete;
+        };
+
+        // Tridy rozliseni (reprezentativni velikosti v CLASS_SIZES)
+        static const int RESOLUTION_CLASSES = 5;
+
+    public:
+
+        static int run(const CommandLine& commandLine);
+
+        static const Config* lookup(ImageFilter::Type filterType, cv::Size size);
+        static int resolutionClass(cv::Size size);
+        static std::string tuningFile();
+        static std::string status();
+
+    private:
+
+        static Config tune(ImageFilter::Type filterType, const cv::Mat& src, int iterations,
+                           double* defaultSeconds, double* bestSeconds);
+        static double measure(ImageFilter::Type filterType, const cv::Mat& src,
+                              const Config& config, int iterations);
+        static std::string describe(const Config& config);
+};
+
+#endif	/* AUTOTUNER_H */
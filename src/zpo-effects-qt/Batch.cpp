@@ -0,0 +1,263 @@
+/*
+ * Soubor: Batch.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "Batch.h"
+
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include <QDir>
+#include <QFileInfo>
+#include <QString>
+
+#include <opencv2/highgui/highgui.hpp> // cv::imread, cv::imwrite
+
+#include "FilterProfiler.h"
+#include "FrameFile.h"
+#include "StreamFilter.h"
+#include "TaskScheduler.h"
+
+/**
+ * Filtrace snimku do kontejneru snimku. Vystupni soubor se vytvori v plne
+ * velikosti a filtr zapisuje primo do jeho mapovanych snimku.
+ *
+ * @param profiler mereni filtru
+ * @param frames vstupni snimky
+ * @param size velikost snimku
+ * @param filterType typ filtru
+ * @param output vystupni soubor
+ * @return false - soubor nelze vytvorit nebo zapsat
+ */
+static bool writeFrameFile(FilterProfiler& profiler, const std::vector<cv::Mat>& frames, cv::Size size,
+                           ImageFilter::Type filterType, const std::string& output)
+{
+    FrameFile file;
+
+    if (!file.create(output, size, ImageFilter::outputType(filterType, CV_8UC3), (int) frames.size()))
+    {
+        return false;
+    }
+
+    for (int i = 0; i < (int) frames.size(); i++)
+    {
+        cv::Mat view = file.frame(i);
+        cv::Mat dst = view;
+
+        profiler.filter(frames[i], dst, filterType);
+
+        // Filtr s vlastnim vystupnim bufferem (jiny typ nebo velikost)
+        if (dst.data != view.data)
+        {
+            dst.copyTo(view);
+        }
+    }
+
+    return file.close();
+}
+
+/**
+ * Filtrace obrazku vsemi zadanymi filtry v jednom pruchodu se sdilenymi
+ * mezivysledky (ImageFilter::filterSet). Vystupy se koduji a zapisuji
+ * soubezne, kazdy vystup jako samostatna uloha planovace.
+ *
+ * @param src vstupni obrazek
+ * @param filterTypes typy filtru
+ * @param outputs vystupni soubory v poradi filterTypes
+ * @return false - nektery vystup nelze zapsat
+ */
+static bool writeAllFilters(const cv::Mat& src, const std::vector<ImageFilter::Type>& filterTypes,
+                            const std::vector<std::string>& outputs)
+{
+    long long start = cv::getTickCount();
+
+    std::vector<cv::Mat> dsts;
+    ImageFilter::filterSet(src, filterTypes, dsts);
+
+    long long filtered = cv::getTickCount();
+
+    std::vector<char> written(outputs.size());
+    TaskGroup group;
+
+    for (size_t i = 0; i < outputs.size(); i++)
+    {
+        group.run([&, i] {
+            written[i] = cv::imwrite(outputs[i], dsts[i]);
+        });
+    }
+
+    group.wait();
+
+    long long end = cv::getTickCount();
+    bool result = true;
+
+    for (size_t i = 0; i < outputs.size(); i++)
+    {
+        if (!written[i])
+        {
+            std::cerr << "Could not write image: " << outputs[i] << std::endl;
+            result = false;
+        }
+    }
+
+    char line[256];
+    snprintf(line, sizeof(line), "%dx%d: %d filters in %.2f ms, encoded in %.2f ms",
+             src.cols, src.rows, (int) filterTypes.size(),
+             (filtered - start) * 1000.0 / cv::getTickFrequency(), (end - filtered) * 1000.0 / cv::getTickFrequency());
+    std::cout << line << std::endl;
+
+    return result;
+}
+
+/**
+ * Filtrace vsech vstupnich obrazku vsemi zadanymi filtry. Vystup se uklada
+ * do vystupniho adresare jako <jmeno>_<filtr>.<pripona>. Kontejner snimku
+ * (.zpof, FrameFile.h) se filtruje snimek po snimku do kontejneru, pri
+ * --zpof se do kontejneru ukladaji i obrazky. Pri --stream se
+ * binarni PGM/PPM filtruji po pruzich (StreamFilter) do <jmeno>_<filtr>.ppm
+ * (.pgm u sedotonoveho vystupu), obrazek nemusi byt v pameti cely. Pri
+ * --all-filters se obrazek filtruje vsemi filtry najednou (writeAllFilters).
+ *
+ * @param commandLine argumenty prikazove radky
+ * @return navratovy kod programu
+ */
+int Batch::run(const CommandLine& commandLine)
+{
+    QDir outputDir(QString::fromStdString(commandLine.getOutputDir()));
+
+    if (!outputDir.exists() && !outputDir.mkpath("."))
+    {
+        std::cerr << "Could not create output directory: " << commandLine.getOutputDir() << std::endl;
+        return 1;
+    }
+
+    FilterProfiler profiler(commandLine.getPerf());
+    int result = 0;
+
+    for (const std::string& input : commandLine.getInputs())
+    {
+        if (commandLine.getStream())
+        {
+            QFileInfo inputInfo(QString::fromStdString(input));
+
+            for (ImageFilter::Type filterType : commandLine.getFilterTypes())
+            {
+                bool gray = CV_MAT_CN(ImageFilter::outputType(filterType, CV_8UC3)) == 1;
+                QString fileName = QString("%1_%2.%3").arg(inputInfo.completeBaseName())
+                                                      .arg(ImageFilter::typeName(filterType))
+                                                      .arg(gray ? "pgm" : "ppm");
+
+                if (!StreamFilter::filter(input, outputDir.filePath(fileName).toStdString(), filterType))
+                {
+                    result = 1;
+                }
+            }
+            continue;
+        }
+
+        // Vstupni snimky (kontejner snimku jako pohledy bez kopie)
+        FrameFile frameFile;
+        std::vector<cv::Mat> frames;
+        bool isFrameFile = FrameFile::isFrameFile(input);
+
+        if (isFrameFile && commandLine.getAllFilters())
+        {
+            std::cerr << "Could not filter frame file by all filters at once: " << input << std::endl;
+            result = 1;
+            continue;
+        }
+
+        if (isFrameFile)
+        {
+            if (!frameFile.open(input) || frameFile.type() != CV_8UC3)
+            {
+                std::cerr << "Could not load frames: " << input << " (BGR frame file expected)" << std::endl;
+                result = 1;
+                continue;
+            }
+
+            for (int i = 0; i < frameFile.frameCount(); i++)
+            {
+                frames.push_back(frameFile.frame(i));
+            }
+        }
+        else
+        {
+            cv::Mat src = cv::imread(input);
+
+            if (src.empty())
+            {
+                std::cerr << "Could not load image: " << input << std::endl;
+                result = 1;
+                continue;
+            }
+
+            frames.push_back(src);
+        }
+
+        QFileInfo inputInfo(QString::fromStdString(input));
+        bool toFrameFile = isFrameFile || commandLine.getFrameFile();
+        cv::Size size = isFrameFile ? frameFile.size() : frames[0].size();
+
+        if (commandLine.getAllFilters())
+        {
+            std::vector<std::string> outputs;
+
+            for (ImageFilter::Type filterType : commandLine.getFilterTypes())
+            {
+                QString fileName = QString("%1_%2.%3").arg(inputInfo.completeBaseName())
+                                                      .arg(ImageFilter::typeName(filterType))
+                                                      .arg(inputInfo.suffix());
+                outputs.push_back(outputDir.filePath(fileName).toStdString());
+            }
+
+            std::cout << input << std::endl;
+
+            if (!writeAllFilters(frames[0], commandLine.getFilterTypes(), outputs))
+            {
+                result = 1;
+            }
+            continue;
+        }
+
+        for (ImageFilter::Type filterType : commandLine.getFilterTypes())
+        {
+            QString fileName = QString("%1_%2.%3").arg(inputInfo.completeBaseName())
+                                                  .arg(ImageFilter::typeName(filterType))
+                                                  .arg(toFrameFile ? QString("zpof") : inputInfo.suffix());
+            std::string output = outputDir.filePath(fileName).toStdString();
+
+            bool written;
+
+            if (toFrameFile)
+            {
+                written = writeFrameFile(profiler, frames, size, filterType, output);
+            }
+            else
+            {
+                cv::Mat dst;
+                profiler.filter(frames[0], dst, filterType);
+                written = cv::imwrite(output, dst);
+            }
+
+            if (!written)
+            {
+                std::cerr << "Could not write image: " << output << std::endl;
+                result = 1;
+            }
+        }
+    }
+
+    if (commandLine.getPerf())
+    {
+        profiler.report(std::cout);
+    }
+
+    return result;
+}
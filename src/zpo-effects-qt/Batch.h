@@ -0,0 +1,25 @@
+/*
+ * Soubor: Batch.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef BATCH_H
+#define	BATCH_H
+
+#include "CommandLine.h"
+
+/**
+ * Davkova filtrace obrazku z prikazove radky (bez GUI).
+ */
+class Batch
+{
+    public:
+
+        static int run(const CommandLine& commandLine);
+};
+
+#endif	/* BATCH_H */
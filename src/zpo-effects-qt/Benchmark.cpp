@@ -0,0 +1,223 @@
+/*
+ * Soubor: Benchmark.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+#include <opencv2/imgproc/imgproc.hpp> // cv::resize
+#include <opencv2/highgui/highgui.hpp> // cv::imread
+
+#include "Autotuner.h"
+#include "FilterProfiler.h"
+#include "KernelDispatch.h"
+
+/**
+ * Prumerna doba filtrace vsech filtru v ms: jednotlive pres filter()
+ * (jako samostatna spusteni) nebo najednou pres filterSet().
+ *
+ * @param src vstupni obrazek
+ * @param filterTypes typy filtru
+ * @param iterations pocet mereni
+ * @param dsts vystupni obrazy v poradi filterTypes
+ * @param shared true - filterSet, false - filter() pro kazdy filtr
+ * @return prumerna doba jednoho mereni v ms
+ */
+static double measureAllFilters(const cv::Mat& src, const std::vector<ImageFilter::Type>& filterTypes,
+                                int iterations, std::vector<cv::Mat>& dsts, bool shared)
+{
+    long long ticks = 0;
+
+    // Prvni pruchod zahreje buffery a cache, nemeri se
+    for (int i = -1; i < iterations; i++)
+    {
+        long long start = cv::getTickCount();
+
+        if (shared)
+        {
+            ImageFilter::filterSet(src, filterTypes, dsts);
+        }
+        else
+        {
+            dsts.resize(filterTypes.size());
+
+            for (size_t k = 0; k < filterTypes.size(); k++)
+            {
+                ImageFilter::filter(src, dsts[k], filterTypes[k]);
+            }
+        }
+
+        if (i >= 0)
+        {
+            ticks += cv::getTickCount() - start;
+        }
+    }
+
+    return ticks * 1000.0 / cv::getTickFrequency() / std::max(iterations, 1);
+}
+
+/**
+ * Porovnani filtrace vsemi filtry najednou se sdilenymi mezivysledky
+ * (ImageFilter::filterSet) s filtraci po jednotlivych filtrech. Vystupy
+ * obou zpusobu musi byt shodne.
+ *
+ * @param commandLine argumenty prikazove radky
+ * @param inputs vstupni obrazky
+ * @return navratovy kod programu
+ */
+static int compareAllFilters(const CommandLine& commandLine, const std::vector<cv::Mat>& inputs)
+{
+    const std::vector<ImageFilter::Type>& filterTypes = commandLine.getFilterTypes();
+    int result = 0;
+
+    std::cout << "kernels: " << KernelDispatch::active().name << std::endl;
+    std::cout << "tuning: " << Autotuner::status() << std::endl;
+
+    for (const cv::Mat& src : inputs)
+    {
+        std::vector<cv::Mat> separate;
+        std::vector<cv::Mat> shared;
+        double separateMs = measureAllFilters(src, filterTypes, commandLine.getIterations(), separate, false);
+        double sharedMs = measureAllFilters(src, filterTypes, commandLine.getIterations(), shared, true);
+
+        char line[256];
+        snprintf(line, sizeof(line), "%dx%d: %d filters separately %.2f ms, in one pass %.2f ms, speedup %.2fx",
+                 src.cols, src.rows, (int) filterTypes.size(), separateMs, sharedMs,
+                 sharedMs > 0 ? separateMs / sharedMs : 0.0);
+        std::cout << line << std::endl;
+
+        for (size_t k = 0; k < filterTypes.size(); k++)
+        {
+            if (separate[k].size() != shared[k].size() || separate[k].type() != shared[k].type()
+                || cv::norm(separate[k], shared[k], cv::NORM_INF) != 0)
+            {
+                std::cerr << "Output of one pass differs: " << ImageFilter::typeName(filterTypes[k]) << std::endl;
+                result = 1;
+            }
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Spusteni benchmarku. Kazdy filtr se pro kazde rozliseni jednou zahreje
+ * a pak se meri zadany pocet opakovani. Pri --all-filters se porovna
+ * filtrace vsemi filtry najednou s filtraci po jednotlivych filtrech.
+ *
+ * @param commandLine argumenty prikazove radky
+ * @return navratovy kod programu
+ */
+int Benchmark::run(const CommandLine& commandLine)
+{
+    std::vector<cv::Mat> inputs = createInputs(
+        commandLine, {cv::Size(320, 240), cv::Size(640, 480), cv::Size(1280, 720)});
+
+    if (inputs.empty())
+    {
+        return 1;
+    }
+
+    if (commandLine.getAllFilters())
+    {
+        return compareAllFilters(commandLine, inputs);
+    }
+
+    FilterProfiler profiler(commandLine.getPerf());
+
+    for (ImageFilter::Type filterType : commandLine.getFilterTypes())
+    {
+        for (const cv::Mat& src : inputs)
+        {
+            cv::Mat dst;
+            ImageFilter::filter(src, dst, filterType);
+
+            for (int i = 0; i < commandLine.getIterations(); i++)
+            {
+                profiler.filter(src, dst, filterType);
+            }
+        }
+    }
+
+    std::cout << "kernels: " << KernelDispatch::active().name << std::endl;
+    std::cout << "tuning: " << Autotuner::status() << std::endl;
+    for (ImageFilter::Type filterType : commandLine.getFilterTypes())
+    {
+        if (ImageFilter::hasPlanarLayout(filterType))
+        {
+            std::cout << "layout: " << ImageFilter::typeName(filterType) << " "
+                      << ImageFilter::layoutName(ImageFilter::layout(filterType)) << std::endl;
+        }
+    }
+    profiler.report(std::cout);
+
+    return 0;
+}
+
+/**
+ * Priprava vstupnich obrazku. Bez zadaneho obrazku se pouzije nahodny sum,
+ * bez zadanych rozliseni vychozi sada (resp. puvodni velikost obrazku).
+ *
+ * @param commandLine argumenty prikazove radky
+ * @param defaultSizes rozliseni, pokud zadna nejsou zadana
+ * @return vstupni obrazky, prazdny seznam pri chybe
+ */
+std::vector<cv::Mat> Benchmark::createInputs(const CommandLine& commandLine,
+                                             const std::vector<cv::Size>& defaultSizes)
+{
+    std::vector<cv::Mat> inputs;
+    std::vector<cv::Size> sizes = commandLine.getSizes();
+    cv::Mat image;
+
+    if (!commandLine.getInputs().empty())
+    {
+        image = cv::imread(commandLine.getInputs().front());
+
+        if (image.empty())
+        {
+            std::cerr << "Could not load image: " << commandLine.getInputs().front() << std::endl;
+            return inputs;
+        }
+
+        if (sizes.empty())
+        {
+            sizes.push_back(image.size());
+        }
+    }
+
+    if (sizes.empty())
+    {
+        sizes = defaultSizes;
+    }
+
+    for (const cv::Size& size : sizes)
+    {
+        cv::Mat input;
+
+        if (image.empty())
+        {
+            input.create(size, CV_8UC3);
+            cv::randu(input, cv::Scalar::all(0), cv::Scalar::all(256));
+        }
+        else if (image.size() == size)
+        {
+            input = image;
+        }
+        else
+        {
+            cv::resize(image, input, size, 0, 0, cv::INTER_AREA);
+        }
+
+        inputs.push_back(input);
+    }
+
+    return inputs;
+}
@@ -0,0 +1,32 @@
+/*
+ * Soubor: Benchmark.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef BENCHMARK_H
+#define	BENCHMARK_H
+
+#include <vector>
+
+#include <opencv2/core/core.hpp> // cv::Mat
+
+#include "CommandLine.h"
+
+/**
+ * Mereni rychlosti filtru pro ruzna rozliseni vstupu.
+ */
+class Benchmark
+{
+    public:
+
+        static int run(const CommandLine& commandLine);
+
+        static std::vector<cv::Mat> createInputs(const CommandLine& commandLine,
+                                                 const std::vector<cv::Size>& defaultSizes);
+};
+
+#endif	/* BENCHMARK_H */
@@ -0,0 +1,138 @@
+/*
+ * Soubor: BufferPool.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "BufferPool.h"
+
+#include <cstdint>
+
+/**
+ * Konstruktor.
+ *
+ * @param capacity maximalni pocet drzenych bufferu
+ */
+BufferPool::BufferPool(size_t capacity)
+    : mCapacity(capacity)
+{
+}
+
+/**
+ * Ziskani volneho bufferu dane velikosti a typu. Nova alokace nastane jen
+ * pri zmene velikosti/typu nebo pokud jsou vsechny buffery pouzivany.
+ *
+ * @param size velikost snimku
+ * @param type typ snimku (CV_8UC3, ...)
+ * @return buffer (obsah neni definovan)
+ */
+cv::Mat BufferPool::acquire(cv::Size size, int type)
+{
+    for (const cv::Mat& buffer : mBuffers)
+    {
+        if (isExclusive(buffer) && buffer.size() == size && buffer.type() == type)
+        {
+            return buffer;
+        }
+    }
+
+    // Volny buffer jineho rozmeru nahradime
+    for (cv::Mat& buffer : mBuffers)
+    {
+        if (isExclusive(buffer))
+        {
+            buffer = createAligned(size, type);
+            return buffer;
+        }
+    }
+
+    if (mBuffers.size() < mCapacity)
+    {
+        mBuffers.push_back(createAligned(size, type));
+        return mBuffers.back();
+    }
+
+    // Zasobnik je vycerpan, docasny buffer mimo zasobnik
+    return createAligned(size, type);
+}
+
+/**
+ * Uvolneni vsech bufferu zasobniku.
+ */
+void BufferPool::clear()
+{
+    mBuffers.clear();
+}
+
+/**
+ * Vytvoreni snimku se zarovnanymi radky. Alokuje se sirsi snimek, jehoz
+ * krok je nasobkem ALIGNMENT, a vrati se jeho vyrez posunuty tak, aby
+ * prvni pixel lezel na zarovnane adrese. Vyrez drzi odkaz na celou alokaci.
+ *
+ * @param size velikost snimku
+ * @param type typ snimku
+ * @return zarovnany snimek
+ */
+cv::Mat BufferPool::createAligned(cv::Size size, int type)
+{
+    if (size.width <= 0 || size.height <= 0)
+    {
+        return cv::Mat(size, type);
+    }
+
+    size_t elemSize = CV_ELEM_SIZE(type);
+
+    // Nejmensi pocet pixelu, jejichz velikost je nasobkem ALIGNMENT
+    size_t colsPerLine = ALIGNMENT;
+    while (colsPerLine % 2 == 0 && (colsPerLine / 2 * elemSize) % ALIGNMENT == 0)
+    {
+        colsPerLine /= 2;
+    }
+
+    // Rezerva ALIGNMENT pixelu staci na posunuti zacatku na zarovnanou adresu
+    size_t paddedCols = size.width + ALIGNMENT;
+    paddedCols = (paddedCols + colsPerLine - 1) / colsPerLine * colsPerLine;
+
+    cv::Mat storage(size.height, (int) paddedCols, type);
+
+    size_t misalignment = (uintptr_t) storage.data % ALIGNMENT;
+    int offset = 0;
+
+    while ((misalignment + offset * elemSize) % ALIGNMENT != 0 && offset < (int) ALIGNMENT)
+    {
+        offset++;
+    }
+
+    return storage.colRange(offset, offset + size.width);
+}
+
+/**
+ * Test na zarovnani zacatku vsech radku snimku.
+ *
+ * @param mat snimek
+ * @return true - vsechny radky zacinaji na zarovnane adrese
+ */
+bool BufferPool::isAligned(const cv::Mat& mat)
+{
+    return mat.data != nullptr
+           && (uintptr_t) mat.data % ALIGNMENT == 0
+           && (mat.rows == 1 || mat.step[0] % ALIGNMENT == 0);
+}
+
+/**
+ * Test, zda na data snimku neexistuje jiny odkaz nez tento.
+ *
+ * @param mat snimek
+ * @return true - snimek neni sdilen
+ */
+bool BufferPool::isExclusive(const cv::Mat& mat)
+{
+#if CV_MAJOR_VERSION < 3
+    return mat.refcount != nullptr && *mat.refcount == 1;
+#else
+    return mat.u != nullptr && mat.u->refcount == 1;
+#endif
+}
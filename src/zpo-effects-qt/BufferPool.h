@@ -0,0 +1,47 @@
+/*
+ * Soubor: BufferPool.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef BUFFERPOOL_H
+#define	BUFFERPOOL_H
+
+#include <vector>
+
+#include <opencv2/core/core.hpp> // cv::Mat
+
+/**
+ * Zasobnik opakovane pouzivanych snimku. Buffer je volny, pokud na nej
+ * mimo zasobnik neexistuje zadny odkaz (reference counting cv::Mat), takze
+ * snimek predany do GUI se vrati do zasobniku sam, jakmile ho GUI uvolni.
+ *
+ * Vsechny buffery maji zacatek kazdeho radku zarovnany na ALIGNMENT bajtu.
+ */
+class BufferPool
+{
+    public:
+
+        static constexpr size_t ALIGNMENT = 64;
+
+    private:
+
+        std::vector<cv::Mat> mBuffers;
+        size_t mCapacity;
+
+    public:
+
+        explicit BufferPool(size_t capacity = 4);
+
+        cv::Mat acquire(cv::Size size, int type);
+        void clear();
+
+        static cv::Mat createAligned(cv::Size size, int type);
+        static bool isAligned(const cv::Mat& mat);
+        static bool isExclusive(const cv::Mat& mat);
+};
+
+#endif	/* BUFFERPOOL_H */
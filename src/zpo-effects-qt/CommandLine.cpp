@@ -0,0 +1,503 @@
+/*
+ * Soubor: CommandLine.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "CommandLine.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+CommandLine::CommandLine()
+    : mMode(Mode::GUI)
+    , mIterations(5)
+    , mWarmup(3)
+    , mWorkers(1)
+    , mFps(60)
+    , mInputType(CV_8UC3)
+    , mPerf(false)
+    , mStream(false)
+    , mFrameFile(false)
+    , mAllFilters(false)
+{
+}
+
+/**
+ * Zpracovani argumentu.
+ *
+ * @param argc pocet argumentu
+ * @param argv argumenty
+ * @return false - chybne argumenty, popis chyby vraci getError()
+ */
+bool CommandLine::parse(int argc, char* argv[])
+{
+    std::string unknownOption;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--batch")
+        {
+            mMode = Mode::BATCH;
+        }
+        else if (arg == "--benchmark")
+        {
+            mMode = Mode::BENCHMARK;
+        }
+        else if (arg == "--alloc-check")
+        {
+            mMode = Mode::ALLOC_CHECK;
+        }
+        else if (arg == "--kernel-check")
+        {
+            mMode = Mode::KERNEL_CHECK;
+        }
+        else if (arg == "--autotune")
+        {
+            mMode = Mode::AUTOTUNE;
+        }
+        else if (arg == "--verify")
+        {
+            mMode = Mode::VERIFY;
+        }
+        else if (arg == "--temporal")
+        {
+            mMode = Mode::TEMPORAL;
+        }
+        else if (arg == "--render")
+        {
+            mMode = Mode::RENDER;
+        }
+        else if (arg == "--serve")
+        {
+            mMode = Mode::SERVE;
+        }
+        else if (arg == "--loadgen")
+        {
+            mMode = Mode::LOADGEN;
+        }
+        else if (arg == "--shm-produce")
+        {
+            mMode = Mode::SHM_PRODUCE;
+        }
+        else if (arg == "--shm-consume")
+        {
+            mMode = Mode::SHM_CONSUME;
+        }
+        else if (arg == "--shm-filter")
+        {
+            mMode = Mode::SHM_FILTER;
+        }
+        else if (arg == "--pipe")
+        {
+            mMode = Mode::PIPE;
+        }
+        else if (arg == "--help" || arg == "-h")
+        {
+            mMode = Mode::HELP;
+        }
+        else if (arg == "--perf")
+        {
+            mPerf = true;
+        }
+        else if (arg == "--stream")
+        {
+            mStream = true;
+        }
+        else if (arg == "--zpof")
+        {
+            mFrameFile = true;
+        }
+        else if (arg == "--all-filters")
+        {
+            mAllFilters = true;
+        }
+        else if (arg == "--filter" || arg == "-f")
+        {
+            if (!hasValue)
+            {
+                return fail("missing value for " + arg);
+            }
+
+            ImageFilter::Type filterType;
+            if (!ImageFilter::typeFromName(argv[++i], &filterType))
+            {
+                return fail(std::string("unknown filter: ") + argv[i]);
+            }
+
+            mFilterTypes.push_back(filterType);
+        }
+        else if (arg == "--output" || arg == "-o")
+        {
+            if (!hasValue)
+            {
+                return fail("missing value for " + arg);
+            }
+
+            mOutputDir = argv[++i];
+        }
+        else if (arg == "--shm-input" || arg == "--shm-output")
+        {
+            if (!hasValue)
+            {
+                return fail("missing value for " + arg);
+            }
+
+            (arg == "--shm-input" ? mShmInput : mShmOutput) = argv[++i];
+        }
+        else if (arg == "--iterations" || arg == "-n")
+        {
+            if (!hasValue || (mIterations = atoi(argv[++i])) <= 0)
+            {
+                return fail("invalid value for " + arg);
+            }
+        }
+        else if (arg == "--warmup")
+        {
+            if (!hasValue || (mWarmup = atoi(argv[++i])) < 0)
+            {
+                return fail("invalid value for " + arg);
+            }
+        }
+        else if (arg == "--workers")
+        {
+            if (!hasValue || (mWorkers = atoi(argv[++i])) <= 0)
+            {
+                return fail("invalid value for " + arg);
+            }
+
+            mWorkerCounts.push_back(mWorkers);
+        }
+        else if (arg == "--fps")
+        {
+            if (!hasValue || (mFps = atof(argv[++i])) < 0)
+            {
+                return fail("invalid value for " + arg);
+            }
+        }
+        else if (arg == "--pix-fmt")
+        {
+            std::string format = hasValue ? argv[++i] : "";
+
+            if (format == "bgr24")
+            {
+                mInputType = CV_8UC3;
+            }
+            else if (format == "gray")
+            {
+                mInputType = CV_8UC1;
+            }
+            else
+            {
+                return fail("invalid value for " + arg + " (expected bgr24 or gray)");
+            }
+        }
+        else if (arg == "--size")
+        {
+            int width = 0;
+            int height = 0;
+
+            if (!hasValue || sscanf(argv[++i], "%dx%d", &width, &height) != 2
+                || width <= 0 || height <= 0)
+            {
+                return fail("invalid value for " + arg + " (expected WxH)");
+            }
+
+            mSizes.push_back(cv::Size(width, height));
+        }
+        else if (arg.size() > 1 && arg[0] == '-')
+        {
+            unknownOption = arg;
+        }
+        else
+        {
+            mInputs.push_back(arg);
+        }
+    }
+
+    // V rezimu GUI se neznama nastaveni predavaji Qt (napr. -style)
+    if (mMode != Mode::GUI && !unknownOption.empty())
+    {
+        return fail("unknown option: " + unknownOption);
+    }
+
+    if (mAllFilters && (mMode != Mode::BATCH && mMode != Mode::BENCHMARK))
+    {
+        return fail("--all-filters requires --batch or --benchmark");
+    }
+
+    if (mAllFilters && (mStream || mFrameFile || mPerf))
+    {
+        return fail("--all-filters cannot be combined with --stream, --zpof or --perf");
+    }
+
+    if (mMode == Mode::BATCH && mAllFilters && mFilterTypes.empty())
+    {
+        mFilterTypes = ImageFilter::allTypes();
+    }
+
+    if (mMode == Mode::BATCH)
+    {
+        if (mFilterTypes.empty())
+        {
+            return fail("--batch requires at least one --filter");
+        }
+        if (mInputs.empty())
+        {
+            return fail("--batch requires input images");
+        }
+        if (mOutputDir.empty())
+        {
+            return fail("--batch requires --output");
+        }
+    }
+
+    if (mMode == Mode::RENDER)
+    {
+        if (mFilterTypes.size() != 1)
+        {
+            return fail("--render requires exactly one --filter");
+        }
+        if (mInputs.size() != 1)
+        {
+            return fail("--render requires one input video");
+        }
+        if (mOutputDir.empty())
+        {
+            return fail("--render requires --output");
+        }
+    }
+
+    if ((mMode == Mode::SERVE || mMode == Mode::LOADGEN) && mInputs.size() != 1)
+    {
+        return fail("--serve and --loadgen require one socket path");
+    }
+
+    if (mMode == Mode::LOADGEN && mFilterTypes.size() != 1)
+    {
+        return fail("--loadgen requires exactly one --filter");
+    }
+
+    if ((mMode == Mode::SHM_CONSUME || mMode == Mode::SHM_FILTER) && mShmInput.empty())
+    {
+        return fail("--shm-consume and --shm-filter require --shm-input");
+    }
+
+    if ((mMode == Mode::SHM_PRODUCE || mMode == Mode::SHM_FILTER) && mShmOutput.empty())
+    {
+        return fail("--shm-produce and --shm-filter require --shm-output");
+    }
+
+    if (mMode == Mode::SHM_FILTER && mFilterTypes.size() != 1)
+    {
+        return fail("--shm-filter requires exactly one --filter");
+    }
+
+    if (mMode == Mode::GUI && !mShmOutput.empty() && mShmInput.empty())
+    {
+        return fail("--shm-output requires --shm-input");
+    }
+
+    if (mMode == Mode::PIPE && (mFilterTypes.size() != 1 || mSizes.size() != 1))
+    {
+        return fail("--pipe requires exactly one --filter and one --size");
+    }
+
+    if (mStream && mMode != Mode::BATCH)
+    {
+        return fail("--stream requires --batch");
+    }
+
+    if (mFrameFile && (mMode != Mode::BATCH || mStream))
+    {
+        return fail("--zpof requires --batch without --stream");
+    }
+
+    if ((mMode == Mode::BENCHMARK || mMode == Mode::ALLOC_CHECK || mMode == Mode::AUTOTUNE
+         || mMode == Mode::VERIFY || mMode == Mode::TEMPORAL) && mFilterTypes.empty())
+    {
+        mFilterTypes = ImageFilter::allTypes();
+    }
+
+    return true;
+}
+
+/**
+ * Nastaveni chyby.
+ *
+ * @param error popis chyby
+ * @return vzdy false
+ */
+bool CommandLine::fail(const std::string& error)
+{
+    mError = error;
+    return false;
+}
+
+/**
+ * Napoveda k pouziti programu.
+ *
+ * @param program nazev programu (argv[0])
+ * @return text napovedy
+ */
+std::string CommandLine::usage(const char* program)
+{
+    std::string name = program;
+    std::string indent(name.size(), ' ');
+
+    return "Usage:\n"
+           "  " + name + "                                    start GUI\n"
+           "  " + name + " --batch -f FILTER -o DIR IMAGE...  filter images into DIR\n"
+           "  " + name + " --benchmark [IMAGE]                benchmark filters\n"
+           "  " + name + " --alloc-check [VIDEO]              check allocations per frame\n"
+           "  " + name + " --kernel-check                     compare SIMD kernels with scalar\n"
+           "  " + name + " --autotune [IMAGE]                 tune filters for this machine\n"
+           "  " + name + " --verify [IMAGE...]                compare filter variants with reference\n"
+           "  " + name + " --temporal [VIDEO]                 measure dirty-tile filtering of frames\n"
+           "  " + name + " --render -f FILTER -o FILE VIDEO   filter video into FILE offline\n"
+           "  " + name + " --serve SOCKET                     filter images for clients of a Unix socket\n"
+           "  " + name + " --loadgen -f FILTER SOCKET         measure service throughput and latency\n"
+           "  " + name + " --shm-input RING [--shm-output RING]\n"
+           "  " + indent + "                                    start GUI on shared-memory frames\n"
+           "  " + name + " --shm-produce --shm-output RING    send synthetic frames to shared memory\n"
+           "  " + name + " --shm-consume --shm-input RING     receive frames, measure latency\n"
+           "  " + name + " --shm-filter -f FILTER --shm-input RING --shm-output RING\n"
+           "  " + indent + "                                    filter shared-memory frames\n"
+           "  " + name + " --pipe -f FILTER --size WxH        filter raw frames from stdin to stdout\n"
+           "\n"
+           "Options:\n"
+           "  -f, --filter NAME     filter to use (repeatable; benchmark: all by default)\n"
+           "  -o, --output DIR      output directory (batch), output video (render)\n"
+           "  -n, --iterations N    repetitions per filter and resolution (benchmark),\n"
+           "                        measurements per candidate (autotune),\n"
+           "                        random images per size (verify),\n"
+           "                        frames after warm-up (alloc-check, temporal),\n"
+           "                        requests per client (loadgen),\n"
+           "                        frames sent (shm-produce),\n"
+           "                        random rows per length (kernel-check)\n"
+           "      --warmup N        warm-up frames not checked (alloc-check, temporal)\n"
+           "      --workers N       threads filtering whole frames concurrently (render,\n"
+           "                        repeatable: one pass per count),\n"
+           "                        concurrent clients (loadgen)\n"
+           "      --size WxH        synthetic input resolution (repeatable)\n"
+           "      --pix-fmt NAME    raw frame format of pipe input (bgr24, gray; default bgr24)\n"
+           "      --fps N           frame rate of shm-produce (0 = unthrottled, default 60)\n"
+           "      --shm-input RING  shared-memory ring to read frames from\n"
+           "      --shm-output RING shared-memory ring to write frames to\n"
+           "      --perf            read hardware performance counters per filter call\n"
+           "      --stream          filter binary PGM/PPM in row strips, bounded memory (batch)\n"
+           "      --zpof            write memory-mapped .zpof frame files (batch)\n"
+           "      --all-filters     filter each image by all filters in one pass sharing\n"
+           "                        intermediates (batch: all by default; benchmark: compare)\n"
+           "  -h, --help            show this help\n"
+           "\n"
+           "Environment:\n"
+           "  ZPO_KERNELS=NAME      force kernel variant (scalar, sse4, avx2, avx512)\n"
+           "  ZPO_TILE_ROWS=N       strip height of tiled filter chains (0 = whole image)\n"
+           "  ZPO_THREADS=N         worker threads of filters (1 = serial)\n"
+           "  ZPO_LAYOUT=NAME       colour layout of colour filters (interleaved, planar)\n"
+           "  ZPO_ARITHMETIC=NAME   gradient magnitude arithmetic (float, fixed)\n"
+           "  ZPO_TUNING_FILE=PATH  autotuning results (default zpo-tuning.txt)\n"
+           "  ZPO_DIRTY_TILES=0     refilter whole camera frames instead of changed tiles\n"
+           "  ZPO_DIRTY_THRESHOLD=X mean difference of a changed tile (default 0 = any)\n"
+           "  ZPO_REFRESH_INTERVAL=N refilter whole frame every N frames (default 30)\n"
+           "  ZPO_ADAPTIVE_SCALE=0  always filter video and camera at full resolution\n"
+           "  ZPO_STREAM_ROWS=N     strip height of --stream (default 512)\n"
+           "  ZPO_RENDER_CODEC=CODE FOURCC of --render output (default MJPG)\n";
+}
+
+CommandLine::Mode CommandLine::getMode() const
+{
+    return mMode;
+}
+
+const std::vector<ImageFilter::Type>& CommandLine::getFilterTypes() const
+{
+    return mFilterTypes;
+}
+
+const std::vector<std::string>& CommandLine::getInputs() const
+{
+    return mInputs;
+}
+
+const std::vector<cv::Size>& CommandLine::getSizes() const
+{
+    return mSizes;
+}
+
+const std::string& CommandLine::getOutputDir() const
+{
+    return mOutputDir;
+}
+
+const std::string& CommandLine::getShmInput() const
+{
+    return mShmInput;
+}
+
+const std::string& CommandLine::getShmOutput() const
+{
+    return mShmOutput;
+}
+
+const std::string& CommandLine::getError() const
+{
+    return mError;
+}
+
+int CommandLine::getIterations() const
+{
+    return mIterations;
+}
+
+int CommandLine::getWarmup() const
+{
+    return mWarmup;
+}
+
+int CommandLine::getWorkers() const
+{
+    return mWorkers;
+}
+
+std::vector<int> CommandLine::getWorkerCounts() const
+{
+    return mWorkerCounts.empty() ? std::vector<int>(1, mWorkers) : mWorkerCounts;
+}
+
+double CommandLine::getFps() const
+{
+    return mFps;
+}
+
+int CommandLine::getInputType() const
+{
+    return mInputType;
+}
+
+bool CommandLine::getPerf() const
+{
+    return mPerf;
+}
+
+bool CommandLine::getStream() const
+{
+    return mStream;
+}
+
+bool CommandLine::getFrameFile() const
+{
+    return mFrameFile;
+}
+
+bool CommandLine::getAllFilters() const
+{
+    return mAllFilters;
+}
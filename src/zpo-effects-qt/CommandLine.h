@@ -0,0 +1,101 @@
+/*
+ * Soubor: CommandLine.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef COMMANDLINE_H
+#define	COMMANDLINE_H
+
+#include <string>
+#include <vector>
+
+#include <opencv2/core/core.hpp> // cv::Size
+
+#include "ImageFilter.h"
+
+/**
+ * Zpracovani argumentu prikazove radky. Bez argumentu se spousti GUI,
+ * ostatni rezimy bezi bez okna.
+ */
+class CommandLine
+{
+    public:
+
+        enum class Mode
+        {
+            GUI,
+            BATCH,
+            BENCHMARK,
+            ALLOC_CHECK,
+            KERNEL_CHECK,
+            AUTOTUNE,
+            VERIFY,
+            TEMPORAL,
+            RENDER,
+            SERVE,
+            LOADGEN,
+            SHM_PRODUCE,
+            SHM_CONSUME,
+            SHM_FILTER,
+            PIPE,
+            HELP
+        };
+
+    private:
+
+        Mode mMode;
+        std::vector<ImageFilter::Type> mFilterTypes;
+        std::vector<std::string> mInputs;
+        std::vector<cv::Size> mSizes;
+        std::string mOutputDir;
+        std::string mShmInput;
+        std::string mShmOutput;
+        std::string mError;
+        int mIterations;
+        int mWarmup;
+        int mWorkers;
+        std::vector<int> mWorkerCounts;
+        double mFps;
+        int mInputType;
+        bool mPerf;
+        bool mStream;
+        bool mFrameFile;
+        bool mAllFilters;
+
+    public:
+
+        CommandLine();
+
+        bool parse(int argc, char* argv[]);
+
+        Mode getMode() const;
+        const std::vector<ImageFilter::Type>& getFilterTypes() const;
+        const std::vector<std::string>& getInputs() const;
+        const std::vector<cv::Size>& getSizes() const;
+        const std::string& getOutputDir() const;
+        const std::string& getShmInput() const;
+        const std::string& getShmOutput() const;
+        const std::string& getError() const;
+        int getIterations() const;
+        int getWarmup() const;
+        int getWorkers() const;
+        std::vector<int> getWorkerCounts() const;
+        double getFps() const;
+        int getInputType() const;
+        bool getPerf() const;
+        bool getStream() const;
+        bool getFrameFile() const;
+        bool getAllFilters() const;
+
+        static std::string usage(const char* program);
+
+    private:
+
+        bool fail(const std::string& error);
+};
+
+#endif	/* COMMANDLINE_H */
@@ -0,0 +1,526 @@
+/*
+ * Soubor: FilterCheck.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "FilterCheck.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <opencv2/imgproc/imgproc.hpp> // cv::cvtColor
+#include <opencv2/highgui/highgui.hpp> // cv::imread
+
+#include "Autotuner.h"
+#include "ImageFilter.h"
+#include "KernelDispatch.h"
+#include "PnmStream.h"
+#include "ReferenceFilter.h"
+#include "StreamFilter.h"
+
+// Nejvyssi pocet vypsanych neshod jednoho filtru
+static const int MAX_REPORTED = 10;
+
+// Hodnota, kterou se pred filtraci prepise vystup (odhali nezapsane pixely)
+static const int STALE_VALUE = 77;
+
+// Soubezne filtrujici vlakna a opakovani ve variante "workers"
+static const int WORKER_THREADS = 4;
+static const int WORKER_ROUNDS = 3;
+
+/**
+ * Varianta provadeni filtru.
+ */
+struct Variant
+{
+    std::string name;
+    Autotuner::Config config;
+    int fixedPoint;  // ImageFilter::setLocalFixedPoint
+    bool defaults;   // bez Scope: vychozi nastaveni vcetne souboru autotuningu
+    int streamRows;  // StreamFilter po pruzich teto vysky (0 - vychozi), -1 - cely obraz
+    bool workers;    // soubezna filtrace ve vice vlaknech jako VideoRender --workers
+};
+
+/**
+ * Filtry s celociselnym vypoctem velikosti gradientu.
+ *
+ * @param filterType typ filtru
+ * @return true - filtr ma float i celociselnou variantu
+ */
+static bool hasFixedPoint(ImageFilter::Type filterType)
+{
+    return filterType == ImageFilter::Type::SobelGray || filterType == ImageFilter::Type::SobelGray2;
+}
+
+/**
+ * Vsechny varianty provadeni filtru: funkce radku x 1 / vsechna vlakna
+ * x vyska pruhu x usporadani x aritmetika (jen rozmery, ktere filtr ma),
+ * u filtru, ktere lze filtrovat po pruzich souboru (StreamFilter), i pruhy
+ * ruznych vysek vcetne jednoho radku a nakonec soubezna filtrace ve vice
+ * vlaknech (--workers).
+ *
+ * @param filterType typ filtru
+ * @return varianty
+ */
+static std::vector<Variant> variants(ImageFilter::Type filterType)
+{
+    std::vector<Variant> result;
+    result.push_back({"default", {nullptr, 0, -1, -1}, -1, true, -1, false});
+
+    std::vector<int> strips = {-1};
+    if (ImageFilter::isTiled(filterType))
+    {
+        // Pruh jednoho radku ma vetsi prekryv nez vysku
+        strips = {-1, 0, 1, 16};
+    }
+
+    std::vector<int> layouts = {-1};
+    if (ImageFilter::hasPlanarLayout(filterType))
+    {
+        layouts = {(int) ImageFilter::Layout::Interleaved, (int) ImageFilter::Layout::Planar};
+    }
+
+    std::vector<int> arithmetics = {-1};
+    if (hasFixedPoint(filterType))
+    {
+        arithmetics = {0, 1};
+    }
+
+    for (const KernelDispatch::Kernels* kernels : KernelDispatch::available())
+    {
+        for (int threads : {1, 0})
+        {
+            for (int stripRows : strips)
+            {
+                for (int layout : layouts)
+                {
+                    for (int fixedPoint : arithmetics)
+                    {
+                        std::string name = kernels->name;
+                        name += threads == 1 ? ", 1 thread" : ", all threads";
+
+                        if (stripRows >= 0)
+                        {
+                            name += ", strip " + std::to_string(stripRows);
+                        }
+                        if (layout >= 0)
+                        {
+                            name += std::string(", ") + ImageFilter::layoutName((ImageFilter::Layout) layout);
+                        }
+                        if (fixedPoint >= 0)
+                        {
+                            name += fixedPoint == 1 ? ", fixed" : ", float";
+                        }
+
+                        result.push_back({name, {kernels, threads, stripRows, layout}, fixedPoint, false, -1, false});
+                    }
+                }
+            }
+        }
+    }
+
+    if (StreamFilter::isSupported(filterType))
+    {
+        // Pruhy mensi nez bunka Glass, kolem prekryvu masek i vychozi
+        for (int streamRows : {1, 2, 5, 16, 64, 0})
+        {
+            std::string name = streamRows > 0 ? "stream, strip " + std::to_string(streamRows)
+                                              : std::string("stream, default strip");
+            result.push_back({name, {nullptr, 0, -1, -1}, -1, true, streamRows, false});
+        }
+    }
+
+    result.push_back({"workers " + std::to_string(WORKER_THREADS), {nullptr, 0, -1, -1}, -1, true, -1, true});
+
+    return result;
+}
+
+/**
+ * Filtrace po pruzich pres docasne soubory PNM (StreamFilter), stejne jako
+ * --batch --stream.
+ *
+ * @param streamRows vyska pruhu (0 - vychozi)
+ * @param src vstupni obraz
+ * @param dst vystupni obraz
+ * @param filterType typ filtru
+ * @return popis chyby, prazdny retezec bez chyby
+ */
+static std::string streamVariant(int streamRows, const cv::Mat& src, cv::Mat& dst,
+                                 ImageFilter::Type filterType)
+{
+    bool gray = CV_MAT_CN(ImageFilter::outputType(filterType, CV_8UC3)) == 1;
+    std::string input = cv::tempfile(".ppm");
+    std::string output = cv::tempfile(gray ? ".pgm" : ".ppm");
+
+    PnmWriter writer;
+    bool ok = writer.open(input, src.size(), 3) && writer.write(src) && writer.close();
+
+    int previous = StreamFilter::setLocalStripRows(streamRows);
+    ok = ok && StreamFilter::filter(input, output, filterType);
+    StreamFilter::setLocalStripRows(previous);
+
+    if (ok)
+    {
+        dst = cv::imread(output, -1); // CV_LOAD_IMAGE_UNCHANGED, sede zustane sede
+    }
+
+    std::remove(input.c_str());
+    std::remove(output.c_str());
+
+    return ok && !dst.empty() ? std::string() : std::string("streaming failed");
+}
+
+/**
+ * Soubezna filtrace stejneho obrazu ve vice vlaknech, kazde vlakno bez
+ * deleni mezi vlakna planovace, stejne jako VideoRender --workers N.
+ * Vysledky vsech vlaken a opakovani musi byt shodne (odhali sdileny stav
+ * filtru), prvni z nich se pak porovna s referenci.
+ *
+ * @param src vstupni obraz
+ * @param dst vystupni obraz
+ * @param filterType typ filtru
+ * @return popis chyby, prazdny retezec bez chyby
+ */
+static std::string workersVariant(const cv::Mat& src, cv::Mat& dst, ImageFilter::Type filterType)
+{
+    std::vector<cv::Mat> outputs(WORKER_THREADS * WORKER_ROUNDS);
+    std::vector<std::string> errors(WORKER_THREADS);
+    std::vector<std::thread> threads;
+
+    for (int w = 0; w < WORKER_THREADS; w++)
+    {
+        threads.emplace_back([&, w] {
+            const Autotuner::Config* tuned = Autotuner::lookup(filterType, src.size());
+            Autotuner::Config config = tuned != nullptr ? *tuned : Autotuner::Config { nullptr, 0, -1, -1 };
+            config.threads = 1;
+            Autotuner::Scope scope(&config);
+
+            try
+            {
+                for (int round = 0; round < WORKER_ROUNDS; round++)
+                {
+                    ImageFilter::filter(src, outputs[round * WORKER_THREADS + w], filterType);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                errors[w] = e.what();
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (const std::string& error : errors)
+    {
+        if (!error.empty())
+        {
+            return error;
+        }
+    }
+
+    for (const cv::Mat& output : outputs)
+    {
+        if (output.size() != outputs[0].size() || output.type() != outputs[0].type()
+            || cv::norm(output, outputs[0], cv::NORM_INF) != 0)
+        {
+            return "outputs of concurrent workers differ";
+        }
+    }
+
+    outputs[0].copyTo(dst);
+
+    return std::string();
+}
+
+/**
+ * Filtrace s danou variantou provadeni.
+ *
+ * @param variant varianta
+ * @param src vstupni obraz
+ * @param dst vystupni obraz
+ * @param filterType typ filtru
+ * @return popis vyjimky filtru, prazdny retezec bez chyby
+ */
+static std::string filterVariant(const Variant& variant, const cv::Mat& src, cv::Mat& dst,
+                                 ImageFilter::Type filterType)
+{
+    std::string error;
+
+    if (variant.streamRows >= 0)
+    {
+        return streamVariant(variant.streamRows, src, dst, filterType);
+    }
+
+    if (variant.workers)
+    {
+        return workersVariant(src, dst, filterType);
+    }
+
+    if (variant.defaults)
+    {
+        try
+        {
+            ImageFilter::filter(src, dst, filterType);
+        }
+        catch (const std::exception& e)
+        {
+            error = e.what();
+        }
+        return error;
+    }
+
+    Autotuner::Scope scope(&variant.config);
+    int fixedPoint = ImageFilter::setLocalFixedPoint(variant.fixedPoint);
+
+    try
+    {
+        ImageFilter::filter(src, dst, filterType);
+    }
+    catch (const std::exception& e)
+    {
+        error = e.what();
+    }
+
+    ImageFilter::setLocalFixedPoint(fixedPoint);
+
+    return error;
+}
+
+/**
+ * Spusteni kontroly. Pro kazdy filtr a vstup se spocita referencni vysledek
+ * a porovna se s vysledky vsech variant provadeni. Vystup se pred kazdou
+ * variantou prepise, nezapsane pixely se tak projevi jako neshoda.
+ *
+ * @param commandLine argumenty prikazove radky
+ * @return 0 - vsechny varianty davaji shodny vysledek
+ */
+int FilterCheck::run(const CommandLine& commandLine)
+{
+    std::vector<Input> inputs = createInputs(commandLine);
+
+    if (inputs.empty())
+    {
+        return 1;
+    }
+
+    std::cout << "inputs: " << inputs.size() << ", kernels:";
+    for (const KernelDispatch::Kernels* kernels : KernelDispatch::available())
+    {
+        std::cout << " " << kernels->name;
+    }
+    std::cout << std::endl;
+
+    char line[512];
+    snprintf(line, sizeof(line), "%-20s %8s %8s %6s %10s", "filter", "variants", "runs", "result", "mismatches");
+    std::cout << line << std::endl;
+
+    int failed = 0;
+
+    for (ImageFilter::Type filterType : commandLine.getFilterTypes())
+    {
+        std::vector<Variant> list = variants(filterType);
+        std::vector<std::string> reported;
+        int runs = 0;
+        int mismatches = 0;
+
+        for (const Input& input : inputs)
+        {
+            cv::Mat expected;
+            ReferenceFilter::filter(input.image, expected, filterType);
+
+            cv::Mat out;
+
+            for (const Variant& variant : list)
+            {
+                if (!out.empty())
+                {
+                    out.setTo(cv::Scalar::all(STALE_VALUE));
+                }
+
+                std::string error = filterVariant(variant, input.image, out, filterType);
+                int maxError = 0;
+                int pixels = 0;
+                runs++;
+
+                if (error.empty() && compare(out, expected, &maxError, &pixels))
+                {
+                    continue;
+                }
+
+                mismatches++;
+
+                if ((int) reported.size() < MAX_REPORTED)
+                {
+                    if (!error.empty())
+                    {
+                        snprintf(line, sizeof(line), "  %s, %s: exception: %s",
+                                 input.name.c_str(), variant.name.c_str(), error.c_str());
+                    }
+                    else if (maxError < 0)
+                    {
+                        snprintf(line, sizeof(line), "  %s, %s: output %dx%d type %d, expected %dx%d type %d",
+                                 input.name.c_str(), variant.name.c_str(), out.cols, out.rows, out.type(),
+                                 expected.cols, expected.rows, expected.type());
+                    }
+                    else
+                    {
+                        snprintf(line, sizeof(line), "  %s, %s: max error %d, %d of %d pixels differ",
+                                 input.name.c_str(), variant.name.c_str(), maxError, pixels,
+                                 (int) expected.total());
+                    }
+                    reported.push_back(line);
+                }
+            }
+        }
+
+        failed += mismatches == 0 ? 0 : 1;
+
+        snprintf(line, sizeof(line), "%-20s %8d %8d %6s %10d", ImageFilter::typeName(filterType),
+                 (int) list.size(), runs, mismatches == 0 ? "OK" : "FAIL", mismatches);
+        std::cout << line << std::endl;
+
+        for (const std::string& mismatch : reported)
+        {
+            std::cout << mismatch << std::endl;
+        }
+    }
+
+    return failed == 0 ? 0 : 1;
+}
+
+/**
+ * Vstupy kontroly: nahodne obrazy okrajovych velikosti (1x1, jeden radek
+ * nebo sloupec, liche sirky kolem delek vektoru, kolem velikosti bunky
+ * Glass), vetsi obraz pro vic pruhu a uloh, nesouvisle vyrezy, sede
+ * a konstantni obrazy, pripadne zadana rozliseni a obrazky.
+ *
+ * @param commandLine argumenty prikazove radky (-n nahodnych obrazu pro
+ *                    kazdou velikost, --size, obrazky)
+ * @return vstupy, prazdny seznam pri chybe
+ */
+std::vector<FilterCheck::Input> FilterCheck::createInputs(const CommandLine& commandLine)
+{
+    std::vector<Input> inputs;
+    char name[128];
+
+    // Stejne vstupy pri kazdem spusteni
+    cv::theRNG() = cv::RNG(20261019);
+
+    auto random = [](cv::Size size) {
+        cv::Mat image(size, CV_8UC3);
+        cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(256));
+        return image;
+    };
+
+    std::vector<cv::Size> sizes = {
+        cv::Size(1, 1), cv::Size(2, 2), cv::Size(1, 7), cv::Size(7, 1), cv::Size(3, 3),
+        cv::Size(5, 4), cv::Size(11, 11), cv::Size(17, 13), cv::Size(21, 23), cv::Size(33, 9),
+        cv::Size(65, 31), cv::Size(127, 33), cv::Size(320, 240)
+    };
+    sizes.insert(sizes.end(), commandLine.getSizes().begin(), commandLine.getSizes().end());
+
+    for (const cv::Size& size : sizes)
+    {
+        for (int i = 0; i < commandLine.getIterations(); i++)
+        {
+            snprintf(name, sizeof(name), "random %dx%d #%d", size.width, size.height, i);
+            inputs.push_back({name, random(size)});
+        }
+    }
+
+    // Nesouvisle vyrezy: radky nejsou za sebou a okolni pixely se nesmi cist
+    cv::Mat parent = random(cv::Size(97, 71));
+    inputs.push_back({"roi 61x47", parent(cv::Rect(5, 3, 61, 47))});
+    inputs.push_back({"roi 1x20", parent(cv::Rect(10, 2, 1, 20))});
+    inputs.push_back({"roi 40x1", parent(cv::Rect(7, 30, 40, 1))});
+
+    // Sede obrazy (R = G = B) a konstantni obrazy (jedina hodnota histogramu)
+    cv::Mat gray(cv::Size(65, 31), CV_8UC1);
+    cv::randu(gray, cv::Scalar::all(0), cv::Scalar::all(256));
+    cv::Mat grayBgr;
+    cv::cvtColor(gray, grayBgr, CV_GRAY2BGR);
+    inputs.push_back({"gray 65x31", grayBgr});
+
+    for (int value : {0, 128, 255})
+    {
+        snprintf(name, sizeof(name), "constant %d 33x17", value);
+        inputs.push_back({name, cv::Mat(cv::Size(33, 17), CV_8UC3, cv::Scalar::all(value))});
+    }
+
+    for (const std::string& path : commandLine.getInputs())
+    {
+        cv::Mat image = cv::imread(path);
+
+        if (image.empty())
+        {
+            std::cerr << "Could not load image: " << path << std::endl;
+            return std::vector<Input>();
+        }
+
+        inputs.push_back({path, image});
+    }
+
+    return inputs;
+}
+
+/**
+ * Porovnani vystupu s referenci (8bitove obrazy).
+ *
+ * @param out vystup varianty
+ * @param expected referencni vystup
+ * @param maxError vystupni nejvetsi absolutni odchylka (-1 - jina velikost nebo typ)
+ * @param pixels vystupni pocet pixelu, ktere se lisi alespon v jednom kanalu
+ * @return true - shodne obrazy
+ */
+bool FilterCheck::compare(const cv::Mat& out, const cv::Mat& expected, int* maxError, int* pixels)
+{
+    *maxError = 0;
+    *pixels = 0;
+
+    if (out.size() != expected.size() || out.type() != expected.type())
+    {
+        *maxError = -1;
+        return false;
+    }
+
+    int channels = expected.channels();
+
+    for (int j = 0; j < expected.rows; j++)
+    {
+        const uchar* outRow = out.ptr(j);
+        const uchar* expectedRow = expected.ptr(j);
+
+        for (int i = 0; i < expected.cols; i++)
+        {
+            bool differs = false;
+
+            for (int c = 0; c < channels; c++)
+            {
+                int error = abs(outRow[channels * i + c] - expectedRow[channels * i + c]);
+
+                if (error > 0)
+                {
+                    differs = true;
+                    *maxError = std::max(*maxError, error);
+                }
+            }
+
+            *pixels += differs ? 1 : 0;
+        }
+    }
+
+    return *pixels == 0;
+}
@@ -0,0 +1,49 @@
+/*
+ * Soubor: FilterCheck.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef FILTERCHECK_H
+#define	FILTERCHECK_H
+
+#include <string>
+#include <vector>
+
+#include <opencv2/core/core.hpp> // cv::Mat
+
+#include "CommandLine.h"
+
+/**
+ * Rozdilova kontrola filtru: kazda varianta provadeni ImageFilter (funkce
+ * radku, pocet vlaken, vyska pruhu, usporadani, celociselny vypocet),
+ * filtrace souboru po pruzich (StreamFilter) a soubezna filtrace ve vice
+ * vlaknech (--workers) se porovna s puvodni implementaci (ReferenceFilter)
+ * na nahodnych a okrajovych vstupech.
+ */
+class FilterCheck
+{
+    public:
+
+        // Vstup kontroly
+        struct Input
+        {
+            std::string name;
+            cv::Mat image;
+        };
+
+    public:
+
+        static int run(const CommandLine& commandLine);
+
+    private:
+
+        static std::vector<Input> createInputs(const CommandLine& commandLine);
+        static bool compare(const cv::Mat& out, const cv::Mat& expected,
+                            int* maxError, int* pixels);
+};
+
+#endif	/* FILTERCHECK_H */
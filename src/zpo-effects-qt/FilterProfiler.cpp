@@ -0,0 +1,240 @@
+/*
+ * Soubor: FilterProfiler.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "FilterProfiler.h"
+
+#include <algorithm>
+#include <cstdio>
+
+/**
+ * Konstruktor.
+ *
+ * @param useCounters true - merit i hardwarove citace (pokud jsou dostupne)
+ */
+FilterProfiler::FilterProfiler(bool useCounters)
+    : mUseCounters(useCounters)
+{
+    if (mUseCounters)
+    {
+        mCounters.open();
+    }
+}
+
+/**
+ * Filtrace obrazu s merenim casu a citacu.
+ *
+ * @param src vstupni obraz
+ * @param dst vystupni filtrovany obraz
+ * @param filterType typ filtru
+ */
+void FilterProfiler::filter(const cv::Mat& src, cv::Mat& dst, ImageFilter::Type filterType)
+{
+    bool counters = mUseCounters && mCounters.isOpen();
+
+    if (counters)
+    {
+        mCounters.start();
+    }
+
+    MemoryTracker::start();
+    long long start = cv::getTickCount();
+
+    ImageFilter::filter(src, dst, filterType);
+
+    long long end = cv::getTickCount();
+    MemoryTracker::Stats memory = MemoryTracker::stop();
+
+    PerfCounters::Sample sample;
+
+    if (counters)
+    {
+        sample = mCounters.stop();
+    }
+
+    Record& record = findRecord(filterType, src.size());
+
+    if (record.runs == 0)
+    {
+        record.counters = sample;
+    }
+    else
+    {
+        record.counters += sample;
+    }
+
+    record.runs++;
+    record.seconds += (end - start) / cv::getTickFrequency();
+    record.allocatedBytes += memory.allocatedBytes;
+    record.allocations += memory.allocations;
+    record.peakBytes = std::max(record.peakBytes, memory.peakBytes);
+}
+
+/**
+ * Nalezeni (pripadne zalozeni) zaznamu pro dany filtr a rozliseni.
+ *
+ * @param filterType typ filtru
+ * @param size rozliseni vstupu
+ * @return zaznam
+ */
+FilterProfiler::Record& FilterProfiler::findRecord(ImageFilter::Type filterType, cv::Size size)
+{
+    for (Record& record : mRecords)
+    {
+        if (record.filterType == filterType && record.size == size)
+        {
+            return record;
+        }
+    }
+
+    Record record;
+    record.filterType = filterType;
+    record.size = size;
+    record.runs = 0;
+    record.seconds = 0.0;
+    record.allocatedBytes = 0;
+    record.allocations = 0;
+    record.peakBytes = 0;
+    mRecords.push_back(record);
+
+    return mRecords.back();
+}
+
+/**
+ * Test na dostupnost hardwarovych citacu.
+ *
+ * @return true - citace se podarilo otevrit
+ */
+bool FilterProfiler::countersAvailable() const
+{
+    return mUseCounters && mCounters.isOpen();
+}
+
+/**
+ * Duvod nedostupnosti citacu.
+ *
+ * @return chybove hlaseni
+ */
+const std::string& FilterProfiler::countersError() const
+{
+    return mCounters.errorMessage();
+}
+
+/**
+ * Nasbirane zaznamy.
+ *
+ * @return zaznamy
+ */
+const std::vector<FilterProfiler::Record>& FilterProfiler::records() const
+{
+    return mRecords;
+}
+
+/**
+ * Vypis tabulky s vysledky mereni. Hodnoty citacu (soucet vsech vlaken
+ * filtru) jsou prepocteny na pixel, neplatne nebo nedostupne citace se
+ * vypisi jako "n/a". Alokace jsou
+ * prumerem na jedno volani, spicka je maximum pres vsechna volani.
+ *
+ * @param out vystupni proud
+ */
+void FilterProfiler::report(std::ostream& out) const
+{
+    char line[256];
+
+    bool memory = MemoryTracker::isSupported();
+
+    if (mUseCounters && mCounters.isOpen())
+    {
+        out << "counters: sum of " << mCounters.threadCount()
+            << " threads (caller and scheduler workers)" << std::endl;
+    }
+
+    snprintf(line, sizeof(line), "%-20s %11s %5s %10s %8s",
+             "filter", "resolution", "runs", "ms/frame", "Mpx/s");
+    out << line;
+
+    if (memory)
+    {
+        snprintf(line, sizeof(line), " %10s %8s %10s", "MB/call", "allocs", "peak MB");
+        out << line;
+    }
+
+    if (mUseCounters)
+    {
+        snprintf(line, sizeof(line), " %10s %6s %12s %12s",
+                 "cycles/px", "IPC", "LLC-miss/px", "br-miss/px");
+        out << line;
+    }
+
+    out << std::endl;
+
+    for (const Record& record : mRecords)
+    {
+        double pixels = (double) record.size.area() * record.runs;
+        double msPerFrame = record.seconds * 1000.0 / record.runs;
+        double mpxPerSecond = record.seconds > 0 ? pixels / record.seconds / 1e6 : 0.0;
+
+        char resolution[32];
+        snprintf(resolution, sizeof(resolution), "%dx%d", record.size.width, record.size.height);
+
+        snprintf(line, sizeof(line), "%-20s %11s %5d %10.2f %8.1f",
+                 ImageFilter::typeName(record.filterType), resolution,
+                 record.runs, msPerFrame, mpxPerSecond);
+        out << line;
+
+        if (memory)
+        {
+            snprintf(line, sizeof(line), " %10.2f %8lld %10.2f",
+                     record.allocatedBytes / (1024.0 * 1024.0) / record.runs,
+                     record.allocations / record.runs,
+                     record.peakBytes / (1024.0 * 1024.0));
+            out << line;
+        }
+
+        if (mUseCounters)
+        {
+            const PerfCounters::Sample& c = record.counters;
+            std::string cols[4] = {"n/a", "n/a", "n/a", "n/a"};
+
+            if (c.valid[PerfCounters::CYCLES])
+            {
+                snprintf(line, sizeof(line), "%.2f", c.value[PerfCounters::CYCLES] / pixels);
+                cols[0] = line;
+            }
+            if (c.valid[PerfCounters::CYCLES] && c.valid[PerfCounters::INSTRUCTIONS]
+                && c.value[PerfCounters::CYCLES] > 0)
+            {
+                snprintf(line, sizeof(line), "%.2f", (double) c.value[PerfCounters::INSTRUCTIONS]
+                                                     / c.value[PerfCounters::CYCLES]);
+                cols[1] = line;
+            }
+            if (c.valid[PerfCounters::CACHE_MISSES])
+            {
+                snprintf(line, sizeof(line), "%.4f", c.value[PerfCounters::CACHE_MISSES] / pixels);
+                cols[2] = line;
+            }
+            if (c.valid[PerfCounters::BRANCH_MISSES])
+            {
+                snprintf(line, sizeof(line), "%.4f", c.value[PerfCounters::BRANCH_MISSES] / pixels);
+                cols[3] = line;
+            }
+
+            snprintf(line, sizeof(line), " %10s %6s %12s %12s",
+                     cols[0].c_str(), cols[1].c_str(), cols[2].c_str(), cols[3].c_str());
+            out << line;
+        }
+
+        out << std::endl;
+    }
+
+    if (mUseCounters && !mCounters.isOpen())
+    {
+        out << "hardware counters unavailable: " << mCounters.errorMessage() << std::endl;
+    }
+}
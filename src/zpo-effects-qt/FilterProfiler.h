@@ -0,0 +1,69 @@
+/*
+ * Soubor: FilterProfiler.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef FILTERPROFILER_H
+#define	FILTERPROFILER_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <opencv2/core/core.hpp> // cv::Mat
+
+#include "ImageFilter.h"
+#include "MemoryTracker.h"
+#include "PerfCounters.h"
+
+/**
+ * Mereni jednotlivych volani ImageFilter::filter. Pro kazdou dvojici
+ * (filtr, rozliseni) se scita cas, alokace na halde a pripadne hodnoty
+ * hardwarovych citacu. Hardwarove citace meri pouze vlakno, ktere filtr
+ * vola, alokace toto vlakno a ulohy planovace spustene filtrem
+ * (MemoryTracker), ne ostatni vlakna procesu.
+ */
+class FilterProfiler
+{
+    public:
+
+        struct Record
+        {
+            ImageFilter::Type filterType;
+            cv::Size size;
+            int runs;
+            double seconds;
+            PerfCounters::Sample counters;
+            long long allocatedBytes; /// soucet pres vsechna volani
+            long long allocations;    /// soucet pres vsechna volani
+            long long peakBytes;      /// maximum pres vsechna volani
+        };
+
+    private:
+
+        PerfCounters mCounters;
+        bool mUseCounters;
+        std::vector<Record> mRecords;
+
+    public:
+
+        explicit FilterProfiler(bool useCounters);
+
+        void filter(const cv::Mat& src, cv::Mat& dst, ImageFilter::Type filterType);
+
+        bool countersAvailable() const;
+        const std::string& countersError() const;
+        const std::vector<Record>& records() const;
+
+        void report(std::ostream& out) const;
+
+    private:
+
+        Record& findRecord(ImageFilter::Type filterType, cv::Size size);
+};
+
+#endif	/* FILTERPROFILER_H */
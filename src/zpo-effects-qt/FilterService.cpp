@@ -0,0 +1,298 @@
+/*
+ * Soubor: FilterService.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "FilterService.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "BufferPool.h"
+#include "ServiceProtocol.h"
+#include "TaskScheduler.h"
+
+// Nejvetsi davka na vlakno planovace
+static const int BATCH_PER_THREAD = 2;
+
+// Cekani pred dalsim accept pri nedostatku prostredku (napr. EMFILE)
+static const int ACCEPT_BACKOFF_MS = 100;
+
+FilterService::FilterService()
+    : mRequests(0)
+    , mBatches(0)
+    , mMaxDepth(0)
+    , mMaxBatch(BATCH_PER_THREAD * TaskScheduler::instance().threadCount())
+    , mArenas(mMaxBatch)
+{
+}
+
+/**
+ * Spusteni sluzby: naslouchani na socketu a obsluha klientu az do
+ * ukonceni procesu. Pri nedostatku prostredku (prilis mnoho otevrenych
+ * souboru) accept chvili pocka, az se spojeni uzavrou; jina chyba accept
+ * sluzbu ukonci.
+ *
+ * @param commandLine argumenty prikazove radky (cesta k socketu)
+ * @return navratovy kod programu (jen pri chybe, jinak se nevraci)
+ */
+int FilterService::run(const CommandLine& commandLine)
+{
+    const std::string& path = commandLine.getInputs().front();
+    int listener = ServiceProtocol::listen(path);
+
+    if (listener < 0)
+    {
+        std::cerr << "Could not listen on socket: " << path << std::endl;
+        return 1;
+    }
+
+    std::cout << "listening on " << path << ", " << TaskScheduler::instance().threadCount()
+              << " threads" << std::endl;
+
+    FilterService* service = new FilterService();
+
+    std::thread(&FilterService::dispatch, service).detach();
+
+    bool waiting = false;
+
+    while (true)
+    {
+        int fd = ServiceProtocol::accept(listener);
+
+        if (fd >= 0)
+        {
+            waiting = false;
+            std::thread(&FilterService::serveClient, service, fd).detach();
+            continue;
+        }
+
+        int error = errno;
+
+        if (error == EINTR || error == ECONNABORTED)
+        {
+            continue;
+        }
+
+        if (error != EMFILE && error != ENFILE && error != ENOBUFS && error != ENOMEM)
+        {
+            std::cerr << "Could not accept connection: " << strerror(error) << std::endl;
+            return 1;
+        }
+
+        if (!waiting)
+        {
+            std::cerr << "Could not accept connection: " << strerror(error) << ", retrying" << std::endl;
+            waiting = true;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(ACCEPT_BACKOFF_MS));
+    }
+}
+
+/**
+ * Obsluha spojeni: pozadavky se zpracovavaji postupne, obrazky a vysledky
+ * pouzivaji buffery spojeni.
+ *
+ * @param fd socket spojeni
+ */
+void FilterService::serveClient(int fd)
+{
+    BufferPool pool(2);
+    std::vector<ImageFilter::Type> types = ImageFilter::allTypes();
+    ServiceProtocol::Request request;
+
+    while (ServiceProtocol::readFully(fd, &request, sizeof(request)))
+    {
+        if (!ServiceProtocol::isValid(request))
+        {
+            // Za chybnou hlavickou nelze najit zacatek dalsiho pozadavku
+            ServiceProtocol::Response response = ServiceProtocol::response(ServiceProtocol::BAD_REQUEST,
+                                                                           cv::Size(), 0, 0);
+            ServiceProtocol::writeFully(fd, &response, sizeof(response));
+            break;
+        }
+
+        if (request.command == ServiceProtocol::STATS)
+        {
+            std::string text = statistics();
+            ServiceProtocol::Response response = ServiceProtocol::response(ServiceProtocol::OK, cv::Size(), 0,
+                                                                           (int) text.size());
+
+            if (!ServiceProtocol::writeFully(fd, &response, sizeof(response))
+                || !ServiceProtocol::writeFully(fd, text.data(), text.size()))
+            {
+                break;
+            }
+            continue;
+        }
+
+        cv::Size size(request.width, request.height);
+        ImageFilter::Type filterType = (ImageFilter::Type) request.filterType;
+        bool known = std::find(types.begin(), types.end(), filterType) != types.end();
+
+        Job job;
+        job.image = pool.acquire(size, CV_8UC3);
+
+        if (!ServiceProtocol::readPixels(fd, job.image))
+        {
+            break;
+        }
+
+        job.filterType = filterType;
+        job.failed = !known;
+
+        if (known)
+        {
+            job.result = pool.acquire(size, ImageFilter::outputType(filterType, CV_8UC3));
+            job.failed = !submit(&job);
+        }
+
+        ServiceProtocol::Response response = job.failed
+            ? ServiceProtocol::response(known ? ServiceProtocol::FAILED : ServiceProtocol::BAD_REQUEST,
+                                        cv::Size(), 0, 0)
+            : ServiceProtocol::response(ServiceProtocol::OK, job.result.size(), job.result.channels(),
+                                        (int) (job.result.total() * job.result.elemSize()));
+
+        if (!ServiceProtocol::writeFully(fd, &response, sizeof(response))
+            || (!job.failed && !ServiceProtocol::writePixels(fd, job.result)))
+        {
+            break;
+        }
+    }
+
+    ServiceProtocol::close(fd);
+}
+
+/**
+ * Zarazeni ulohy a cekani na jeji dokonceni.
+ *
+ * @param job uloha
+ * @return false - filtrace selhala
+ */
+bool FilterService::submit(Job* job)
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    job->queued = cv::getTickCount();
+    job->done = false;
+    mQueue.push_back(job);
+    mMaxDepth = std::max(mMaxDepth, mQueue.size());
+    mQueued.notify_one();
+
+    mFinished.wait(lock, [job] { return job->done; });
+
+    return !job->failed;
+}
+
+/**
+ * Dispecer: odebira davky cekajicich uloh a filtruje je soubezne.
+ */
+void FilterService::dispatch()
+{
+    std::vector<Job*> batch;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mQueued.wait(lock, [this] { return !mQueue.empty(); });
+
+            batch.clear();
+            while (!mQueue.empty() && batch.size() < mMaxBatch)
+            {
+                batch.push_back(mQueue.front());
+                mQueue.pop_front();
+            }
+            mBatches++;
+        }
+
+        // Ulohy davky jako soubezne ulohy planovace, kazda s vlastni sadou
+        // ScratchArena (vlakno, ktere ve filtru ceka na ulohy, muze mezitim
+        // vykonat jinou ulohu davky). Filtr se dal deli mezi vlakna
+        // planovace, uloha se dokonci hned po sve filtraci.
+        TaskGroup group;
+
+        for (size_t i = 0; i < batch.size(); i++)
+        {
+            Job* job = batch[i];
+            ScratchArena* arena = &mArenas[i];
+
+            group.run([this, job, arena] {
+                ScratchArena::Scope scope(arena);
+                process(job);
+            });
+        }
+
+        group.wait();
+    }
+}
+
+/**
+ * Filtrace ulohy a oznameni jejiho dokonceni.
+ *
+ * @param job uloha
+ */
+void FilterService::process(Job* job)
+{
+    bool failed = false;
+
+    try
+    {
+        ImageFilter::filter(job->image, job->result, job->filterType);
+    }
+    catch (const std::exception&)
+    {
+        failed = true;
+    }
+
+    long long now = cv::getTickCount();
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        mLatency.add((now - job->queued) * 1000.0 / cv::getTickFrequency());
+        mRequests++;
+        job->failed = failed;
+        job->done = true;
+    }
+
+    mFinished.notify_all();
+}
+
+/**
+ * Text statistik sluzby.
+ *
+ * @return statistiky (radky "nazev hodnota")
+ */
+std::string FilterService::statistics()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    char text[512];
+    snprintf(text, sizeof(text),
+             "requests %lld\n"
+             "queue_depth %zu\n"
+             "queue_depth_max %zu\n"
+             "batches %lld\n"
+             "batch_mean %.2f\n"
+             "latency_ms_p50 %.3f\n"
+             "latency_ms_p95 %.3f\n"
+             "latency_ms_p99 %.3f\n"
+             "latency_ms_max %.3f\n",
+             mRequests, mQueue.size(), mMaxDepth, mBatches,
+             mBatches > 0 ? (double) mRequests / mBatches : 0.0,
+             mLatency.percentile(50), mLatency.percentile(95), mLatency.percentile(99),
+             mLatency.percentile(100));
+
+    return text;
+}
@@ -0,0 +1,78 @@
+/*
+ * Soubor: FilterService.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef FILTERSERVICE_H
+#define	FILTERSERVICE_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <opencv2/core/core.hpp> // cv::Mat
+
+#include "CommandLine.h"
+#include "ImageFilter.h"
+#include "LatencyStats.h"
+#include "ScratchArena.h"
+
+/**
+ * Filtrovaci sluzba na Unix domain socketu (protokol ServiceProtocol.h).
+ * Kazde spojeni obsluhuje vlastni vlakno: nacte obrazek do bufferu
+ * spojeni (BufferPool, opakovane pouzivane mezi pozadavky), zaradi ulohu
+ * do fronty a po dokonceni posle vysledek. Dispecer odebira z fronty
+ * cekajici ulohy najednou (davku) a spusti je soubezne jako ulohy
+ * planovace, kazdou s vlastni sadou ScratchArena; filtr kazde ulohy se
+ * dal deli mezi vlakna planovace. Uloha se dokonci hned po sve filtraci
+ * (neceka na zbytek davky). Prikaz STATS vraci hloubku fronty, velikost
+ * davek a percentily latence (od nacteni pozadavku po dokonceni filtrace).
+ */
+class FilterService
+{
+    private:
+
+        struct Job
+        {
+            cv::Mat image;
+            cv::Mat result;
+            ImageFilter::Type filterType;
+            long long queued;           // cv::getTickCount pri zarazeni
+            bool done;
+            bool failed;
+        };
+
+        std::mutex mMutex;
+        std::condition_variable mQueued;
+        std::condition_variable mFinished;
+        std::deque<Job*> mQueue;
+
+        long long mRequests;
+        long long mBatches;
+        size_t mMaxDepth;
+        size_t mMaxBatch;
+        std::vector<ScratchArena> mArenas; // pro kazde misto davky
+        LatencyStats mLatency;
+
+    public:
+
+        static int run(const CommandLine& commandLine);
+
+    private:
+
+        FilterService();
+
+        void serveClient(int fd);
+        void dispatch();
+        void process(Job* job);
+        bool submit(Job* job);
+        std::string statistics();
+};
+
+#endif	/* FILTERSERVICE_H */
@@ -0,0 +1,242 @@
+/*
+ * Soubor: FrameFile.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "FrameFile.h"
+
+#include <cstring>
+
+#include <QFileInfo>
+#include <QString>
+
+static const char MAGIC[4] = { 'Z', 'P', 'O', 'F' };
+static const qint32 VERSION = 1;
+
+// Zarovnani radku a zacatku dat (radek cache, SIMD)
+static const int ALIGNMENT = 64;
+
+/**
+ * Hlavicka souboru.
+ */
+struct FrameFileHeader
+{
+    char magic[4];
+    qint32 version;
+    qint32 width;
+    qint32 height;
+    qint32 type;
+    qint32 stride;
+    qint32 frameCount;
+    qint32 dataOffset;
+};
+
+static const qint32 DATA_OFFSET = (sizeof(FrameFileHeader) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+
+/**
+ * Typy snimku, ktere kontejner uklada (vstupy a vystupy filtru).
+ *
+ * @param type typ OpenCV z hlavicky
+ * @return true - CV_8UC1 nebo CV_8UC3
+ */
+static bool isSupportedType(qint32 type)
+{
+    return type == CV_8UC1 || type == CV_8UC3;
+}
+
+FrameFile::FrameFile()
+    : mData(nullptr)
+    , mType(0)
+    , mStride(0)
+    , mFrameCount(0)
+{
+}
+
+FrameFile::~FrameFile()
+{
+    close();
+}
+
+/**
+ * Otevreni souboru pro cteni a namapovani snimku.
+ *
+ * @param path cesta k souboru
+ * @return false - soubor nelze otevrit, neni to kontejner snimku, hlavicka
+ *         je neplatna (typ, rozmery) nebo je soubor kratsi nez podle ni
+ */
+bool FrameFile::open(const std::string& path)
+{
+    close();
+
+    mFile.setFileName(QString::fromStdString(path));
+
+    FrameFileHeader header;
+
+    if (!mFile.open(QIODevice::ReadOnly)
+        || mFile.read((char*) &header, sizeof(header)) != (qint64) sizeof(header)
+        || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION
+        || header.width <= 0 || header.height <= 0 || header.frameCount < 0 || !isSupportedType(header.type)
+        || header.stride < (qint64) header.width * CV_ELEM_SIZE(header.type)
+        || header.dataOffset < (qint32) sizeof(header) || header.dataOffset > mFile.size())
+    {
+        mFile.close();
+        return false;
+    }
+
+    // Delka dat podle hlavicky se porovna delenim (soucin muze pretect)
+    qint64 frameBytes = (qint64) header.height * header.stride;
+
+    if (header.frameCount > 0 && frameBytes > (mFile.size() - header.dataOffset) / header.frameCount)
+    {
+        mFile.close();
+        return false;
+    }
+
+    qint64 length = frameBytes * header.frameCount;
+
+    if (length > 0)
+    {
+        mData = mFile.map(header.dataOffset, length);
+
+        if (mData == nullptr)
+        {
+            mFile.close();
+            return false;
+        }
+    }
+
+    mSize = cv::Size(header.width, header.height);
+    mType = header.type;
+    mStride = header.stride;
+    mFrameCount = header.frameCount;
+
+    return true;
+}
+
+/**
+ * Vytvoreni souboru plne velikosti a namapovani snimku pro zapis.
+ *
+ * @param path cesta k souboru
+ * @param size velikost snimku
+ * @param type typ OpenCV (napr. CV_8UC3)
+ * @param frameCount pocet snimku
+ * @return false - soubor nelze vytvorit nebo namapovat
+ */
+bool FrameFile::create(const std::string& path, cv::Size size, int type, int frameCount)
+{
+    close();
+
+    FrameFileHeader header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.width = size.width;
+    header.height = size.height;
+    header.type = type;
+    header.stride = (size.width * (int) CV_ELEM_SIZE(type) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    header.frameCount = frameCount;
+    header.dataOffset = DATA_OFFSET;
+
+    qint64 length = (qint64) header.height * header.stride * frameCount;
+
+    mFile.setFileName(QString::fromStdString(path));
+
+    if (!mFile.open(QIODevice::ReadWrite | QIODevice::Truncate)
+        || mFile.write((const char*) &header, sizeof(header)) != (qint64) sizeof(header)
+        || !mFile.resize(header.dataOffset + length))
+    {
+        mFile.close();
+        return false;
+    }
+
+    if (length > 0)
+    {
+        mData = mFile.map(header.dataOffset, length);
+
+        if (mData == nullptr)
+        {
+            mFile.close();
+            return false;
+        }
+    }
+
+    mSize = size;
+    mType = type;
+    mStride = header.stride;
+    mFrameCount = frameCount;
+
+    return true;
+}
+
+/**
+ * Odmapovani a uzavreni souboru (zapsana data zapise system).
+ *
+ * @return false - chyba pri odmapovani nebo zavreni
+ */
+bool FrameFile::close()
+{
+    bool ok = true;
+
+    if (mData != nullptr)
+    {
+        ok = mFile.unmap(mData);
+        mData = nullptr;
+    }
+
+    if (mFile.isOpen())
+    {
+        mFile.close();
+        ok = ok && mFile.error() == QFileDevice::NoError;
+    }
+
+    mFrameCount = 0;
+
+    return ok;
+}
+
+/**
+ * Snimek jako pohled do mapovaneho souboru. Snimky souboru otevreneho
+ * pro cteni jsou jen pro cteni (zapis skonci chybou pristupu).
+ *
+ * @param index index snimku
+ * @return snimek (prazdny pro index mimo soubor)
+ */
+cv::Mat FrameFile::frame(int index) const
+{
+    if (index < 0 || index >= mFrameCount)
+    {
+        return cv::Mat();
+    }
+
+    return cv::Mat(mSize.height, mSize.width, mType,
+                   mData + (size_t) index * mSize.height * mStride, mStride);
+}
+
+cv::Size FrameFile::size() const
+{
+    return mSize;
+}
+
+int FrameFile::type() const
+{
+    return mType;
+}
+
+int FrameFile::frameCount() const
+{
+    return mFrameCount;
+}
+
+/**
+ * Test pripony kontejneru snimku.
+ *
+ * @param path cesta k souboru
+ * @return true - pripona .zpof
+ */
+bool FrameFile::isFrameFile(const std::string& path)
+{
+    return QFileInfo(QString::fromStdString(path)).suffix().compare("zpof", Qt::CaseInsensitive) == 0;
+}
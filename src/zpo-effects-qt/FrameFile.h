@@ -0,0 +1,59 @@
+/*
+ * Soubor: FrameFile.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef FRAMEFILE_H
+#define	FRAMEFILE_H
+
+#include <string>
+
+#include <QFile>
+
+#include <opencv2/core/core.hpp> // cv::Mat
+
+/**
+ * Nekomprimovany kontejner snimku (.zpof) mapovany do pameti. Hlavicka
+ * (32bitova cisla, poradi bajtu stroje): "ZPOF", verze, sirka, vyska, typ
+ * OpenCV, delka radku v bajtech (zarovnana na 64 B), pocet snimku a offset
+ * dat; za ni nasleduji snimky stejne velikosti. Snimky jsou pohledy
+ * cv::Mat primo do mapovaneho souboru (bez kopie a dekodovani), vystupni
+ * soubor ma pri vytvoreni plnou velikost a filtr zapisuje primo do nej.
+ */
+class FrameFile
+{
+    private:
+
+        QFile mFile;
+        uchar* mData;                    // zacatek dat snimku
+        cv::Size mSize;
+        int mType;
+        int mStride;
+        int mFrameCount;
+
+    public:
+
+        FrameFile();
+        ~FrameFile();
+
+        FrameFile(const FrameFile&) = delete;
+        FrameFile& operator=(const FrameFile&) = delete;
+
+        bool open(const std::string& path);
+        bool create(const std::string& path, cv::Size size, int type, int frameCount);
+        bool close();
+
+        cv::Mat frame(int index) const;
+
+        cv::Size size() const;
+        int type() const;
+        int frameCount() const;
+
+        static bool isFrameFile(const std::string& path);
+};
+
+#endif	/* FRAMEFILE_H */
@@ -0,0 +1,402 @@
+/*
+ * Soubor: FrameProcessor.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "FrameProcessor.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include <opencv2/imgproc/imgproc.hpp> // cv::resize
+
+#include "KernelDispatch.h"
+
+// Vychozi interval filtrace celeho snimku v casovem rezimu
+static const int DEFAULT_REFRESH_INTERVAL = 30;
+
+/**
+ * Ciselna hodnota promenne prostredi.
+ *
+ * @param name nazev promenne
+ * @param defaultValue hodnota, pokud promenna neni nastavena
+ * @return hodnota
+ */
+static double environmentValue(const char* name, double defaultValue)
+{
+    const char* value = getenv(name);
+
+    if (value == nullptr || *value == '\0')
+    {
+        return defaultValue;
+    }
+
+    return atof(value);
+}
+
+FrameProcessor::FrameProcessor()
+    : mFilterType(ImageFilter::Type::NoFilter)
+    , mTemporal(false)
+    , mThreshold(std::max(environmentValue("ZPO_DIRTY_THRESHOLD", 0), 0.0))
+    , mRefreshInterval((int) environmentValue("ZPO_REFRESH_INTERVAL", DEFAULT_REFRESH_INTERVAL))
+    , mSinceRefresh(0)
+    , mScale(1.0)
+{
+    resetStatistics();
+}
+
+/**
+ * Nastaveni typu filtru.
+ *
+ * @param filterType typ filtru
+ */
+void FrameProcessor::setFilterType(ImageFilter::Type filterType)
+{
+    if (filterType != mFilterType)
+    {
+        invalidate();
+    }
+
+    mFilterType = filterType;
+}
+
+/**
+ * Ziskani typu filtru.
+ *
+ * @return typ filtru
+ */
+ImageFilter::Type FrameProcessor::getFilterType() const
+{
+    return mFilterType;
+}
+
+/**
+ * Zapnuti/vypnuti casoveho rezimu (prepocet jen zmenenych dlazdic).
+ * ZPO_DIRTY_TILES=0 rezim vynucene vypne.
+ *
+ * @param enabled true - casovy rezim
+ */
+void FrameProcessor::setTemporal(bool enabled)
+{
+    if (environmentValue("ZPO_DIRTY_TILES", 1) == 0)
+    {
+        enabled = false;
+    }
+
+    if (!enabled)
+    {
+        invalidate();
+        mReference.release();
+        mWindow.release();
+    }
+
+    mTemporal = enabled;
+}
+
+/**
+ * Test casoveho rezimu.
+ *
+ * @return true - prepocitavaji se jen zmenene dlazdice
+ */
+bool FrameProcessor::isTemporal() const
+{
+    return mTemporal;
+}
+
+/**
+ * Nastaveni prahu zmeny dlazdice.
+ *
+ * @param threshold prumerny absolutni rozdil hodnot kanalu, od ktereho se
+ *                  dlazdice prepocita (0 - kazda zmena)
+ */
+void FrameProcessor::setDirtyThreshold(double threshold)
+{
+    mThreshold = std::max(threshold, 0.0);
+}
+
+/**
+ * Ziskani prahu zmeny dlazdice.
+ *
+ * @return prumerny absolutni rozdil hodnot kanalu
+ */
+double FrameProcessor::getDirtyThreshold() const
+{
+    return mThreshold;
+}
+
+/**
+ * Nastaveni intervalu filtrace celeho snimku v casovem rezimu.
+ *
+ * @param frames kazdy kolikaty snimek se filtruje cely (0 - jen pri zmene
+ *               velikosti nebo filtru)
+ */
+void FrameProcessor::setRefreshInterval(int frames)
+{
+    mRefreshInterval = std::max(frames, 0);
+}
+
+/**
+ * Nastaveni meritka zpracovani (QualityGovernor). Filtruje se zmenseny
+ * snimek, vystup se zvetsi na velikost vstupu.
+ *
+ * @param scale meritko (1 - plne rozliseni)
+ */
+void FrameProcessor::setScale(double scale)
+{
+    mScale = std::min(std::max(scale, 0.01), 1.0);
+}
+
+/**
+ * Ziskani meritka zpracovani.
+ *
+ * @return meritko (1 - plne rozliseni)
+ */
+double FrameProcessor::getScale() const
+{
+    return mScale;
+}
+
+/**
+ * Pocitadla casoveho rezimu od posledniho resetStatistics.
+ *
+ * @return pocitadla
+ */
+const FrameProcessor::Statistics& FrameProcessor::statistics() const
+{
+    return mStatistics;
+}
+
+/**
+ * Vynulovani pocitadel.
+ */
+void FrameProcessor::resetStatistics()
+{
+    mStatistics = Statistics{0, 0, 0, 0};
+}
+
+/**
+ * Buffer pro dalsi vstupni snimek. Pri zachovani velikosti a typu snimku
+ * se do nej zapisuje bez nove alokace (cv::VideoCapture::read, copyTo).
+ *
+ * @return vstupni buffer
+ */
+cv::Mat& FrameProcessor::input()
+{
+    return mInput;
+}
+
+/**
+ * Filtrace snimku ve vstupnim bufferu. Pri meritku mensim nez 1 se
+ * filtruje zmenseny snimek a vysledek se zvetsi na velikost vstupu.
+ *
+ * @return filtrovany snimek ze zasobniku; do zasobniku se vrati, jakmile
+ *         zaniknou vsechny jeho kopie
+ */
+cv::Mat FrameProcessor::process()
+{
+    if (mInput.empty())
+    {
+        return cv::Mat();
+    }
+
+    // Prvni snimek alokoval zdroj sam, dalsi se budou cist do zarovnaneho
+    if (!BufferPool::isAligned(mInput))
+    {
+        cv::Mat aligned = BufferPool::createAligned(mInput.size(), mInput.type());
+        mInput.copyTo(aligned);
+        mInput = aligned;
+    }
+
+    mStatistics.frames++;
+
+    if (mScale >= 1.0)
+    {
+        return filterFrame(mInput, mOutputPool);
+    }
+
+    cv::Size size(std::max((int) (mInput.cols * mScale + 0.5), 1),
+                  std::max((int) (mInput.rows * mScale + 0.5), 1));
+
+    if (mScaledInput.size() != size || mScaledInput.type() != mInput.type())
+    {
+        mScaledInput = BufferPool::createAligned(size, mInput.type());
+    }
+
+    cv::resize(mInput, mScaledInput, size, 0, 0, cv::INTER_AREA);
+
+    cv::Mat scaled = filterFrame(mScaledInput, mScaledPool);
+    cv::Mat output = mOutputPool.acquire(mInput.size(), scaled.type());
+
+    cv::resize(scaled, output, mInput.size(), 0, 0, cv::INTER_LINEAR);
+
+    return output;
+}
+
+/**
+ * Filtrace snimku (plneho nebo zmenseneho), v casovem rezimu jen zmenenych
+ * dlazdic.
+ *
+ * @param source vstupni snimek
+ * @param pool zasobnik vystupu velikosti snimku
+ * @return filtrovany snimek ze zasobniku
+ */
+cv::Mat FrameProcessor::filterFrame(const cv::Mat& source, BufferPool& pool)
+{
+    int type = ImageFilter::outputType(mFilterType, source.type());
+    cv::Mat output = pool.acquire(source.size(), type);
+
+    if (!mTemporal)
+    {
+        ImageFilter::filter(source, output, mFilterType);
+        return output;
+    }
+
+    if (mFilterType == ImageFilter::Type::Glass)
+    {
+        mGlass.filter(source, output);
+        mStatistics.tiles += mGlass.blockCount();
+        mStatistics.dirtyTiles += mGlass.updatedBlocks();
+        return output;
+    }
+
+    if (!processDirtyTiles(source, output))
+    {
+        ImageFilter::filter(source, output, mFilterType);
+        source.copyTo(mReference);
+        mSinceRefresh = 0;
+        mStatistics.refreshes++;
+    }
+
+    // Odkaz drzi buffer mimo zasobnik do dalsiho snimku
+    mPrevious = output;
+
+    return output;
+}
+
+/**
+ * Filtrace jen zmenenych dlazdic. Vsechny dlazdice se nejdrive porovnaji
+ * s puvodnim vstupem a az pak se prepocitaji a vstup se ulozi (okoli
+ * dlazdice se prekryva se sousednimi dlazdicemi, porovnani s jiz
+ * ulozenym vstupem souseda by zmenu okoli nevidelo). Dlazdice se filtruje
+ * v okne stale velikosti TILE_SIZE + 2 * polomer (mezivysledky filtru se
+ * tak nerealokuji) posunutem dovnitr snimku; okraj okna je od dlazdice
+ * vzdalen aspon o polomer masek, nebo lezi na okraji snimku.
+ *
+ * @param source vstupni snimek
+ * @param output vystupni snimek
+ * @return false - snimek je treba filtrovat cely (prvni snimek, zmena
+ *         velikosti nebo filtru, interval, filtr zavisly na celem obrazu)
+ */
+bool FrameProcessor::processDirtyTiles(const cv::Mat& source, cv::Mat& output)
+{
+    int radius = ImageFilter::stencilRadius(mFilterType);
+    int window = TILE_SIZE + 2 * radius;
+
+    if (radius < 0 || mPrevious.empty() || mPrevious.size() != output.size()
+        || mPrevious.type() != output.type() || mReference.size() != source.size()
+        || mReference.type() != source.type()
+        || (mRefreshInterval > 0 && mSinceRefresh + 1 >= mRefreshInterval)
+        || source.cols < window || source.rows < window)
+    {
+        return false;
+    }
+
+    mSinceRefresh++;
+
+    cv::Rect image(0, 0, source.cols, source.rows);
+    int tileCols = (source.cols + TILE_SIZE - 1) / TILE_SIZE;
+    int tileRows = (source.rows + TILE_SIZE - 1) / TILE_SIZE;
+
+    mDirty.resize(tileCols * tileRows);
+
+    for (int y = 0; y < source.rows; y += TILE_SIZE)
+    {
+        for (int x = 0; x < source.cols; x += TILE_SIZE)
+        {
+            cv::Rect tile(x, y, std::min(TILE_SIZE, source.cols - x), std::min(TILE_SIZE, source.rows - y));
+
+            // Vstup, na kterem zavisi vystup dlazdice
+            cv::Rect field(x - radius, y - radius, tile.width + 2 * radius, tile.height + 2 * radius);
+            field &= image;
+
+            mDirty[(y / TILE_SIZE) * tileCols + x / TILE_SIZE] = isChanged(source, field);
+        }
+    }
+
+    for (int y = 0; y < source.rows; y += TILE_SIZE)
+    {
+        for (int x = 0; x < source.cols; x += TILE_SIZE)
+        {
+            cv::Rect tile(x, y, std::min(TILE_SIZE, source.cols - x), std::min(TILE_SIZE, source.rows - y));
+
+            mStatistics.tiles++;
+
+            cv::Mat outputTile = output(tile);
+
+            if (!mDirty[(y / TILE_SIZE) * tileCols + x / TILE_SIZE])
+            {
+                mPrevious(tile).copyTo(outputTile);
+                continue;
+            }
+
+            mStatistics.dirtyTiles++;
+
+            cv::Rect area(std::min(std::max(x - radius, 0), source.cols - window),
+                          std::min(std::max(y - radius, 0), source.rows - window),
+                          window, window);
+
+            ImageFilter::filter(source(area), mWindow, mFilterType);
+
+            mWindow(tile - area.tl()).copyTo(outputTile);
+
+            cv::Mat referenceTile = mReference(tile);
+            source(tile).copyTo(referenceTile);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Porovnani oblasti vstupu se vstupem predchozi filtrace.
+ *
+ * @param source vstupni snimek
+ * @param rect oblast snimku
+ * @return true - prumerny absolutni rozdil prekracuje prah
+ */
+bool FrameProcessor::isChanged(const cv::Mat& source, const cv::Rect& rect) const
+{
+    const KernelDispatch::Kernels& kernels = KernelDispatch::active();
+
+    int pixelBytes = (int) source.elemSize();
+    int length = rect.width * pixelBytes;
+    long long limit = (long long) (mThreshold * length * rect.height);
+    long long sum = 0;
+
+    for (int j = rect.y; j < rect.y + rect.height; j++)
+    {
+        sum += kernels.sad(source.ptr(j) + rect.x * pixelBytes,
+                           mReference.ptr(j) + rect.x * pixelBytes, length);
+
+        if (sum > limit)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Zahozeni predchoziho vystupu, dalsi snimek se filtruje cely.
+ */
+void FrameProcessor::invalidate()
+{
+    mGlass.reset();
+    mPrevious.release();
+    mSinceRefresh = 0;
+}
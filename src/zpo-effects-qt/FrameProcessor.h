@@ -0,0 +1,104 @@
+/*
+ * Soubor: FrameProcessor.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef FRAMEPROCESSOR_H
+#define	FRAMEPROCESSOR_H
+
+#include <vector>
+
+#include <opencv2/core/core.hpp> // cv::Mat
+
+#include "BufferPool.h"
+#include "ImageFilter.h"
+#include "IncrementalGlass.h"
+
+/**
+ * Filtrace sekvence snimku (video, kamera) bez alokaci v ustalenem stavu.
+ * Vstupni snimek se nacita do vlastniho bufferu (input()), vystupy se
+ * berou ze zasobniku a mezivysledky filtru z ScratchArena. Snimek lze
+ * filtrovat ve zmensenem meritku (setScale, QualityGovernor.h).
+ *
+ * V casovem rezimu (setTemporal) se snimek po dlazdicich porovna se
+ * vstupem predchozi filtrace (soucet absolutnich rozdilu vcetne okoli
+ * masek) a filtr se spusti jen na zmenenych dlazdicich, ostatni se
+ * zkopiruji z predchoziho vystupu. Dlazdice je zmenena, pokud prumerny
+ * rozdil prekroci prah (ZPO_DIRTY_THRESHOLD, vychozi 0 - vysledek je
+ * shodny s filtraci celeho snimku). Kazdy ZPO_REFRESH_INTERVAL. snimek
+ * (vychozi 30) se filtruje cely, odchylka pri nenulovem prahu se tak
+ * nehromadi. Filtry zavisle na celem obrazu (stencilRadius -1) se filtruji
+ * vzdy cele, krome Glass, ktery si mezi snimky drzi vlastni stav
+ * (IncrementalGlass.h, bez odchylky, proto bez intervalu). ZPO_DIRTY_TILES=0
+ * casovy rezim vypne.
+ */
+class FrameProcessor
+{
+    public:
+
+        // Velikost dlazdice casoveho rezimu
+        static const int TILE_SIZE = 64;
+
+        // Pocitadla casoveho rezimu
+        struct Statistics
+        {
+            long long frames;
+            long long refreshes;    // snimky filtrovane cele
+            long long tiles;        // porovnane dlazdice
+            long long dirtyTiles;   // prepocitane dlazdice
+        };
+
+    private:
+
+        ImageFilter::Type mFilterType;
+        cv::Mat mInput;
+        BufferPool mOutputPool;
+
+        bool mTemporal;
+        double mThreshold;
+        int mRefreshInterval;
+        int mSinceRefresh;
+        cv::Mat mReference;  // vstup, ze ktereho vznikl predchozi vystup
+        cv::Mat mPrevious;   // predchozi vystup
+        cv::Mat mWindow;     // vystup filtrace okna dlazdice
+        std::vector<char> mDirty; // zmenene dlazdice snimku (po radcich)
+        IncrementalGlass mGlass;
+        Statistics mStatistics;
+
+        double mScale;
+        cv::Mat mScaledInput;
+        BufferPool mScaledPool;
+
+    public:
+
+        FrameProcessor();
+
+        void setFilterType(ImageFilter::Type filterType);
+        ImageFilter::Type getFilterType() const;
+
+        void setTemporal(bool enabled);
+        bool isTemporal() const;
+        void setDirtyThreshold(double threshold);
+        double getDirtyThreshold() const;
+        void setRefreshInterval(int frames);
+        void setScale(double scale);
+        double getScale() const;
+        const Statistics& statistics() const;
+        void resetStatistics();
+
+        cv::Mat& input();
+        cv::Mat process();
+
+    private:
+
+        cv::Mat filterFrame(const cv::Mat& source, BufferPool& pool);
+        bool processDirtyTiles(const cv::Mat& source, cv::Mat& output);
+        bool isChanged(const cv::Mat& source, const cv::Rect& rect) const;
+        void invalidate();
+};
+
+#endif	/* FRAMEPROCESSOR_H */
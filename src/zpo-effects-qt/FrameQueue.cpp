@@ -0,0 +1,94 @@
+/*
+ * Soubor: FrameQueue.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "FrameQueue.h"
+
+#include <algorithm>
+
+/**
+ * Konstruktor.
+ *
+ * @param capacity nejvyssi pocet snimku ve fronte (aspon 1)
+ */
+FrameQueue::FrameQueue(size_t capacity)
+    : mFrames(std::max(capacity, (size_t) 1))
+    , mFirst(0)
+    , mCount(0)
+    , mClosed(false)
+{
+}
+
+/**
+ * Vlozeni snimku, pri plne fronte ceka na vybrani.
+ *
+ * @param index poradi snimku
+ * @param image snimek (fronta drzi odkaz, data se nekopiruji)
+ * @return false - fronta je uzavrena
+ */
+bool FrameQueue::push(int index, const cv::Mat& image)
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    mNotFull.wait(lock, [this] { return mClosed || mCount < mFrames.size(); });
+
+    if (mClosed)
+    {
+        return false;
+    }
+
+    Frame& slot = mFrames[(mFirst + mCount) % mFrames.size()];
+    slot.index = index;
+    slot.image = image;
+    mCount++;
+    mNotEmpty.notify_one();
+
+    return true;
+}
+
+/**
+ * Vybrani nejstarsiho snimku, pri prazdne fronte ceka na vlozeni.
+ *
+ * @param frame vystupni snimek
+ * @return false - fronta je uzavrena a prazdna
+ */
+bool FrameQueue::pop(Frame* frame)
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    mNotEmpty.wait(lock, [this] { return mClosed || mCount > 0; });
+
+    if (mCount == 0)
+    {
+        return false;
+    }
+
+    // Misto uz nedrzi odkaz na snimek (buffer muze znovu pouzit zasobnik)
+    Frame& slot = mFrames[mFirst];
+    frame->index = slot.index;
+    frame->image = slot.image;
+    slot.image.release();
+    mFirst = (mFirst + 1) % mFrames.size();
+    mCount--;
+    mNotFull.notify_one();
+
+    return true;
+}
+
+/**
+ * Uzavreni fronty: dalsi vkladani selze, vybirajici vlakna doberou zbyle
+ * snimky a skonci.
+ */
+void FrameQueue::close()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mClosed = true;
+    mNotEmpty.notify_all();
+    mNotFull.notify_all();
+}
@@ -0,0 +1,55 @@
+/*
+ * Soubor: FrameQueue.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef FRAMEQUEUE_H
+#define	FRAMEQUEUE_H
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include <opencv2/core/core.hpp> // cv::Mat
+
+/**
+ * Omezena fronta snimku mezi vlakny zpracovani videa (dekodovani,
+ * filtrace, kodovani). Vkladani ceka na volne misto, takze v pameti je
+ * nejvyse capacity snimku fronty. Mista fronty (kruhovy buffer) se alokuji
+ * jednou v konstruktoru, vkladani ani vybirani nealokuje. Po close se uz
+ * nic nevlozi a vybirani vrati false, jakmile je fronta prazdna.
+ */
+class FrameQueue
+{
+    public:
+
+        struct Frame
+        {
+            int index;                   // poradi snimku ve videu
+            cv::Mat image;
+        };
+
+    private:
+
+        std::mutex mMutex;
+        std::condition_variable mNotEmpty;
+        std::condition_variable mNotFull;
+        std::vector<Frame> mFrames;
+        size_t mFirst;                   // nejstarsi snimek v mFrames
+        size_t mCount;
+        bool mClosed;
+
+    public:
+
+        explicit FrameQueue(size_t capacity);
+
+        bool push(int index, const cv::Mat& image);
+        bool pop(Frame* frame);
+        void close();
+};
+
+#endif	/* FRAMEQUEUE_H */
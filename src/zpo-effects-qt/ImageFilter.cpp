@@ -10,14 +10,272 @@
 #include "ImageFilter.h"
 
 #include <opencv2/imgproc/imgproc.hpp>
+#include "Autotuner.h"
 #include "Debug.h"
-#include "VoronoiPoint.h"
+#include "IncrementalGlass.h"
+#include "KernelDispatch.h"
+#include "PlanarImage.h"
+#include "ScratchArena.h"
+#include "Stencil3x3.h"
+#include "TaskScheduler.h"
+#include "TiledExecutor.h"
 #include <cmath>
 #include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <mutex>
 #include <vector>
 
 using std::vector;
 
+// Nejmensi pocet radku zpracovany jednou ulohou planovace
+static const int ROW_GRAIN = 16;
+
+// Vahy cvtColor CV_BGR2GRAY pro planarni funkce radku (OpenCV 2.4 pocita
+// se 14 bity, novejsi verze s 15 bity)
+#if defined(CV_VERSION_EPOCH) || CV_MAJOR_VERSION < 3
+static const KernelDispatch::GrayWeights GRAY_WEIGHTS = {1868, 9617, 4899, 14};
+#else
+static const KernelDispatch::GrayWeights GRAY_WEIGHTS = {3735, 19235, 9798, 15};
+#endif
+
+// Vypocet velikosti gradientu nastaveny pro aktualni vlakno
+// (-1 - podle ZPO_ARITHMETIC, 0 - float, 1 - celociselny)
+static thread_local int tFixedPoint = -1;
+
+/**
+ * Celociselny vypocet velikosti gradientu (ZPO_ARITHMETIC=fixed, pripadne
+ * setLocalFixedPoint). Vysledek je shodny s vypoctem ve float, ten je ale
+ * rychlejsi (hardwarova odmocnina), proto je vychozi.
+ * 
+ * @return true - pouzit celociselne funkce radku
+ */
+static bool fixedPointArithmetic()
+{
+    static const bool fixed = [] {
+        const char* arithmetic = getenv("ZPO_ARITHMETIC");
+        return arithmetic != nullptr && std::string(arithmetic) == "fixed";
+    }();
+    
+    return tFixedPoint >= 0 ? tFixedPoint != 0 : fixed;
+}
+
+// Pocet typu filtru (Glass je posledni)
+static const int TYPE_COUNT = (int) ImageFilter::Type::Glass + 1;
+
+// Usporadani nastavene pro aktualni vlakno (-1 - podle layoutTable)
+static thread_local int tLayout = -1;
+
+/**
+ * Filtrace obrazu maskou 3x3 po radcich (paralelne). Okrajove radky se
+ * urci podle border, okrajove sloupce resi samotna funkce radku.
+ * 
+ * @param src vstupni obraz
+ * @param dst vystupni obraz (alokovany)
+ * @param stencil funkce filtrace jednoho radku
+ * @param border typ okraje
+ */
+template <typename T>
+static void applyStencil(const cv::Mat& src, cv::Mat& dst,
+                         void (*stencil)(const uchar*, const uchar*, const uchar*, T*, int),
+                         Stencil3x3::Border border)
+{
+    TaskScheduler::instance().parallelFor(0, src.rows, ROW_GRAIN, [&](int begin, int end) {
+        for (int j = begin; j < end; j++)
+        {
+            stencil(src.ptr(Stencil3x3::borderIndex(j - 1, src.rows, border)), src.ptr(j),
+                    src.ptr(Stencil3x3::borderIndex(j + 1, src.rows, border)), dst.ptr<T>(j), src.cols);
+        }
+    });
+}
+
+/**
+ * Pricteni radku sedotonoveho obrazu k histogramu.
+ * 
+ * @param row radek
+ * @param count pocet pixelu
+ * @param hist histogram
+ */
+static void addHistogram(const uchar* row, int count, int hist[256])
+{
+    for (int i = 0; i < count; i++)
+    {
+        hist[row[i]]++;
+    }
+}
+
+/**
+ * Prevodni tabulka ekvalizace histogramu, stejna jako v cv::equalizeHist.
+ * Tabulka se pak pouzije primo ve filtru misto ulozeni ekvalizovaneho obrazu.
+ * 
+ * @param hist histogram obrazu
+ * @param total pocet pixelu obrazu
+ * @param table vystupni prevodni tabulka
+ */
+static void equalizeTable(const int hist[256], int total, uchar table[256])
+{
+    int i = 0;
+    
+    while (i < 255 && hist[i] == 0)
+    {
+        i++;
+    }
+    
+    if (hist[i] == total)
+    {
+        // Jedina hodnota v obraze (nebo prazdny obraz)
+        std::fill(table, table + 256, (uchar) i);
+        return;
+    }
+    
+    float scale = 255.0f / (total - hist[i]);
+    int sum = 0;
+    
+    std::fill(table, table + i + 1, (uchar) 0);
+    
+    for (i++; i < 256; i++)
+    {
+        sum += hist[i];
+        table[i] = cv::saturate_cast<uchar>(sum * scale);
+    }
+}
+
+/**
+ * Ekvalizace histogramu obrazu hran (EdgeGrayFourDirEqu).
+ *
+ * @param edges obraz hran (CV_8UC1)
+ * @param dst vystupni obraz (muze byt edges)
+ */
+static void equalizeEdges(const cv::Mat& edges, cv::Mat& dst)
+{
+    int hist[256] = {0};
+    for (int j = 0; j < edges.rows; j++)
+    {
+        addHistogram(edges.ptr(j), edges.cols, hist);
+    }
+
+    uchar table[256];
+    equalizeTable(hist, edges.rows * edges.cols, table);
+    cv::LUT(edges, cv::Mat(1, 256, CV_8UC1, table), dst);
+}
+
+/**
+ * Funkce radku filtru, ktery je jedinou maskou 3x3 nad sedotonovym obrazem
+ * (u EdgeGrayFourDirEqu maska pred ekvalizaci). Bere se z aktualne
+ * nastavenych funkci radku (KernelDispatch::active, autotuning).
+ *
+ * @param filterType typ filtru
+ * @return funkce radku, nullptr - filtr neni maskou sedotonoveho obrazu
+ */
+static KernelDispatch::StencilU8 grayStencil(ImageFilter::Type filterType)
+{
+    const KernelDispatch::Kernels& kernels = KernelDispatch::active();
+
+    switch (filterType)
+    {
+        case ImageFilter::Type::EdgeGrayLeft:       return kernels.edgeLeft;
+        case ImageFilter::Type::EdgeGrayRight:      return kernels.edgeRight;
+        case ImageFilter::Type::EdgeGrayDown:       return kernels.edgeDown;
+        case ImageFilter::Type::EdgeGrayUp:         return kernels.edgeUp;
+        case ImageFilter::Type::EdgeGrayFourDir:
+        case ImageFilter::Type::EdgeGrayFourDirEqu: return kernels.edgeFourDir;
+        case ImageFilter::Type::SobelGray:
+            return fixedPointArithmetic() ? kernels.prewittMagnitudeFixed : kernels.prewittMagnitude;
+        case ImageFilter::Type::SobelGray2:
+            return fixedPointArithmetic() ? kernels.sobelMagnitudeFixed : kernels.sobelMagnitude;
+        default:
+            return nullptr;
+    }
+}
+
+/**
+ * Rozostreni radku y obrazu maskou 5x5, radky mimo obraz se zrcadli
+ * (REFLECT_101).
+ * 
+ * @param src vstupni obraz
+ * @param y radek obrazu
+ * @param dst vystupni radek
+ * @param blur funkce radku (KernelDispatch::BlurU8)
+ */
+static void blurImageRow(const cv::Mat& src, int y, uchar* dst, KernelDispatch::BlurU8 blur)
+{
+    const uchar* rows[5];
+    for (int k = 0; k < 5; k++)
+    {
+        rows[k] = src.ptr(Stencil3x3::borderIndex(y + k - 2, src.rows, Stencil3x3::REFLECT_101));
+    }
+    
+    blur(rows, dst, src.cols);
+}
+
+/**
+ * Rozostreni radku y obrazu v bufferu pruhu maskou 5x5.
+ * 
+ * @param tile pruh
+ * @param src buffer pruhu se vstupem (platne radky y - 2 az y + 2)
+ * @param y radek obrazu
+ * @param dst vystupni radek
+ * @param blur funkce radku (KernelDispatch::BlurU8)
+ */
+static void blurTileRow(const TiledExecutor::Tile& tile, cv::Mat& src, int y, uchar* dst,
+                        KernelDispatch::BlurU8 blur)
+{
+    const uchar* rows[5];
+    for (int k = 0; k < 5; k++)
+    {
+        rows[k] = tile.row(src, y + k - 2);
+    }
+    
+    blur(rows, dst, tile.cols);
+}
+
+/**
+ * Rozostreni radku [first, last) vsech rovin planarniho bufferu pruhu
+ * maskou 5x5.
+ * 
+ * @param tile pruh
+ * @param src planarni buffer pruhu se vstupem
+ * @param dst planarni buffer pruhu pro vystup
+ * @param blur funkce radku jedne roviny (KernelDispatch::BlurU8)
+ */
+static void blurTilePlanes(const TiledExecutor::Tile& tile, cv::Mat& src, cv::Mat& dst,
+                           KernelDispatch::BlurU8 blur)
+{
+    for (int j = tile.first; j < tile.last; j++)
+    {
+        uchar* srcRows[5][PlanarImage::PLANES];
+        uchar* dstRow[PlanarImage::PLANES];
+        for (int k = 0; k < 5; k++)
+        {
+            tile.planeRow(src, j + k - 2, srcRows[k]);
+        }
+        tile.planeRow(dst, j, dstRow);
+        
+        for (int c = 0; c < PlanarImage::PLANES; c++)
+        {
+            const uchar* rows[5] = {srcRows[0][c], srcRows[1][c], srcRows[2][c],
+                                    srcRows[3][c], srcRows[4][c]};
+            blur(rows, dstRow[c], tile.cols);
+        }
+    }
+}
+
+/**
+ * Prevod radku [first, last) vstupu na planarni buffer pruhu (TILE_SOURCE),
+ * prvni stupen planarnich retezcu.
+ * 
+ * @param src vstupni obraz BGR
+ * @param tile pruh
+ */
+static void splitTile(const cv::Mat& src, const TiledExecutor::Tile& tile)
+{
+    cv::Mat& planes = tile.planes(ScratchArena::TILE_SOURCE);
+    cv::Mat rows[PlanarImage::PLANES];
+    tile.planeRows(planes, tile.first, tile.last, rows);
+    cv::split(src.rowRange(tile.first, tile.last), rows);
+}
+
 /**
  * Filtrace obrazu.
  * 
@@ -27,6 +285,9 @@ using std::vector;
  */
 void ImageFilter::filter(const cv::Mat& src, cv::Mat& dst, ImageFilter::Type filterType)
 {
+    // Nastaveni nalezene autotuningem pro filtr a rozliseni (pokud existuje)
+    Autotuner::Scope tuning(Autotuner::lookup(filterType, src.size()));
+    
     switch (filterType)
     {
         case ImageFilter::Type::NoFilter:           noFilter(src,dst);           break;
@@ -48,6 +309,377 @@ void ImageFilter::filter(const cv::Mat& src, cv::Mat& dst, ImageFilter::Type fil
     }
 }
 
+/**
+ * Filtrace obrazu vice filtry najednou (export vsech filtru). Spolecne
+ * mezivysledky se pocitaji jen jednou: sedotonovy obraz pro vsechny masky
+ * sedotonoveho obrazu a hrany EdgeGrayFourDir, ze kterych se ekvalizaci
+ * odvodi EdgeGrayFourDirEqu. Masky vsech filtru se pocitaji v jedinem
+ * pruchodu po pruzich radku, sedotonove radky se ctou z cache. Ostatni
+ * filtry nemaji s jinymi nic spolecneho (rozmazani SobelColor a Comics se
+ * lisi jadrem) a filtruji se po jednom pres filter(), protoze soubezne
+ * filtry by na jednom vlakne sdilely sloty ScratchArena.
+ * Vysledky jsou shodne s filter() pro jednotlive filtry.
+ *
+ * @param src vstupni obraz
+ * @param filterTypes typy filtru (opakovany filtr sdili vystup)
+ * @param dsts vystupni obrazy v poradi filterTypes
+ */
+void ImageFilter::filterSet(const cv::Mat& src, const std::vector<ImageFilter::Type>& filterTypes,
+                            std::vector<cv::Mat>& dsts)
+{
+    dsts.resize(filterTypes.size());
+
+    // Prvni vystup kazdeho typu filtru
+    int first[TYPE_COUNT];
+    std::fill(first, first + TYPE_COUNT, -1);
+
+    for (int i = 0; i < (int) filterTypes.size(); i++)
+    {
+        if (first[(int) filterTypes[i]] < 0)
+        {
+            first[(int) filterTypes[i]] = i;
+        }
+    }
+
+    int fourDir = first[(int) ImageFilter::Type::EdgeGrayFourDir];
+    int fourDirEqu = first[(int) ImageFilter::Type::EdgeGrayFourDirEqu];
+
+    // Masky sedotonoveho obrazu s funkcemi radku podle autotuningu filtru
+    // (EdgeGrayFourDirEqu jen bez EdgeGrayFourDir, jinak se z nej odvodi)
+    vector<KernelDispatch::StencilU8> stencils;
+    vector<cv::Mat*> stencilDsts;
+
+    for (int type = 0; type < TYPE_COUNT; type++)
+    {
+        if (first[type] < 0 || (type == (int) ImageFilter::Type::EdgeGrayFourDirEqu && fourDir >= 0))
+        {
+            continue;
+        }
+
+        Autotuner::Scope tuning(Autotuner::lookup((ImageFilter::Type) type, src.size()));
+        KernelDispatch::StencilU8 stencil = grayStencil((ImageFilter::Type) type);
+
+        if (stencil != nullptr)
+        {
+            cv::Mat& dst = dsts[first[type]];
+            dst.create(src.rows, src.cols, CV_8UC1);
+            stencils.push_back(stencil);
+            stencilDsts.push_back(&dst);
+        }
+    }
+
+    if (!stencils.empty())
+    {
+        cv::Mat gray(src.size(), CV_8UC1);
+
+        TaskScheduler::instance().parallelFor(0, src.rows, ROW_GRAIN, [&](int begin, int end) {
+            cv::Mat rows = gray.rowRange(begin, end);
+            cvtColor(src.rowRange(begin, end), rows, CV_BGR2GRAY);
+        });
+
+        // Vsechny masky nad pruhem radku, dokud je pruh v cache
+        TaskScheduler::instance().parallelFor(0, src.rows, ROW_GRAIN, [&](int begin, int end) {
+            for (size_t k = 0; k < stencils.size(); k++)
+            {
+                for (int j = begin; j < end; j++)
+                {
+                    stencils[k](gray.ptr(Stencil3x3::borderIndex(j - 1, gray.rows, Stencil3x3::REFLECT_101)),
+                                gray.ptr(j),
+                                gray.ptr(Stencil3x3::borderIndex(j + 1, gray.rows, Stencil3x3::REFLECT_101)),
+                                stencilDsts[k]->ptr(j), gray.cols);
+                }
+            }
+        });
+    }
+
+    if (fourDirEqu >= 0)
+    {
+        equalizeEdges(dsts[fourDir >= 0 ? fourDir : fourDirEqu], dsts[fourDirEqu]);
+    }
+
+    for (int type = 0; type < TYPE_COUNT; type++)
+    {
+        if (first[type] >= 0 && grayStencil((ImageFilter::Type) type) == nullptr)
+        {
+            filter(src, dsts[first[type]], (ImageFilter::Type) type);
+        }
+    }
+
+    for (int i = 0; i < (int) filterTypes.size(); i++)
+    {
+        if (first[(int) filterTypes[i]] != i)
+        {
+            dsts[i] = dsts[first[(int) filterTypes[i]]];
+        }
+    }
+}
+
+/**
+ * Nazev typu filtru pouzivany v prikazove radce a ve vypisech.
+ * 
+ * @param filterType typ filtru
+ * @return nazev filtru
+ */
+const char* ImageFilter::typeName(ImageFilter::Type filterType)
+{
+    switch (filterType)
+    {
+        case ImageFilter::Type::NoFilter:           return "NoFilter";
+        case ImageFilter::Type::EdgeGrayLeft:       return "EdgeGrayLeft";
+        case ImageFilter::Type::EdgeGrayRight:      return "EdgeGrayRight";
+        case ImageFilter::Type::EdgeGrayDown:       return "EdgeGrayDown";
+        case ImageFilter::Type::EdgeGrayUp:         return "EdgeGrayUp";
+        case ImageFilter::Type::EdgeGrayFourDir:    return "EdgeGrayFourDir";
+        case ImageFilter::Type::EdgeGrayFourMax:    return "EdgeGrayFourMax";
+        case ImageFilter::Type::EdgeGrayFourDirEqu: return "EdgeGrayFourDirEqu";
+        case ImageFilter::Type::SobelGray:          return "SobelGray";
+        case ImageFilter::Type::SobelGray2:         return "SobelGray2";
+        case ImageFilter::Type::SobelColor:         return "SobelColor";
+        case ImageFilter::Type::Comics:             return "Comics";
+        case ImageFilter::Type::Glass:              return "Glass";
+        default:                                    return "Unknown";
+    }
+}
+
+/**
+ * Nalezeni typu filtru podle nazvu (bez ohledu na velikost pismen).
+ * 
+ * @param name nazev filtru
+ * @param filterType vystupni parametr s nalezenym typem
+ * @return false - filtr daneho nazvu neexistuje
+ */
+bool ImageFilter::typeFromName(const std::string& name, ImageFilter::Type* filterType)
+{
+    std::string lowerName = name;
+    std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
+    
+    for (ImageFilter::Type type : allTypes())
+    {
+        std::string typeLowerName = typeName(type);
+        std::transform(typeLowerName.begin(), typeLowerName.end(), typeLowerName.begin(), ::tolower);
+        
+        if (typeLowerName == lowerName)
+        {
+            *filterType = type;
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+/**
+ * Seznam vsech typu filtru.
+ * 
+ * @return typy filtru
+ */
+vector<ImageFilter::Type> ImageFilter::allTypes()
+{
+    return {
+        ImageFilter::Type::NoFilter,
+        ImageFilter::Type::EdgeGrayLeft,
+        ImageFilter::Type::EdgeGrayRight,
+        ImageFilter::Type::EdgeGrayDown,
+        ImageFilter::Type::EdgeGrayUp,
+        ImageFilter::Type::EdgeGrayFourDir,
+        ImageFilter::Type::EdgeGrayFourMax,
+        ImageFilter::Type::EdgeGrayFourDirEqu,
+        ImageFilter::Type::SobelGray,
+        ImageFilter::Type::SobelGray2,
+        ImageFilter::Type::SobelColor,
+        ImageFilter::Type::Comics,
+        ImageFilter::Type::Glass,
+    };
+}
+
+/**
+ * Typ vystupniho obrazu filtru (hranove filtry vraci sedotonovy obraz).
+ * 
+ * @param filterType typ filtru
+ * @param srcType typ vstupniho obrazu
+ * @return typ vystupniho obrazu
+ */
+int ImageFilter::outputType(ImageFilter::Type filterType, int srcType)
+{
+    switch (filterType)
+    {
+        case ImageFilter::Type::EdgeGrayLeft:
+        case ImageFilter::Type::EdgeGrayRight:
+        case ImageFilter::Type::EdgeGrayDown:
+        case ImageFilter::Type::EdgeGrayUp:
+        case ImageFilter::Type::EdgeGrayFourDir:
+        case ImageFilter::Type::EdgeGrayFourMax:
+        case ImageFilter::Type::EdgeGrayFourDirEqu:
+        case ImageFilter::Type::SobelGray:
+        case ImageFilter::Type::SobelGray2:
+            return CV_8UC1;
+        default:
+            return srcType;
+    }
+}
+
+/**
+ * Filtry s planarni variantou (barevne mezivysledky).
+ * 
+ * @param filterType typ filtru
+ * @return true - filtr lze prepnout na planarni usporadani
+ */
+bool ImageFilter::hasPlanarLayout(ImageFilter::Type filterType)
+{
+    switch (filterType)
+    {
+        case ImageFilter::Type::EdgeGrayFourMax:
+        case ImageFilter::Type::SobelColor:
+        case ImageFilter::Type::Comics:
+        case ImageFilter::Type::Glass:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Usporadani jednotlivych filtru. Vychozi je prokladane: planarni funkce
+ * radku jsou rychlejsi, ale u samostatneho filtru zisk z velke casti
+ * spotrebuje prevod mezi usporadanimi. ZPO_LAYOUT=planar vychozi hodnotu
+ * zmeni pro vsechny filtry.
+ * 
+ * @return tabulka usporadani podle typu filtru
+ */
+static std::atomic<int>* layoutTable()
+{
+    static std::atomic<int> table[TYPE_COUNT];
+    static bool initialized = [] {
+        const char* forced = getenv("ZPO_LAYOUT");
+        bool planar = forced != nullptr && std::string(forced) == "planar";
+        
+        for (std::atomic<int>& layout : table)
+        {
+            layout = (int) (planar ? ImageFilter::Layout::Planar : ImageFilter::Layout::Interleaved);
+        }
+        return true;
+    }();
+    (void) initialized;
+    
+    return table;
+}
+
+/**
+ * Usporadani barevnych mezivysledku filtru.
+ * 
+ * @param filterType typ filtru
+ * @return usporadani (filtry bez planarni varianty vzdy Interleaved)
+ */
+ImageFilter::Layout ImageFilter::layout(ImageFilter::Type filterType)
+{
+    if (!hasPlanarLayout(filterType))
+    {
+        return ImageFilter::Layout::Interleaved;
+    }
+    
+    if (tLayout >= 0)
+    {
+        return (ImageFilter::Layout) tLayout;
+    }
+    
+    return (ImageFilter::Layout) layoutTable()[(int) filterType].load();
+}
+
+/**
+ * Zmena usporadani barevnych mezivysledku filtru (napr. podle mereni).
+ * 
+ * @param filterType typ filtru
+ * @param layout usporadani
+ */
+void ImageFilter::setLayout(ImageFilter::Type filterType, ImageFilter::Layout layout)
+{
+    layoutTable()[(int) filterType] = (int) layout;
+}
+
+/**
+ * Nastaveni usporadani pro filtry volane z aktualniho vlakna (prednost
+ * pred setLayout), napr. podle vysledku autotuningu.
+ * 
+ * @param layout usporadani (ImageFilter::Layout, -1 - podle setLayout)
+ * @return predchozi nastaveni (pro obnoveni)
+ */
+int ImageFilter::setLocalLayout(int layout)
+{
+    int previous = tLayout;
+    tLayout = std::max(layout, -1);
+    
+    return previous;
+}
+
+/**
+ * Nastaveni vypoctu velikosti gradientu pro filtry volane z aktualniho
+ * vlakna (prednost pred ZPO_ARITHMETIC), napr. pro kontrolu variant.
+ * 
+ * @param fixedPoint 1 - celociselny, 0 - float, -1 - podle ZPO_ARITHMETIC
+ * @return predchozi nastaveni (pro obnoveni)
+ */
+int ImageFilter::setLocalFixedPoint(int fixedPoint)
+{
+    int previous = tFixedPoint;
+    tFixedPoint = std::max(std::min(fixedPoint, 1), -1);
+    
+    return previous;
+}
+
+/**
+ * Nazev usporadani pouzivany v prikazove radce a ve vypisech.
+ * 
+ * @param layout usporadani
+ * @return nazev usporadani
+ */
+const char* ImageFilter::layoutName(ImageFilter::Layout layout)
+{
+    return layout == ImageFilter::Layout::Planar ? "planar" : "interleaved";
+}
+
+/**
+ * Filtry zpracovavane po pruzich radku (TiledExecutor).
+ * 
+ * @param filterType typ filtru
+ * @return true - na filtr ma vliv vyska pruhu
+ */
+bool ImageFilter::isTiled(ImageFilter::Type filterType)
+{
+    return filterType == ImageFilter::Type::SobelColor || filterType == ImageFilter::Type::Comics;
+}
+
+/**
+ * Polomer okoli vstupu, ze ktereho filtr pocita jeden pixel vystupu
+ * (soucet polomeru masek retezce). Vystup vyrezu vzdaleny od jeho okraje
+ * aspon o polomer je pak shodny s vystupem celeho obrazu (FrameProcessor
+ * tak prepocita jen zmenene dlazdice).
+ * 
+ * @param filterType typ filtru
+ * @return polomer, -1 - vystup zavisi na celem obrazu (histogram, okraj
+ *         WRAP, seminka Glass)
+ */
+int ImageFilter::stencilRadius(ImageFilter::Type filterType)
+{
+    switch (filterType)
+    {
+        case ImageFilter::Type::NoFilter:
+            return 0;
+        case ImageFilter::Type::EdgeGrayLeft:
+        case ImageFilter::Type::EdgeGrayRight:
+        case ImageFilter::Type::EdgeGrayDown:
+        case ImageFilter::Type::EdgeGrayUp:
+        case ImageFilter::Type::EdgeGrayFourDir:
+        case ImageFilter::Type::SobelGray:
+        case ImageFilter::Type::SobelGray2:
+            return 1;
+        case ImageFilter::Type::SobelColor:
+            // Rozostreni 5x5, hrany 3x3, rozostreni 5x5
+            return 2 + 1 + 2;
+        default:
+            return -1;
+    }
+}
+
 /**
  * Kopie vstupniho obrazu na vystup.
  * 
@@ -56,7 +688,7 @@ void ImageFilter::filter(const cv::Mat& src, cv::Mat& dst, ImageFilter::Type fil
  */
 void ImageFilter::noFilter(const cv::Mat& src, cv::Mat& dst)
 {
-    dst = src.clone();
+    src.copyTo(dst);
 }
 
 /**
@@ -71,18 +703,12 @@ void ImageFilter::noFilter(const cv::Mat& src, cv::Mat& dst)
  */
 void ImageFilter::edgeGrayLeft(const cv::Mat& src, cv::Mat& dst)
 {
-    cv::Mat src_gray;
+    cv::Mat& src_gray = ScratchArena::local().get(ScratchArena::GRAY, src.size(), CV_8UC1);
 
     cvtColor(src, src_gray, CV_BGR2GRAY);
 
-    float ker[9] = {1, 0, -1, 
-                    2, 0, -2, 
-                    1, 0, -1};
-    
-    cv::Mat kernel(3, 3, CV_32FC1, ker);
-
-    cv::flip(kernel, kernel, -1);
-    cv::filter2D(src_gray, dst, -1, kernel);
+    dst.create(src.rows, src.cols, CV_8UC1);
+    applyStencil(src_gray, dst, KernelDispatch::active().edgeLeft, Stencil3x3::REFLECT_101);
 }
 
 /**
@@ -97,18 +723,12 @@ void ImageFilter::edgeGrayLeft(const cv::Mat& src, cv::Mat& dst)
  */
 void ImageFilter::edgeGrayRight(const cv::Mat& src, cv::Mat& dst)
 {
-    cv::Mat src_gray;
+    cv::Mat& src_gray = ScratchArena::local().get(ScratchArena::GRAY, src.size(), CV_8UC1);
 
     cvtColor(src, src_gray, CV_BGR2GRAY);
 
-    float ker[9] = {-1, 0, 1, 
-                    -2, 0, 2, 
-                    -1, 0, 1};
-    
-    cv::Mat kernel(3, 3, CV_32FC1, ker);
-
-    cv::flip(kernel, kernel, -1);
-    cv::filter2D(src_gray, dst, -1, kernel);
+    dst.create(src.rows, src.cols, CV_8UC1);
+    applyStencil(src_gray, dst, KernelDispatch::active().edgeRight, Stencil3x3::REFLECT_101);
 }
 
 /**
@@ -123,18 +743,12 @@ void ImageFilter::edgeGrayRight(const cv::Mat& src, cv::Mat& dst)
  */
 void ImageFilter::edgeGrayDown(const cv::Mat& src, cv::Mat& dst)
 {
-    cv::Mat src_gray;
+    cv::Mat& src_gray = ScratchArena::local().get(ScratchArena::GRAY, src.size(), CV_8UC1);
 
     cvtColor(src, src_gray, CV_BGR2GRAY);
 
-    float ker[9] = {-1, -2, -1, 
-                     0,  0,  0, 
-                     1,  2,  1};
-    
-    cv::Mat kernel(3, 3, CV_32FC1, ker);
-
-    cv::flip(kernel, kernel, -1);
-    cv::filter2D(src_gray, dst, CV_8UC1, kernel);
+    dst.create(src.rows, src.cols, CV_8UC1);
+    applyStencil(src_gray, dst, KernelDispatch::active().edgeDown, Stencil3x3::REFLECT_101);
 }
 
 /**
@@ -149,18 +763,12 @@ void ImageFilter::edgeGrayDown(const cv::Mat& src, cv::Mat& dst)
  */
 void ImageFilter::edgeGrayUp(const cv::Mat& src, cv::Mat& dst)
 {
-    cv::Mat src_gray;
+    cv::Mat& src_gray = ScratchArena::local().get(ScratchArena::GRAY, src.size(), CV_8UC1);
 
     cvtColor(src, src_gray, CV_BGR2GRAY);
 
-    float ker[9] = { 1,  2,  1, 
-                     0,  0,  0, 
-                    -1, -2, -1};
-    
-    cv::Mat kernel(3, 3, CV_32FC1, ker);
-
-    cv::flip(kernel, kernel, -1);
-    cv::filter2D(src_gray, dst, -1, kernel);
+    dst.create(src.rows, src.cols, CV_8UC1);
+    applyStencil(src_gray, dst, KernelDispatch::active().edgeUp, Stencil3x3::REFLECT_101);
 }
 
 /**
@@ -175,106 +783,66 @@ void ImageFilter::edgeGrayUp(const cv::Mat& src, cv::Mat& dst)
  */
 void ImageFilter::edgeGrayFourDir(const cv::Mat& src, cv::Mat& dst)
 {
-    cv::Mat d1;
-    cv::Mat d2;
-    cv::Mat d3;
-    cv::Mat d4;
-   
-    edgeGrayDown(src, d1);
-    edgeGrayUp(src, d2);
-    edgeGrayRight(src, d3);
-    edgeGrayLeft(src, d4);
-    
-    dst = cv::Mat::zeros(src.rows,src.cols,d2.type());
+    cv::Mat& src_gray = ScratchArena::local().get(ScratchArena::GRAY, src.size(), CV_8UC1);
+
+    cvtColor(src, src_gray, CV_BGR2GRAY);
     
-    for (int i = 0; i < d1.cols; i++)
-    {
-        for (int j = 0; j < d1.rows; j++)
-        {
-            int v = d1.at<uchar>(j,i) + d2.at<uchar>(j,i)  + d3.at<uchar>(j,i) + d4.at<uchar>(j,i);
-            v /= 4;
-            
-            dst.at<uchar>(j,i) = (uchar)v;
-        }
-    }
+    // Ctyri smerove filtry (down, up, right, left) a jejich prumer v jednom
+    // pruchodu, bez ulozeni vysledku jednotlivych filtru
+    dst.create(src.rows, src.cols, CV_8UC1);
+    applyStencil(src_gray, dst, KernelDispatch::active().edgeFourDir, Stencil3x3::REFLECT_101);
 }
 
 /**
- * Emboss filter.
+ * Emboss filter s maskou (okraje obrazu se cykli, k vysledku se pricita 128):
+ * 
+ *      -1, -1,  0
+ *      -1,  0,  1
+ *       0,  1,  1
  * 
  * @param src vstupni obraz
  * @param dst vystupni (filtrovany obraz)
  */
 void ImageFilter::edgeGrayFourMax(const cv::Mat& src, cv::Mat& dst)
 {
-    int kerDim = 3;
-    float ker[3][3] = {-1, -1, 0, 
-                       -1,  0, 1, 
-                        0,  1, 1};
-    
-    cv::Mat kernel(3, 3, CV_32FC1, ker);
-
-    //cv::flip(kernel, kernel, -1);
-    //cv::filter2D(src, dst, CV_8UC1, kernel);
-    int bias = 128;
-    dst = cv::Mat::zeros(src.rows,src.cols,src.type());
-    
-    int red = 0, green = 0, blue =0;
-    for (int i = 0; i < src.cols; i++)
+    if (layout(ImageFilter::Type::EdgeGrayFourMax) == ImageFilter::Layout::Planar)
     {
-        for (int j = 0; j < src.rows; j++)
-        {
-            cv::Vec3b q;
-            red = 0, green = 0, blue =0;
-            for(int x = 0; x < kerDim; x++)
+        // Emboss rovin a prevod na sedotonovy obraz v jedine smycce,
+        // barevny mezivysledek se neuklada
+        cv::Mat& planar = ScratchArena::local().get(ScratchArena::PLANES,
+                                                    PlanarImage::size(src.size()), CV_8UC1);
+        PlanarImage::split(src, planar);
+        dst.create(src.rows, src.cols, CV_8UC1);
+        
+        const KernelDispatch::Kernels& kernels = KernelDispatch::active();
+        
+        TaskScheduler::instance().parallelFor(0, src.rows, ROW_GRAIN, [&](int begin, int end) {
+            for (int j = begin; j < end; j++)
             {
-                for(int y = 0; y < kerDim; y++) 
-                { 
-                    int imgX = (j - kerDim / 2 + x + src.rows) % src.rows; 
-                    int imgY = (i - kerDim / 2 + y + src.cols) % src.cols;
-                    //if( imgX > 500 || imgY > 500)
-                    //std::cout << "x " << imgX << " rx" << src.rows << " y " << imgY << " ry " << src.cols << std::endl;
-                    if(imgX < 0){
-                        imgX = 0;
-                    }
-                    if(imgY < 0){
-                        imgY = 0;
-                    }
-                    if(imgX > src.rows){
-                        imgX = src.rows;
-                    }
-                    if(imgY > src.cols){
-                        imgY = src.cols;
-                    }
-                    q = src.at<cv::Vec3b>(imgX,imgY);
-                    
-                    red += q[2] * ker[x][y]; 
-                    green += q[1] * ker[x][y]; 
-                    blue += q[0] * ker[x][y]; 
-                    //std::cout << "r " << red << " g " << green << std::endl;
-                } 
+                uchar* above[PlanarImage::PLANES];
+                uchar* row[PlanarImage::PLANES];
+                uchar* below[PlanarImage::PLANES];
+                PlanarImage::rows(planar, Stencil3x3::borderIndex(j - 1, src.rows, Stencil3x3::WRAP), above);
+                PlanarImage::rows(planar, j, row);
+                PlanarImage::rows(planar, Stencil3x3::borderIndex(j + 1, src.rows, Stencil3x3::WRAP), below);
+                
+                kernels.embossGrayPlanar(above, row, below, dst.ptr(j), src.cols, GRAY_WEIGHTS);
             }
-            red = std::min(std::max(red + bias,0),255);
-            green = std::min(std::max(green + bias,0),255);
-            blue = std::min(std::max(blue + bias,0),255);
-            
-            
-            
-            q[2] = red; 
-            q[1] = green; 
-            q[0] = blue; 
-            //std::cout << j << std::endl;
-            dst.at<cv::Vec3b>(j,i) = q;
-        }
-    }    
+        });
+        return;
+    }
     
-    cvtColor(dst, dst, CV_BGR2GRAY);
+    cv::Mat& bgr = ScratchArena::local().get(ScratchArena::BGR, src.size(), src.type());
+    
+    applyStencil(src, bgr, KernelDispatch::active().emboss, Stencil3x3::WRAP);
+    
+    cvtColor(bgr, dst, CV_BGR2GRAY);
 }
 
 void ImageFilter::edgeGrayFourDirEqu(const cv::Mat& src, cv::Mat& dst)
 {
     edgeGrayFourDir(src,dst);
-    cv::equalizeHist(dst, dst);
+    equalizeEdges(dst, dst);
 }
 
 /**
@@ -285,51 +853,16 @@ void ImageFilter::edgeGrayFourDirEqu(const cv::Mat& src, cv::Mat& dst)
  */
 void ImageFilter::sobelGray(const cv::Mat& src, cv::Mat& dst)
 {
-    cv::Mat d1 = cv::Mat::zeros(src.rows, src.cols, CV_32FC1);
-    cv::Mat d2 = cv::Mat::zeros(src.rows, src.cols, CV_32FC1);
-    cv::Mat d3 = cv::Mat::zeros(src.rows, src.cols, CV_32FC1);
-    cv::Mat d4 = cv::Mat::zeros(src.rows, src.cols, CV_32FC1);
-    cv::Mat src_gray;
-    float ker1[9] = {-1,  0,  1, 
-                     -1,  0,  1, 
-                     -1,  0,  1};
-    
-    float ker2[9] = {-1, -1, -1, 
-                      0,  0,  0, 
-                      1,  1,  1};
+    cv::Mat& src_gray = ScratchArena::local().get(ScratchArena::GRAY, src.size(), CV_8UC1);
     
     cvtColor(src, src_gray, CV_BGR2GRAY);
     
-    cv::Mat kernel1(3, 3, CV_32FC1, ker1);
-    cv::Mat kernel2(3, 3, CV_32FC1, ker2);
-    
-    cv::flip(kernel1, kernel1, -1);
-    cv::flip(kernel2, kernel2, -1);
-    
-    cv::filter2D(src_gray, d1, CV_32FC1, kernel1);
-    cv::filter2D(src_gray, d2, CV_32FC1, kernel2);
-    
-    dst = cv::Mat::zeros(src.rows, src.cols, CV_8U);
-    
-    for (int j = 0; j < d1.cols; j++)
-    {
-        for (int i = 0; i < d1.rows; i++)
-        {
-            float f1 = d1.at<float>(i,j) * d1.at<float>(i,j);
-            float f2 = d2.at<float>(i,j) * d2.at<float>(i,j);
-            float f3 = d3.at<float>(i,j) * d3.at<float>(i,j);
-            float f4 = d4.at<float>(i,j) * d4.at<float>(i,j);
-            
-            float v = sqrt(f1 + f2 + f3 + f4);
-            
-            if (v > 255)
-            {
-                v = 255;
-            }
-            
-            dst.at<uchar>(i,j) = (uchar)round(v);
-        }
-    }
+    // Oba gradienty a jejich velikost v jednom pruchodu
+    dst.create(src.rows, src.cols, CV_8U);
+    const KernelDispatch::Kernels& kernels = KernelDispatch::active();
+    applyStencil(src_gray, dst,
+                 fixedPointArithmetic() ? kernels.prewittMagnitudeFixed : kernels.prewittMagnitude,
+                 Stencil3x3::REFLECT_101);
 }
 
 /**
@@ -340,53 +873,16 @@ void ImageFilter::sobelGray(const cv::Mat& src, cv::Mat& dst)
  */
 void ImageFilter::sobelGray2(const cv::Mat& src, cv::Mat& dst)
 {
-    cv::Mat d1 = cv::Mat::zeros(src.rows, src.cols, CV_32FC1);
-    cv::Mat d2 = cv::Mat::zeros(src.rows, src.cols, CV_32FC1);
-    cv::Mat d3 = cv::Mat::zeros(src.rows, src.cols, CV_32FC1);
-    cv::Mat d4 = cv::Mat::zeros(src.rows, src.cols, CV_32FC1);
-    
-    cv::Mat src_gray;
-    
-    float ker1[9] = {-1,  0,  1, 
-                     -2,  0,  2, 
-                     -1,  0,  1};
-    
-    float ker2[9] = {-1, -2, -1, 
-                      0,  0,  0, 
-                      1,  2,  1};
+    cv::Mat& src_gray = ScratchArena::local().get(ScratchArena::GRAY, src.size(), CV_8UC1);
     
     cvtColor(src, src_gray, CV_BGR2GRAY);
     
-    cv::Mat kernel1(3, 3, CV_32FC1, ker1);
-    cv::Mat kernel2(3, 3, CV_32FC1, ker2);
-    
-    cv::flip(kernel1, kernel1, -1);
-    cv::flip(kernel2, kernel2, -1);
-    
-    cv::filter2D(src_gray, d1, CV_32FC1, kernel1);
-    cv::filter2D(src_gray, d2, CV_32FC1, kernel2);
-    
-    dst = cv::Mat::zeros(src.rows, src.cols, CV_8U);
-    
-    for (int j = 0; j < d1.cols; j++)
-    {
-        for (int i = 0; i < d1.rows; i++)
-        {
-            float f1 = d1.at<float>(i,j) * d1.at<float>(i,j);
-            float f2 = d2.at<float>(i,j) * d2.at<float>(i,j);
-            float f3 = d3.at<float>(i,j) * d3.at<float>(i,j);
-            float f4 = d4.at<float>(i,j) * d4.at<float>(i,j);
-            
-            float v = sqrt(f1 + f2 + f3 + f4);
-            
-            if (v > 255)
-            {
-                v = 255;
-            }
-            
-            dst.at<uchar>(i,j) = (uchar)round(v);
-        }
-    }
+    // Oba gradienty a jejich velikost v jednom pruchodu
+    dst.create(src.rows, src.cols, CV_8U);
+    const KernelDispatch::Kernels& kernels = KernelDispatch::active();
+    applyStencil(src_gray, dst,
+                 fixedPointArithmetic() ? kernels.sobelMagnitudeFixed : kernels.sobelMagnitude,
+                 Stencil3x3::REFLECT_101);
 }
 
 /**
@@ -398,61 +894,113 @@ void ImageFilter::sobelGray2(const cv::Mat& src, cv::Mat& dst)
  */
 void ImageFilter::sobelColor(const cv::Mat& src, cv::Mat& dst)
 {
-    cv::Mat tmp = src.clone();
-    cv::Mat blur = src.clone();
-    //dst = src.clone();
-    
-    float mean_sum = 25.0;
-    float mean5x5[25] = {
-        1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum,
-        1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum,
-        1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum,
-        1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum,
-        1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum,
-    };
+    dst.create(src.rows, src.cols, src.type());
     
-    cv::Mat meankernel5x5(5, 5, CV_32FC1, mean5x5);
-
-    cv::flip(meankernel5x5, meankernel5x5, -1);
-    cv::filter2D(src, blur, -1, meankernel5x5);
-    //dst = blur.clone();
-    edgeGrayFourDir(blur,tmp);
-    //cv::filter2D(src, dst, -1, meankernel5x5);
+    // Pruhy vystupu se zapisuji drive, nez se precte cely vstup
+    cv::Mat input = src;
+    if (input.data == dst.data)
+    {
+        cv::Mat& copy = ScratchArena::local().get(ScratchArena::BGR, src.size(), src.type());
+        src.copyTo(copy);
+        input = copy;
+    }
     
-    dst = blur.clone();
-                
-    for (int i = 0; i < dst.cols; i++)
+    const KernelDispatch::Kernels& kernels = KernelDispatch::active();
+    
+    // Rozostreni (prumer 5x5) -> sedotonovy obraz -> hrany slozene s barvami
+    // -> rozostreni, po pruzich (mezivysledky jen o velikosti pruhu)
+    if (layout(ImageFilter::Type::SobelColor) == ImageFilter::Layout::Planar)
     {
-        for (int j = 0; j < dst.rows; j++)
-        {
-            cv::Vec3b p = dst.at<cv::Vec3b>(j,i);    
-            if (tmp.at<uchar>(j,i) < 14)
-            {
-                dst.at<cv::Vec3b>(j,i) = {20,20,20};
-            } else {
-                if((p.val[0] + tmp.at<uchar>(j,i)*0.299) < 255){
-                    p.val[0] += tmp.at<uchar>(j,i)*0.299;
-                } else {
-                    p.val[0] = 255;
-                }
-                if((p.val[1] + tmp.at<uchar>(j,i)*0.587) < 255){
-                    p.val[1] += tmp.at<uchar>(j,i)*0.587;
-                } else {
-                    p.val[1] = 255;
+        // Stejny retezec nad rovinami, prevod do rovin a zpet probiha
+        // po pruzich (v cache)
+        // Buffery pruhu (vcetne rovin vstupu) a radky vstupu a vystupu
+        int stripRows = TiledExecutor::stripRows(src.cols, 3 + 3 + 1 + 3 + 3 + 3);
+        
+        TiledExecutor::run(src.size(), stripRows, {
+            {0, [&](const TiledExecutor::Tile& tile) {
+                splitTile(input, tile);
+            }},
+            {2, [&](const TiledExecutor::Tile& tile) {
+                cv::Mat& source = tile.planes(ScratchArena::TILE_SOURCE);
+                cv::Mat& blur = tile.planes(ScratchArena::TILE_BLUR);
+                blurTilePlanes(tile, source, blur, kernels.meanBlurPlanar);
+            }},
+            {0, [&](const TiledExecutor::Tile& tile) {
+                cv::Mat& blur = tile.planes(ScratchArena::TILE_BLUR);
+                cv::Mat& blur_gray = tile.buffer(ScratchArena::TILE_GRAY, CV_8UC1);
+                for (int j = tile.first; j < tile.last; j++)
+                {
+                    uchar* blurRow[PlanarImage::PLANES];
+                    tile.planeRow(blur, j, blurRow);
+                    kernels.grayPlanar(blurRow, tile.row(blur_gray, j), src.cols, GRAY_WEIGHTS);
                 }
-                if((p.val[2] + tmp.at<uchar>(j,i)*0.114) < 255){
-                    p.val[2] += tmp.at<uchar>(j,i)*0.114;
-                } else {
-                    p.val[2] = 255;
+            }},
+            {1, [&](const TiledExecutor::Tile& tile) {
+                cv::Mat& blur = tile.planes(ScratchArena::TILE_BLUR);
+                cv::Mat& blur_gray = tile.buffer(ScratchArena::TILE_GRAY, CV_8UC1);
+                cv::Mat& color = tile.planes(ScratchArena::TILE_COLOR);
+                for (int j = tile.first; j < tile.last; j++)
+                {
+                    uchar* blurRow[PlanarImage::PLANES];
+                    uchar* colorRow[PlanarImage::PLANES];
+                    tile.planeRow(blur, j, blurRow);
+                    tile.planeRow(color, j, colorRow);
+                    kernels.addEdgeColorPlanar(tile.row(blur_gray, j - 1), tile.row(blur_gray, j),
+                                               tile.row(blur_gray, j + 1), blurRow, colorRow,
+                                               src.cols);
                 }
-                
-                dst.at<cv::Vec3b>(j,i) = p;
-            }    
-        }
+            }},
+            {2, [&](const TiledExecutor::Tile& tile) {
+                // Vystup rozostreni do bufferu prvniho rozostreni (uz nepotrebny)
+                cv::Mat& blur = tile.planes(ScratchArena::TILE_BLUR);
+                cv::Mat& color = tile.planes(ScratchArena::TILE_COLOR);
+                blurTilePlanes(tile, color, blur, kernels.meanBlurPlanar);
+                cv::Mat blurRows[PlanarImage::PLANES];
+                tile.planeRows(blur, tile.first, tile.last, blurRows);
+                cv::Mat dstRows = dst.rowRange(tile.first, tile.last);
+                cv::merge(blurRows, PlanarImage::PLANES, dstRows);
+            }},
+        });
+        return;
     }
     
-    cv::filter2D(dst, blur, -1, meankernel5x5);
-    dst = blur.clone();
+    // Buffery pruhu a radky vstupu a vystupu
+    int stripRows = TiledExecutor::stripRows(src.cols, 3 + 1 + 3 + 3 + 3);
+    
+    TiledExecutor::run(src.size(), stripRows, {
+        {2, [&](const TiledExecutor::Tile& tile) {
+            cv::Mat& blur = tile.buffer(ScratchArena::TILE_BLUR, src.type());
+            for (int j = tile.first; j < tile.last; j++)
+            {
+                blurImageRow(input, j, tile.row(blur, j), kernels.meanBlur);
+            }
+        }},
+        {0, [&](const TiledExecutor::Tile& tile) {
+            cv::Mat& blur = tile.buffer(ScratchArena::TILE_BLUR, src.type());
+            cv::Mat& blur_gray = tile.buffer(ScratchArena::TILE_GRAY, CV_8UC1);
+            cv::Mat grayRows = tile.rows(blur_gray, tile.first, tile.last);
+            cvtColor(tile.rows(blur, tile.first, tile.last), grayRows, CV_BGR2GRAY);
+        }},
+        {1, [&](const TiledExecutor::Tile& tile) {
+            cv::Mat& blur = tile.buffer(ScratchArena::TILE_BLUR, src.type());
+            cv::Mat& blur_gray = tile.buffer(ScratchArena::TILE_GRAY, CV_8UC1);
+            cv::Mat& color = tile.buffer(ScratchArena::TILE_COLOR, src.type());
+            for (int j = tile.first; j < tile.last; j++)
+            {
+                kernels.addEdgeColor(tile.row(blur_gray, j - 1), tile.row(blur_gray, j),
+                                     tile.row(blur_gray, j + 1), tile.row(blur, j),
+                                     tile.row(color, j), src.cols);
+            }
+        }},
+        {2, [&](const TiledExecutor::Tile& tile) {
+            // Rozostreni primo do vystupu
+            cv::Mat& color = tile.buffer(ScratchArena::TILE_COLOR, src.type());
+            for (int j = tile.first; j < tile.last; j++)
+            {
+                blurTileRow(tile, color, j, dst.ptr(j), kernels.meanBlur);
+            }
+        }},
+    });
 }
 
 /**
@@ -463,70 +1011,139 @@ void ImageFilter::sobelColor(const cv::Mat& src, cv::Mat& dst)
  */
 void ImageFilter::comics(const cv::Mat& src, cv::Mat& dst)
 {
-    cv::Mat tmp = dst.clone();
-    cv::Mat blur = dst.clone();
-    dst = src.clone();
+    bool planar = layout(ImageFilter::Type::Comics) == ImageFilter::Layout::Planar;
+    
+    ScratchArena& arena = ScratchArena::local();
+    cv::Mat& tmp = arena.get(ScratchArena::TMP, src.size(), CV_8UC1);
+    cv::Mat& blur = planar ? arena.get(ScratchArena::BLUR, PlanarImage::size(src.size()), CV_8UC1)
+                           : arena.get(ScratchArena::BLUR, src.size(), src.type());
+    dst.create(src.rows, src.cols, src.type());
     float ker[9] = {
         1.0/16.0, 1.5/8.0, 1.0/16.0,
         1.5/8.0, 0.0, 1.5/8.0,
         1.0/16.0, 1.5/8.0, 1.0/16.0,
     };
     
-    //rozostrovaci filtry
-    float gaussian_sum = 52.0;
-    float ker5x5[25] = {
-        1.0f/gaussian_sum, 1.0f/gaussian_sum, 2.0f/gaussian_sum, 1.0f/gaussian_sum, 1.0f/gaussian_sum,
-        1.0f/gaussian_sum, 2.0f/gaussian_sum, 4.0f/gaussian_sum, 2.0f/gaussian_sum, 1.0f/gaussian_sum,
-        2.0f/gaussian_sum, 4.0f/gaussian_sum, 8.0f/gaussian_sum, 4.0f/gaussian_sum, 2.0f/gaussian_sum,
-        1.0f/gaussian_sum, 2.0f/gaussian_sum, 4.0f/gaussian_sum, 2.0f/gaussian_sum, 1.0f/gaussian_sum,
-        1.0f/gaussian_sum, 1.0f/gaussian_sum, 2.0f/gaussian_sum, 1.0f/gaussian_sum, 1.0f/gaussian_sum,
-    };
-    
-    float mean_sum = 25.0;
-    float mean5x5[25] = {
-        1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum,
-        1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum,
-        1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum,
-        1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum,
-        1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum,
-    };
-    
     cv::Mat kernel(3, 3, CV_32FC1, ker);
-    cv::Mat kernel5x5(5, 5, CV_32FC1, ker5x5);
-    cv::Mat meankernel5x5(5, 5, CV_32FC1, mean5x5);
 
     cv::flip(kernel, kernel, -1);
-    cv::flip(kernel5x5, kernel5x5, -1);
-    cv::flip(meankernel5x5, meankernel5x5, -1);
-    cv::filter2D(src, blur, -1, kernel5x5);
     
-    edgeGrayFourDirEqu(blur,tmp);
+    const KernelDispatch::Kernels& kernels = KernelDispatch::active();
+    int hist[256] = {0};
+    std::mutex histMutex;
+    
+    // Rozostreni (gauss 5x5, vahy / 52) -> sedotonovy obraz -> hrany
+    // (edgeGrayFourDir) po pruzich. Ekvalizace potrebuje histogram celeho
+    // obrazu, proto retezec konci ulozenim rozostreneho obrazu a hran;
+    // histogram se pocita prubezne. Planarni retezec navic zacina prevodem
+    // vstupu do rovin.
+    auto edges = [&](const TiledExecutor::Tile& tile) {
+        cv::Mat& blur_gray = tile.buffer(ScratchArena::TILE_GRAY, CV_8UC1);
+        int stripHist[256] = {0};
+        for (int j = tile.first; j < tile.last; j++)
+        {
+            kernels.edgeFourDir(tile.row(blur_gray, j - 1), tile.row(blur_gray, j),
+                                tile.row(blur_gray, j + 1), tmp.ptr(j), src.cols);
+            addHistogram(tmp.ptr(j), src.cols, stripHist);
+        }
+        {
+            // Pruhy bezi paralelne
+            std::lock_guard<std::mutex> lock(histMutex);
+            for (int i = 0; i < 256; i++)
+            {
+                hist[i] += stripHist[i];
+            }
+        }
+        if (planar)
+        {
+            cv::Mat& blur_strip = tile.planes(ScratchArena::TILE_BLUR);
+            cv::Mat stripPlanes[PlanarImage::PLANES];
+            cv::Mat blurRows[PlanarImage::PLANES];
+            tile.planeRows(blur_strip, tile.first, tile.last, stripPlanes);
+            PlanarImage::planes(blur, tile.first, tile.last, blurRows);
+            for (int c = 0; c < PlanarImage::PLANES; c++)
+            {
+                stripPlanes[c].copyTo(blurRows[c]);
+            }
+        }
+        else
+        {
+            cv::Mat& blur_strip = tile.buffer(ScratchArena::TILE_BLUR, src.type());
+            cv::Mat blurRows = blur.rowRange(tile.first, tile.last);
+            tile.rows(blur_strip, tile.first, tile.last).copyTo(blurRows);
+        }
+    };
+    
+    // Buffery pruhu (planarni navic roviny vstupu) a radky vstupu a vystupu
+    int stripRows = TiledExecutor::stripRows(src.cols, 3 + 3 + 1 + 3 + 1 + (planar ? 3 : 0));
+    
+    if (planar)
+    {
+        TiledExecutor::run(src.size(), stripRows, {
+            {0, [&](const TiledExecutor::Tile& tile) {
+                splitTile(src, tile);
+            }},
+            {2, [&](const TiledExecutor::Tile& tile) {
+                cv::Mat& source = tile.planes(ScratchArena::TILE_SOURCE);
+                cv::Mat& blur_strip = tile.planes(ScratchArena::TILE_BLUR);
+                blurTilePlanes(tile, source, blur_strip, kernels.gaussianBlurPlanar);
+            }},
+            {0, [&](const TiledExecutor::Tile& tile) {
+                cv::Mat& blur_strip = tile.planes(ScratchArena::TILE_BLUR);
+                cv::Mat& blur_gray = tile.buffer(ScratchArena::TILE_GRAY, CV_8UC1);
+                for (int j = tile.first; j < tile.last; j++)
+                {
+                    uchar* blurRow[PlanarImage::PLANES];
+                    tile.planeRow(blur_strip, j, blurRow);
+                    kernels.grayPlanar(blurRow, tile.row(blur_gray, j), src.cols, GRAY_WEIGHTS);
+                }
+            }},
+            {1, edges},
+        });
+    }
+    else
+    {
+        TiledExecutor::run(src.size(), stripRows, {
+            {2, [&](const TiledExecutor::Tile& tile) {
+                cv::Mat& blur_strip = tile.buffer(ScratchArena::TILE_BLUR, src.type());
+                for (int j = tile.first; j < tile.last; j++)
+                {
+                    blurImageRow(src, j, tile.row(blur_strip, j), kernels.gaussianBlur);
+                }
+            }},
+            {0, [&](const TiledExecutor::Tile& tile) {
+                cv::Mat& blur_strip = tile.buffer(ScratchArena::TILE_BLUR, src.type());
+                cv::Mat& blur_gray = tile.buffer(ScratchArena::TILE_GRAY, CV_8UC1);
+                cv::Mat grayRows = tile.rows(blur_gray, tile.first, tile.last);
+                cvtColor(tile.rows(blur_strip, tile.first, tile.last), grayRows, CV_BGR2GRAY);
+            }},
+            {1, edges},
+        });
+    }
+    
+    // edgeGrayFourDirEqu, ekvalizace se ale provede az pri prahovani
+    // (prevodni tabulkou), ekvalizovany obraz se neuklada
+    uchar table[256];
+    equalizeTable(hist, src.rows * src.cols, table);
     int d = 30;
 //    int d = 125;
 
-    for (int i = 0; i < dst.cols; i++)
-    {
-        for (int j = 0; j < dst.rows; j++)
+    // Planarni varianta zapisuje rovnou prokladany vystup (prevod zpet)
+    TaskScheduler::instance().parallelFor(0, dst.rows, ROW_GRAIN, [&](int begin, int end) {
+        for (int j = begin; j < end; j++)
         {
-            cv::Vec3b p = blur.at<cv::Vec3b>(j, i);
-            cv::Vec3b q;
-
-            if (tmp.at<uchar>(j, i) > 220)
+            if (planar)
             {
-                q.val[0] = d;
-                q.val[1] = d;
-                q.val[2] = d;
+                uchar* blurRow[PlanarImage::PLANES];
+                PlanarImage::rows(blur, j, blurRow);
+                kernels.replaceEdgesPlanar(blurRow, tmp.ptr(j), table, dst.ptr(j), dst.cols, 220, d);
             }
             else
             {
-                q.val[0] = p.val[0];
-                q.val[1] = p.val[1];
-                q.val[2] = p.val[2];
+                kernels.replaceEdges(blur.ptr(j), tmp.ptr(j), table, dst.ptr(j), dst.cols, 220, d);
             }
-                
-            dst.at<cv::Vec3b>(j,i) = q;
         }
-    }
+    });
     
     //cv::filter2D(dst, dst, -1, kernel);
 }
@@ -539,93 +1156,186 @@ void ImageFilter::comics(const cv::Mat& src, cv::Mat& dst)
  */
 void ImageFilter::glass(const cv::Mat& src, cv::Mat& dst)
 {
-    dst = src.clone();
     int region_size = 10;
 
-    int sumR, sumG, sumB;
-    int vx, vy, nearest;
-    VoronoiPoint* vp;
-    VoronoiPoint* nearestVP = nullptr;
-    Pixel* pixel;
+    // Seminko ma kazda cela bunka mrizky krome posledniho sloupce/radku bunek
+    int cellCols = src.cols > region_size ? (src.cols - region_size - 1) / region_size + 1 : 0;
+    int cellRows = src.rows > region_size ? (src.rows - region_size - 1) / region_size + 1 : 0;
+    int seedCount = cellCols * cellRows;
 
-    vector<VoronoiPoint*> voronoiPoints;
-
-    for (int i = 0; i + region_size < src.cols; i = i + region_size)
+    if (seedCount == 0)
     {
-        for (int j = 0; j + region_size < src.rows; j = j + region_size)
+        // Obrazek mensi nez bunka nema zadny region
+        src.copyTo(dst);
+        return;
+    }
+
+    ScratchArena& arena = ScratchArena::local();
+    cv::Mat& seeds = arena.get(ScratchArena::SEEDS, cv::Size(seedCount, 2), CV_32SC1);
+    cv::Mat& regions = arena.get(ScratchArena::REGIONS, cv::Size(seedCount, 4), CV_32SC1);
+    cv::Mat& labels = arena.get(ScratchArena::LABELS, src.size(), CV_32SC1);
+    
+    int* seedX = seeds.ptr<int>(0);
+    int* seedY = seeds.ptr<int>(1);
+
+    TaskScheduler& scheduler = TaskScheduler::instance();
+
+    // Prumerny jas bunek (paralelne), docasne ulozeny v seedX
+    scheduler.parallelFor(0, cellCols, 1, [&](int begin, int end) {
+        for (int cx = begin; cx < end; cx++)
         {
-            //vypocet seeds
-            //std::cout << "test jk" << << std::endl;
-            sumR = 0;
-            sumG = 0;
-            sumB = 0;
-            for (int k = i; k < (i + region_size); k++)
+            for (int cy = 0; cy < cellRows; cy++)
             {
+                int i = cx * region_size;
+                int j = cy * region_size;
+                int sumR = 0;
+                int sumG = 0;
+                int sumB = 0;
                 for (int l = j; l < (j + region_size); l++)
                 {
-                    cv::Vec3b p = src.at<cv::Vec3b>(l, k);
-                    sumR += p.val[2];
-                    sumG += p.val[1];
-                    sumB += p.val[0];
+                    const cv::Vec3b* row = src.ptr<cv::Vec3b>(l);
+                    for (int k = i; k < (i + region_size); k++)
+                    {
+                        sumR += row[k].val[2];
+                        sumG += row[k].val[1];
+                        sumB += row[k].val[0];
+                    }
                 }
+
+                seedX[cx * cellRows + cy] = (sumR + sumG + sumB) / 3;
             }
+        }
+    });
+
+    // Posuny seminek z tabulky (stejne hodnoty jako srand/rand, ale bez
+    // globalniho stavu, filtr tak muze bezet soucasne ve vice vlaknech)
+    for (int cx = 0; cx < cellCols; cx++)
+    {
+        for (int cy = 0; cy < cellRows; cy++)
+        {
+            //vypocet seeds
+            int index = cx * cellRows + cy;
+            int dx;
+            int dy;
+            IncrementalGlass::seedOffset(seedX[index], &dx, &dy);
+            seedX[index] = dx + cx * region_size;
+            seedY[index] = dy + cy * region_size;
+        }
+    }
 
-            srand((sumR + sumG + sumB) / 3);
-            vx = rand() % region_size + i;
-            vy = rand() % region_size + j;
-            vp = new VoronoiPoint(vx, vy);
+    const KernelDispatch::Kernels& kernels = KernelDispatch::active();
 
-            voronoiPoints.push_back(vp);
+    // Prirazeni pixelu nejblizsimu seminku (pri shode vyhrava seminko
+    // s nizsim indexem)
+    scheduler.parallelFor(0, src.rows, ROW_GRAIN, [&](int begin, int end) {
+        cv::Mat& distances = ScratchArena::local().get(ScratchArena::DISTANCES,
+                                                       cv::Size(src.cols, 1), CV_32SC1);
+        for (int j = begin; j < end; j++)
+        {
+            kernels.nearestSeed(seedX, seedY, seedCount, j, labels.ptr<int>(j),
+                                distances.ptr<int>(0), src.cols);
         }
+    });
+
+    // Soucty barev regionu po kanalech (radky regions: B, G, R, pocet
+    // pixelu). Kazdy kanal scita samostatna uloha do vlastniho radku,
+    // v planarnim usporadani cte jen svou rovinu.
+    regions.setTo(cv::Scalar::all(0));
+    int* counts = regions.ptr<int>(3);
+
+    bool planar = layout(ImageFilter::Type::Glass) == ImageFilter::Layout::Planar;
+    cv::Mat planes;
+    if (planar)
+    {
+        planes = arena.get(ScratchArena::PLANES, PlanarImage::size(src.size()), CV_8UC1);
+        PlanarImage::split(src, planes);
     }
 
-    for (int i = 0; i < src.cols; i++)
     {
-        for (int j = 0; j < src.rows; j++)
+        TaskGroup group;
+
+        for (int c = 0; c < 3; c++)
         {
-            nearest = src.cols + src.rows;
-            
-            //pixel ziska nejlepsi hodnoceni
-            for (size_t itp = 0; itp != voronoiPoints.size(); itp++)
+            group.run([&, c]() {
+                int* sums = regions.ptr<int>(c);
+                
+                for (int j = 0; j < src.rows; j++)
+                {
+                    const int* labelRow = labels.ptr<int>(j);
+                    
+                    if (planar)
+                    {
+                        const uchar* planeRow = planes.ptr(c * src.rows + j);
+                        
+                        for (int i = 0; i < src.cols; i++)
+                        {
+                            sums[labelRow[i]] += planeRow[i];
+                        }
+                    }
+                    else
+                    {
+                        const cv::Vec3b* srcRow = src.ptr<cv::Vec3b>(j);
+                        
+                        for (int i = 0; i < src.cols; i++)
+                        {
+                            sums[labelRow[i]] += srcRow[i].val[c];
+                        }
+                    }
+                }
+            });
+        }
+
+        group.run([&]() {
+            for (int j = 0; j < src.rows; j++)
             {
-                vp = voronoiPoints[itp];
+                const int* labelRow = labels.ptr<int>(j);
+                
+                for (int i = 0; i < src.cols; i++)
+                {
+                    counts[labelRow[i]]++;
+                }
+            }
+        });
 
-                int dist = abs(vp->getX() - i) + abs(vp->getY() - j);
+        group.wait();
+    }
 
-                if (nearest > dist)
+    // Prumerne barvy regionu
+    scheduler.parallelFor(0, seedCount, 256, [&](int begin, int end) {
+        for (int c = 0; c < 3; c++)
+        {
+            int* sums = regions.ptr<int>(c);
+            
+            for (int s = begin; s < end; s++)
+            {
+                if (counts[s] > 0)
                 {
-                    nearest = dist;
-                    nearestVP = vp;
+                    sums[s] = std::min(sums[s] / counts[s], 255);
                 }
             }
-            
-            cv::Vec3b p = src.at<cv::Vec3b>(j, i);
-            nearestVP->AddPixel(new Pixel(i, j), (int) p.val[2], (int) p.val[1], (int) p.val[0]);
         }
-    }
-
-    for (size_t it = 0; it != voronoiPoints.size(); it++)
-    {
-        vp = voronoiPoints[it];
-        vp->CalculateAverages();
-
-        std::vector<Pixel *> pixels = vp->getPixels();
+    });
+    
+    const int* regionB = regions.ptr<int>(0);
+    const int* regionG = regions.ptr<int>(1);
+    const int* regionR = regions.ptr<int>(2);
+    
+    dst.create(src.rows, src.cols, src.type());
 
-        for (size_t itp = 0; itp != pixels.size(); itp++)
+    scheduler.parallelFor(0, src.rows, ROW_GRAIN, [&](int begin, int end) {
+        for (int j = begin; j < end; j++)
         {
-            pixel = pixels[itp];
-            cv::Vec3b q;
-
-            q.val[2] = vp->getR(); //R
-            q.val[1] = vp->getG(); //G
-            q.val[0] = vp->getB(); //B
-
-            dst.at<cv::Vec3b>(pixel->getY(), pixel->getX()) = q;
+            const int* labelRow = labels.ptr<int>(j);
+            cv::Vec3b* dstRow = dst.ptr<cv::Vec3b>(j);
+            
+            for (int i = 0; i < src.cols; i++)
+            {
+                int s = labelRow[i];
+                
+                dstRow[i].val[0] = regionB[s];
+                dstRow[i].val[1] = regionG[s];
+                dstRow[i].val[2] = regionR[s];
+            }
         }
-    }
-    
-    for (VoronoiPoint* vp : voronoiPoints)
-    {
-        delete vp;
-    }
+    });
 }
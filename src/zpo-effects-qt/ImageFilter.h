@@ -10,6 +10,9 @@
 #ifndef IMAGEFILTER_H
 #define	IMAGEFILTER_H
 
+#include <string>
+#include <vector>
+
 #include <opencv2/core/core.hpp> // cv::Mat
 #include <QMetaType> // Q_DECLARE_METATYPE
 
@@ -36,8 +39,31 @@ class ImageFilter
             Comics,
             Glass,
         };
+        
+        // Usporadani barevnych mezivysledku filtru (PlanarImage.h)
+        enum class Layout
+        {
+            Interleaved,
+            Planar,
+        };
 
         static void filter(const cv::Mat& src, cv::Mat& dst, ImageFilter::Type filterType);
+        static void filterSet(const cv::Mat& src, const std::vector<ImageFilter::Type>& filterTypes,
+                              std::vector<cv::Mat>& dsts);
+        
+        static const char* typeName(ImageFilter::Type filterType);
+        static bool typeFromName(const std::string& name, ImageFilter::Type* filterType);
+        static std::vector<ImageFilter::Type> allTypes();
+        static int outputType(ImageFilter::Type filterType, int srcType);
+        
+        static bool hasPlanarLayout(ImageFilter::Type filterType);
+        static ImageFilter::Layout layout(ImageFilter::Type filterType);
+        static void setLayout(ImageFilter::Type filterType, ImageFilter::Layout layout);
+        static int setLocalLayout(int layout);
+        static const char* layoutName(ImageFilter::Layout layout);
+        static bool isTiled(ImageFilter::Type filterType);
+        static int stencilRadius(ImageFilter::Type filterType);
+        static int setLocalFixedPoint(int fixedPoint);
         
         static void noFilter(const cv::Mat& src, cv::Mat& dst);
         
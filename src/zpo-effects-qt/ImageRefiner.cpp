@@ -0,0 +1,125 @@
+/*
+ * Soubor: ImageRefiner.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "ImageRefiner.h"
+
+#include "TaskScheduler.h"
+#include "ViewportFilter.h"
+
+ImageRefiner::ImageRefiner()
+    : mFilterType(ImageFilter::Type::NoFilter)
+    , mGeneration(0)
+    , mPending(false)
+    , mCancel(false)
+{
+    mThread = new QThread(this);
+    this->moveToThread(mThread);
+
+    mThread->start();
+}
+
+ImageRefiner::~ImageRefiner()
+{
+    cancel();
+
+    mThread->quit();
+    mThread->wait();
+}
+
+/**
+ * Zadani filtrace obrazku. Predchozi uloha se zrusi.
+ *
+ * @param image obrazek
+ * @param filterType typ filtru
+ * @param roi oblast obrazku (prazdna - cely obrazek)
+ * @param target cilova velikost oblasti (prazdna - plne rozliseni)
+ * @return cislo ulohy (signal refined)
+ */
+int ImageRefiner::start(cv::Mat image, ImageFilter::Type filterType, cv::Rect roi, cv::Size target)
+{
+    int generation;
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        mCancel = true;
+        mImage = image;
+        mFilterType = filterType;
+        mRoi = roi;
+        mTarget = target;
+        mPending = true;
+        generation = ++mGeneration;
+    }
+
+    QMetaObject::invokeMethod(this, "run", Qt::QueuedConnection);
+
+    return generation;
+}
+
+/**
+ * Zruseni cekajici i rozpracovane ulohy.
+ */
+void ImageRefiner::cancel()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mCancel = true;
+    mImage.release();
+    mPending = false;
+}
+
+/**
+ * Filtrace posledni zadane ulohy (ve vlakne mThread). Vysledek zrusene
+ * ulohy se neemituje.
+ */
+void ImageRefiner::run()
+{
+    cv::Mat image;
+    ImageFilter::Type filterType;
+    cv::Rect roi;
+    cv::Size target;
+    int generation;
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        // Uloha uz byla zpracovana (pozdejsi start) nebo zrusena
+        if (!mPending)
+        {
+            return;
+        }
+
+        std::swap(image, mImage);
+        filterType = mFilterType;
+        roi = mRoi;
+        target = mTarget;
+        generation = mGeneration;
+        mPending = false;
+        mCancel = false;
+    }
+
+    cv::Mat filteredImage;
+    const std::atomic<bool>* previous = TaskScheduler::setLocalCancel(&mCancel);
+
+    try
+    {
+        ViewportFilter::filter(image, filteredImage, filterType, roi, target);
+    }
+    catch (const TaskScheduler::Cancelled&)
+    {
+        filteredImage.release();
+    }
+
+    TaskScheduler::setLocalCancel(previous);
+
+    if (!filteredImage.empty() && !mCancel)
+    {
+        emit refined(filteredImage, generation);
+    }
+}
@@ -0,0 +1,66 @@
+/*
+ * Soubor: ImageRefiner.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef IMAGEREFINER_H
+#define	IMAGEREFINER_H
+
+#include <atomic>
+#include <mutex>
+
+#include <QObject>
+#include <QThread>
+
+#include <opencv2/core/core.hpp> // cv::Mat
+
+#include "ImageFilter.h"
+
+/**
+ * Filtrace obrazku (nebo zobrazene oblasti v rozliseni zobrazeni,
+ * ViewportFilter.h) ve vlastnim vlakne, zatimco ImageSource zobrazuje
+ * nahled ze zmenseneho obrazku. Zpracovava se vzdy jen posledni zadana
+ * uloha; nova uloha (nebo cancel) zrusi rozpracovanou filtraci priznakem
+ * TaskScheduler::setLocalCancel, filtr tak skonci po dokonceni
+ * rozpracovanych casti parallelFor.
+ */
+class ImageRefiner : public QObject
+{
+    Q_OBJECT
+
+    private:
+
+        QThread* mThread;
+
+        std::mutex mMutex;
+        cv::Mat mImage;                 // obrazek cekajici ulohy
+        ImageFilter::Type mFilterType;
+        cv::Rect mRoi;
+        cv::Size mTarget;
+        int mGeneration;                // cislo posledni zadane ulohy
+        bool mPending;
+        std::atomic<bool> mCancel;      // zruseni rozpracovane ulohy
+
+    public:
+
+        ImageRefiner();
+        virtual ~ImageRefiner();
+
+        int start(cv::Mat image, ImageFilter::Type filterType,
+                  cv::Rect roi = cv::Rect(), cv::Size target = cv::Size());
+        void cancel();
+
+    signals:
+
+        void refined(cv::Mat image, int generation);
+
+    private slots:
+
+        void run();
+};
+
+#endif	/* IMAGEREFINER_H */
@@ -9,20 +9,30 @@
 
 #include "ImageSource.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include <QString>
 
 #include "ImageFilter.h"
+#include "MemoryTracker.h"
+#include "ViewportFilter.h"
 #include "Debug.h"
 
 ImageSource::ImageSource()
     : mActiveSourceType(SourceType::NOTHING)
     , mFilterType(ImageFilter::Type::NoFilter)
+    , mProxyScale(1.0)
+    , mRefineGeneration(0)
     , mCapture(new cv::VideoCapture())
+    , mStatisticsEnabled(false)
+    , mStatisticsStart(0)
 {
     mThread = new QThread(this);
     this->moveToThread(mThread);
     
     initTimers();
+    connect(&mRefiner, SIGNAL(refined(cv::Mat,int)), this, SLOT(imageRefined(cv::Mat,int)));
     
     mThread->start();
 }
@@ -34,6 +44,7 @@ ImageSource::~ImageSource()
 
     delete mVideoTimer;
     delete mCameraTimer;
+    delete mShmTimer;
 
     delete mCapture;
 }
@@ -46,6 +57,7 @@ ImageSource::~ImageSource()
 void ImageSource::setFilterType(ImageFilter::Type filterType)
 {
     mFilterType = filterType;
+    mFrameProcessor.setFilterType(filterType);
     
     if (mActiveSourceType == SourceType::IMAGE)
     {
@@ -53,6 +65,17 @@ void ImageSource::setFilterType(ImageFilter::Type filterType)
     }
 }
 
+/**
+ * Zapnuti/vypnuti mereni casu a alokaci pri filtraci. Pri zapnutem mereni
+ * se po kazde filtraci emituje signal filterStatistics.
+ * 
+ * @param enabled true - merit
+ */
+void ImageSource::setStatisticsEnabled(bool enabled)
+{
+    mStatisticsEnabled = enabled;
+}
+
 /**
  * Inicializace casovacu pro zobrazeni videa a kamery.
  */
@@ -72,6 +95,11 @@ void ImageSource::initTimers()
     mCameraTimer->setTimerType(Qt::PreciseTimer);
     mCameraTimer->moveToThread(mThread);
     connect(mCameraTimer, SIGNAL(timeout()), this, SLOT(newCameraFrame()));
+    
+    mShmTimer = new QTimer(0);
+    mShmTimer->setTimerType(Qt::PreciseTimer);
+    mShmTimer->moveToThread(mThread);
+    connect(mShmTimer, SIGNAL(timeout()), this, SLOT(newSharedMemoryFrame()));
 }
 
 /**
@@ -91,7 +119,8 @@ int ImageSource::getVideoCaptureTimerInterval()
 }
 
 /**
- * Nastaveni obrazku k filtraci.
+ * Nastaveni obrazku k filtraci. Obrazek vetsi nez PROXY_PIXELS se jednou
+ * zmensi pro nahledy vsech filtru.
  * 
  * @param image obrazek
  */
@@ -100,7 +129,21 @@ void ImageSource::setImage(cv::Mat image)
     mActiveSourceType = SourceType::IMAGE;
     mVideoTimer->stop();
     mCameraTimer->stop();
+    mShmTimer->stop();
+    resetQuality();
     mImage = image;
+    
+    if ((double) image.total() > PROXY_PIXELS)
+    {
+        mProxyScale = std::sqrt((double) PROXY_PIXELS / image.total());
+        cv::resize(image, mProxy, cv::Size(), mProxyScale, mProxyScale, cv::INTER_AREA);
+    }
+    else
+    {
+        mProxyScale = 1.0;
+        mProxy.release();
+    }
+    
     filterImage();
 }
 
@@ -130,6 +173,20 @@ void ImageSource::setCamera()
     }
 }
 
+/**
+ * Nastaveni snimku ze sdilene pameti (ShmRing.h).
+ * 
+ * @param input nazev vstupniho bufferu
+ * @param output nazev vystupniho bufferu (prazdny - bez vystupu)
+ */
+void ImageSource::setSharedMemory(std::string input, std::string output)
+{
+    if (!setSharedMemoryRaw(input, output))
+    {
+        emit errorMessage("Error", "Could not open shared memory: " + input);
+    }
+}
+
 /**
  * Nastaveni videa k filtraci.
  * 
@@ -140,6 +197,7 @@ bool ImageSource::setVideoRaw(std::string fileName)
 {
     mCameraTimer->stop();
     mVideoTimer->stop();
+    mShmTimer->stop();
     
     cv::VideoCapture* vc = new cv::VideoCapture();
             
@@ -149,7 +207,10 @@ bool ImageSource::setVideoRaw(std::string fileName)
         mCapture = vc;
         
         mActiveSourceType = SourceType::VIDEO;
+        mRefiner.cancel();
+        mFrameProcessor.setTemporal(true);
         mFrameStep = getVideoCaptureTimerInterval();
+        resetQuality();
         mVideoTimer->start(mFrameStep);
         return true;
     }
@@ -168,6 +229,7 @@ bool ImageSource::setCameraRaw()
 {
     mVideoTimer->stop();
     mCameraTimer->stop();
+    mShmTimer->stop();
     
     cv::VideoCapture* vc = new cv::VideoCapture();
             
@@ -177,7 +239,12 @@ bool ImageSource::setCameraRaw()
         mCapture = vc;
 
         mActiveSourceType = SourceType::CAMERA;
+        mRefiner.cancel();
+        // Kamera snima vetsinou staticke sceny, prepocitaji se jen zmenene dlazdice
+        // (a u Glass zmenene bloky)
+        mFrameProcessor.setTemporal(true);
         mFrameStep = getVideoCaptureTimerInterval();
+        resetQuality();
         mCameraTimer->start(mFrameStep);
         return true;
     }
@@ -187,6 +254,43 @@ bool ImageSource::setCameraRaw()
     }
 }
 
+/**
+ * Nastaveni snimku ze sdilene pameti. Vstupni buffer vytvari jiny proces
+ * (chvili se na nej ceka), vystupni buffer se vytvori ve velikosti
+ * vstupu; filtrovane snimky se do nej zapisuji jako BGR.
+ * 
+ * @param input nazev vstupniho bufferu
+ * @param output nazev vystupniho bufferu (prazdny - bez vystupu)
+ * @return false - buffer se nepodarilo otevrit nebo vytvorit
+ */
+bool ImageSource::setSharedMemoryRaw(const std::string& input, const std::string& output)
+{
+    mVideoTimer->stop();
+    mCameraTimer->stop();
+    mShmTimer->stop();
+    mShmOutput.close();
+    
+    if (!mShmInput.open(input, SHM_OPEN_TIMEOUT))
+    {
+        return false;
+    }
+    
+    if (!output.empty() && !mShmOutput.create(output, mShmInput.size(), CV_8UC3, SHM_OUTPUT_SLOTS))
+    {
+        mShmInput.close();
+        return false;
+    }
+    
+    mActiveSourceType = SourceType::SHARED_MEMORY;
+    mRefiner.cancel();
+    mFrameProcessor.setTemporal(true);
+    mFrameStep = round(1000.0 / SHM_FPS);
+    resetQuality();
+    mShmInput.markReady();
+    mShmTimer->start(SHM_POLL_INTERVAL);
+    return true;
+}
+
 /**
  * Zastaveni prehravani video/kamery.
  */
@@ -201,6 +305,11 @@ void ImageSource::stopVideo()
     {
         mCameraTimer->stop();
     }
+    
+    if (mActiveSourceType == SourceType::SHARED_MEMORY)
+    {
+        mShmTimer->stop();
+    }
 }
 
 /**
@@ -216,18 +325,230 @@ void ImageSource::startVideo()
     {
         mCameraTimer->start(mFrameStep);
     }
+    if (mActiveSourceType == SourceType::SHARED_MEMORY)
+    {
+        mShmTimer->start(SHM_POLL_INTERVAL);
+    }
 }
 
 /**
  * Provedeni filtrace obrazku a emitovani signalu s filtrovanym obrazkem.
+ * Filtruje se jen zobrazena oblast v rozliseni zobrazeni (setViewport).
+ * Pokud by to trvalo dlouho, filtruje se nejdriv zmenseny obrazek (signal
+ * newPreview, statistiky se tykaji nahledu) a oblast se dopocita na
+ * pozadi (imageRefined). Rozpracovana filtrace predchoziho filtru se zrusi.
  */
 void ImageSource::filterImage()
 {
     cv::Mat filteredImage;
+    cv::Rect image(0, 0, mImage.cols, mImage.rows);
     
+    mRenderedRoi = mViewport & image;
+    if (mRenderedRoi.area() == 0)
+    {
+        mRenderedRoi = image;
+    }
+    mRenderedSize = ViewportFilter::outputSize(mImage.size(), mRenderedRoi, mViewportTarget);
+    
+    if (mProxy.empty() 
+        || ViewportFilter::workPixels(mImage.size(), mFilterType, mRenderedRoi, mViewportTarget) <= PROXY_PIXELS)
+    {
+        mRefiner.cancel();
+        mRefineGeneration = 0;
+        
+        startStatistics();
+        ViewportFilter::filter(mImage, filteredImage, mFilterType, mRenderedRoi, mViewportTarget);
+        finishStatistics();
+        
+        showImageResult(filteredImage);
+        return;
+    }
+    
+    cv::Rect proxyRoi((int) std::lround(mRenderedRoi.x * mProxyScale), 
+                      (int) std::lround(mRenderedRoi.y * mProxyScale),
+                      std::max((int) std::lround(mRenderedRoi.width * mProxyScale), 1),
+                      std::max((int) std::lround(mRenderedRoi.height * mProxyScale), 1));
+    
+    startStatistics();
+    ViewportFilter::filter(mProxy, filteredImage, mFilterType, proxyRoi, mViewportTarget);
+    finishStatistics();
+    
+    emit processingScale((double) filteredImage.cols / mRenderedRoi.width);
+    emit newPreview(filteredImage, mRenderedRoi.width, mRenderedRoi.height);
+    
+    mRefineGeneration = mRefiner.start(mImage, mFilterType, mRenderedRoi, mViewportTarget);
+}
+
+/**
+ * Prevzeti obrazku filtrovaneho na pozadi. Vysledek ulohy, ktera mezitim
+ * byla nahrazena (jiny filtr, obrazek, oblast, video), se zahodi.
+ * 
+ * @param image filtrovana oblast obrazku
+ * @param generation cislo ulohy ImageRefiner
+ */
+void ImageSource::imageRefined(cv::Mat image, int generation)
+{
+    if (generation != mRefineGeneration || mActiveSourceType != SourceType::IMAGE)
+    {
+        return;
+    }
+    
+    showImageResult(image);
+}
+
+/**
+ * Zobrazeni filtrovane oblasti obrazku (mRenderedRoi). Oblast zmensena do
+ * rozliseni zobrazeni se zobrazi ve velikosti oblasti.
+ * 
+ * @param image filtrovana oblast
+ */
+void ImageSource::showImageResult(cv::Mat image)
+{
+    emit processingScale((double) image.cols / mRenderedRoi.width);
+    
+    if (image.size() == mImage.size())
+    {
+        emit newImage(image);
+    }
+    else
+    {
+        emit newPreview(image, mRenderedRoi.width, mRenderedRoi.height);
+    }
+}
+
+/**
+ * Nastaveni zobrazene oblasti obrazku a velikosti, ve ktere se zobrazuje.
+ * Obrazek se znovu filtruje, jen pokud se zmenila oblast nebo je treba
+ * vetsi rozliseni, nez ma posledni vysledek (zmenseni zvladne zobrazeni).
+ * 
+ * @param x levy okraj oblasti
+ * @param y horni okraj oblasti
+ * @param width sirka oblasti (0 - cely obrazek)
+ * @param height vyska oblasti (0 - cely obrazek)
+ * @param targetWidth sirka zobrazeni (0 - plne rozliseni)
+ * @param targetHeight vyska zobrazeni (0 - plne rozliseni)
+ */
+void ImageSource::setViewport(int x, int y, int width, int height, int targetWidth, int targetHeight)
+{
+    mViewport = cv::Rect(x, y, width, height);
+    mViewportTarget = cv::Size(targetWidth, targetHeight);
+    
+    if (mActiveSourceType != SourceType::IMAGE || mImage.empty())
+    {
+        return;
+    }
+    
+    cv::Rect image(0, 0, mImage.cols, mImage.rows);
+    cv::Rect roi = mViewport & image;
+    if (roi.area() == 0)
+    {
+        roi = image;
+    }
+    cv::Size size = ViewportFilter::outputSize(mImage.size(), roi, mViewportTarget);
+    
+    if (roi != mRenderedRoi || size.width > mRenderedSize.width || size.height > mRenderedSize.height)
+    {
+        filterImage();
+    }
+}
+
+/**
+ * Ulozeni obrazku filtrovaneho v plnem rozliseni (cely obrazek bez ohledu
+ * na zobrazenou oblast).
+ * 
+ * @param fileName cesta k souboru
+ */
+void ImageSource::saveImage(std::string fileName)
+{
+    if (mActiveSourceType != SourceType::IMAGE || mImage.empty())
+    {
+        emit errorMessage("Error", "Only a filtered image can be saved.");
+        return;
+    }
+    
+    cv::Mat filteredImage;
     ImageFilter::filter(mImage, filteredImage, mFilterType);
     
-    emit newImage(filteredImage); 
+    bool saved = false;
+    try
+    {
+        saved = cv::imwrite(fileName, filteredImage);
+    }
+    catch (const cv::Exception&)
+    {
+        saved = false;
+    }
+    
+    if (!saved)
+    {
+        emit errorMessage("Error", "Could not save image: " + fileName);
+    }
+}
+
+/**
+ * Filtrace snimku nacteneho do mFrameProcessor.input(). Vystupni snimek
+ * pochazi ze zasobniku a vrati se do nej po zobrazeni. Podle doby filtrace
+ * se upravi meritko zpracovani dalsich snimku (QualityGovernor).
+ * 
+ * @return filtrovany snimek
+ */
+cv::Mat ImageSource::processFrame()
+{
+    startStatistics();
+    long long start = cv::getTickCount();
+    cv::Mat filteredImage = mFrameProcessor.process();
+    double milliseconds = (cv::getTickCount() - start) * 1000.0 / cv::getTickFrequency();
+    finishStatistics();
+    
+    if (mQualityGovernor.update(milliseconds))
+    {
+        mFrameProcessor.setScale(mQualityGovernor.scale());
+        emit processingScale(mQualityGovernor.scale());
+    }
+    
+    return filteredImage;
+}
+
+/**
+ * Navrat na plne rozliseni a nastaveni rozpoctu doby snimku podle
+ * aktivniho zdroje (obrazek se filtruje vzdy v plnem rozliseni).
+ */
+void ImageSource::resetQuality()
+{
+    bool stream = mActiveSourceType == SourceType::VIDEO || mActiveSourceType == SourceType::CAMERA
+                  || mActiveSourceType == SourceType::SHARED_MEMORY;
+    
+    mQualityGovernor.setBudget(stream ? mFrameStep : 0);
+    mQualityGovernor.reset();
+    mFrameProcessor.setScale(mQualityGovernor.scale());
+    
+    emit processingScale(mQualityGovernor.scale());
+}
+
+/**
+ * Zahajeni mereni casu a alokaci filtrace (pokud je zapnuto).
+ */
+void ImageSource::startStatistics()
+{
+    if (mStatisticsEnabled)
+    {
+        MemoryTracker::start();
+        mStatisticsStart = cv::getTickCount();
+    }
+}
+
+/**
+ * Ukonceni mereni a emitovani signalu filterStatistics.
+ */
+void ImageSource::finishStatistics()
+{
+    if (mStatisticsEnabled)
+    {
+        double milliseconds = (cv::getTickCount() - mStatisticsStart) * 1000.0 / cv::getTickFrequency();
+        MemoryTracker::Stats stats = MemoryTracker::stop();
+        
+        emit filterStatistics(milliseconds, stats.allocatedBytes, stats.allocations, stats.peakBytes);
+    }
 }
 
 /**
@@ -235,13 +556,9 @@ void ImageSource::filterImage()
  */
 void ImageSource::newVideoFrame()
 {
-    cv::Mat sourceImage;
-    
-    if (mCapture->read(sourceImage))
+    if (mCapture->read(mFrameProcessor.input()))
     {
-        cv::Mat filteredImage; 
-        ImageFilter::filter(sourceImage, filteredImage, mFilterType);
-        emit newImage(filteredImage);
+        emit newImage(processFrame());
 
         if (mCapture->get(CV_CAP_PROP_POS_FRAMES) == mCapture->get(CV_CAP_PROP_FRAME_COUNT))
         {
@@ -255,14 +572,92 @@ void ImageSource::newVideoFrame()
  */
 void ImageSource::newCameraFrame()
 {
-    cv::Mat sourceImage;
+    if (mCapture->read(mFrameProcessor.input()))
+    {
+        emit newImage(processFrame());
+    }
+}
+
+/**
+ * Filtrace nejnovejsiho snimku ze sdilene pameti (starsi snimky, ktere
+ * filtrace nestihla, se preskoci) a zapis vysledku do vystupniho bufferu.
+ * Po konci zapisujici strany se kontrola novych snimku zastavi.
+ */
+void ImageSource::newSharedMemoryFrame()
+{
+    if (mShmInput.isFinished())
+    {
+        mShmTimer->stop();
+        return;
+    }
+    
+    mShmInput.skipToLatest();
+    
+    long long timestamp;
+    cv::Mat frame = mShmInput.beginRead(nullptr, &timestamp);
+    
+    if (frame.empty())
+    {
+        return;
+    }
+    
+    // Kopie do vstupu procesoru (porovnava se s predchozim snimkem),
+    // misto se hned uvolni zapisujici strane
+    if (frame.channels() == 1)
+    {
+        cv::cvtColor(frame, mFrameProcessor.input(), CV_GRAY2BGR);
+    }
+    else
+    {
+        frame.copyTo(mFrameProcessor.input());
+    }
+    mShmInput.endRead();
+    
+    cv::Mat filteredImage = processFrame();
+    writeSharedMemoryFrame(filteredImage, timestamp);
+    
+    emit newImage(filteredImage);
+}
 
-    if (mCapture->read(sourceImage))
+/**
+ * Zapis filtrovaneho snimku do vystupniho bufferu (BGR v plne velikosti).
+ * Pokud ctouci strana nestiha, snimek se zahodi, zobrazeni nececka.
+ * 
+ * @param image filtrovany snimek (muze byt zmenseny nebo sedotonovy)
+ * @param timestamp cas puvodniho snimku
+ */
+void ImageSource::writeSharedMemoryFrame(const cv::Mat& image, long long timestamp)
+{
+    if (!mShmOutput.isOpen())
+    {
+        return;
+    }
+    
+    cv::Mat slot = mShmOutput.beginWrite();
+    
+    if (slot.empty())
     {
-        cv::Mat filteredImage;
-        ImageFilter::filter(sourceImage, filteredImage, mFilterType);
-        emit newImage(filteredImage);
+        return;
     }
+    
+    const cv::Mat* result = &image;
+    
+    if (image.size() != slot.size())
+    {
+        cv::resize(image, mShmScaled, slot.size(), 0, 0, cv::INTER_LINEAR);
+        result = &mShmScaled;
+    }
+    
+    if (result->channels() == 1)
+    {
+        cv::cvtColor(*result, slot, CV_GRAY2BGR);
+    }
+    else
+    {
+        result->copyTo(slot);
+    }
+    
+    mShmOutput.commitWrite(timestamp);
 }
 
 /**
@@ -272,7 +667,7 @@ void ImageSource::newCameraFrame()
  */
 bool ImageSource::videoIsRunning()
 {
-    return mVideoTimer->isActive() || mCameraTimer->isActive();
+    return mVideoTimer->isActive() || mCameraTimer->isActive() || mShmTimer->isActive();
 }
 
 /**
@@ -17,7 +17,11 @@
 #include <opencv2/imgproc/imgproc.hpp> // cv::Mat
 #include <opencv2/highgui/highgui.hpp> // cv::VideoCapture
 
+#include "FrameProcessor.h"
 #include "ImageFilter.h"
+#include "ImageRefiner.h"
+#include "QualityGovernor.h"
+#include "ShmRing.h"
 
 class ImageSource : public QObject
 {
@@ -30,22 +34,51 @@ class ImageSource : public QObject
             IMAGE,
             CAMERA,
             VIDEO,
+            SHARED_MEMORY,
             NOTHING
         };
     
     private:
         
         static constexpr double DEFAULT_FPS = 25.0;
+        
+        // Nejvetsi pocet pixelu nahledu obrazku (vetsi obrazky se nejdriv
+        // filtruji zmensene, plne rozliseni dopocita ImageRefiner)
+        static const int PROXY_PIXELS = 640 * 480;
+
+        // Snimky ze sdilene pameti: interval kontroly noveho snimku (ms),
+        // ocekavane snimky za sekundu (rozpocet QualityGovernor), cekani
+        // na vytvoreni vstupniho bufferu (ms) a mista vystupniho bufferu
+        static const int SHM_POLL_INTERVAL = 1;
+        static constexpr double SHM_FPS = 60.0;
+        static const int SHM_OPEN_TIMEOUT = 5000;
+        static const int SHM_OUTPUT_SLOTS = 4;
 
         SourceType mActiveSourceType;
         ImageFilter::Type mFilterType;
         cv::Mat mImage;
+        cv::Mat mProxy;          // zmenseny obrazek pro nahled
+        double mProxyScale;
+        ImageRefiner mRefiner;
+        int mRefineGeneration;   // uloha mRefiner, jejiz vysledek se zobrazi
+        cv::Rect mViewport;      // zobrazena oblast obrazku (prazdna - cely)
+        cv::Size mViewportTarget;// velikost zobrazeni oblasti (prazdna - plne rozliseni)
+        cv::Rect mRenderedRoi;   // oblast a velikost posledni filtrace obrazku
+        cv::Size mRenderedSize;
         cv::Mat mFilteredImage;
+        FrameProcessor mFrameProcessor;
+        QualityGovernor mQualityGovernor;
         cv::VideoCapture* mCapture;
+        ShmRing mShmInput;
+        ShmRing mShmOutput;
+        cv::Mat mShmScaled;      // vysledek zmenseneho snimku v plne velikosti
         int mFrameStep;
+        bool mStatisticsEnabled;
+        long long mStatisticsStart;
         
         QTimer* mVideoTimer;
         QTimer* mCameraTimer;
+        QTimer* mShmTimer;
         QThread* mThread;
         
     public:
@@ -61,7 +94,11 @@ class ImageSource : public QObject
         void setImage(cv::Mat image);
         void setVideo(std::string fileName);
         void setCamera();
+        void setSharedMemory(std::string input, std::string output);
         void setFilterType(ImageFilter::Type filterType);
+        void setStatisticsEnabled(bool enabled);
+        void setViewport(int x, int y, int width, int height, int targetWidth, int targetHeight);
+        void saveImage(std::string fileName);
         
         //? rename stopPlayback?
         void stopVideo();
@@ -70,20 +107,33 @@ class ImageSource : public QObject
     signals:
     
         void newImage(cv::Mat img);
+        void newPreview(cv::Mat img, int width, int height);
         void errorMessage(std::string title, std::string msg);
+        void filterStatistics(double milliseconds, qint64 allocatedBytes, 
+                              qint64 allocations, qint64 peakBytes);
+        void processingScale(double scale);
     
     private slots:
         
         void newVideoFrame();
         void newCameraFrame();
+        void newSharedMemoryFrame();
+        void imageRefined(cv::Mat image, int generation);
 
     private:
         
         bool setVideoRaw(std::string fileName);
         bool setCameraRaw();
+        bool setSharedMemoryRaw(const std::string& input, const std::string& output);
+        void writeSharedMemoryFrame(const cv::Mat& image, long long timestamp);
         
         void initTimers();
         void filterImage();
+        void showImageResult(cv::Mat image);
+        cv::Mat processFrame();
+        void startStatistics();
+        void finishStatistics();
+        void resetQuality();
         int getVideoCaptureTimerInterval();
 
 };
@@ -27,6 +27,9 @@ ImageViewerOpenGl::ImageViewerOpenGl(QWidget *parent)
     mSceneChanged = false;
     mBgColor = QColor::fromRgb(150, 150, 150);
 
+    mImageW = 0;
+    mImageH = 0;
+
     mOutH = 0;
     mOutW = 0;
 
@@ -64,8 +67,7 @@ void ImageViewerOpenGl::resizeGL(int width, int height)
 
     glMatrixMode(GL_MODELVIEW);
 
-    mTemporalScale = width < mRenderQtImg.width() 
-                     || height < mRenderQtImg.height();
+    mTemporalScale = width < mImageW || height < mImageH;
 
     // ---> Scaled Image Sizes
     if (mScale || mTemporalScale)
@@ -81,13 +83,16 @@ void ImageViewerOpenGl::resizeGL(int width, int height)
     }
     else
     {
-        mOutW = mRenderQtImg.width();
-        mOutH = mRenderQtImg.height();
+        mOutW = mImageW;
+        mOutH = mImageH;
     }
 
     emit imageSizeChanged(mOutW, mOutH);
     // <--- Scaled Image Sizes
 
+    // Zobrazuje se vzdy cely obrazek, nejvyse ve velikosti okna
+    emit viewportChanged(0, 0, 0, 0, width, height);
+
     mPosX = (width - mOutW) / 2;
     mPosY = (height - mOutH) / 2;
 
@@ -101,8 +106,7 @@ void ImageViewerOpenGl::resizeGL(int width, int height)
  */
 void ImageViewerOpenGl::forceImageResize()
 {
-    mTemporalScale = width() < mRenderQtImg.width() 
-                     || height() < mRenderQtImg.height();
+    mTemporalScale = width() < mImageW || height() < mImageH;
     
     if (mScale || mTemporalScale)
     {
@@ -117,8 +121,8 @@ void ImageViewerOpenGl::forceImageResize()
     }
     else
     {
-        mOutW = mRenderQtImg.width();
-        mOutH = mRenderQtImg.height();
+        mOutW = mImageW;
+        mOutH = mImageH;
     }
     
     mPosX = (width() - mOutW) / 2;
@@ -170,43 +174,23 @@ void ImageViewerOpenGl::renderImage()
 
         glPushMatrix();
         {
-            if (mScale || mTemporalScale)
+            // Obrazek se roztahuje na cele okno nebo je to zmenseny nahled
+            if (mRenderQtImg.width() != mOutW || mRenderQtImg.height() != mOutH)
             {
-                int imW = mRenderQtImg.width();
-                int imH = mRenderQtImg.height();
-
-                // The image is to be resized to fit the widget?
-                if (imW != this->size().width() &&
-                        imH != this->size().height())
-                {
-
-                    image = mRenderQtImg.scaled(//this->size(),
-                            QSize(mOutW, mOutH),
-                            Qt::IgnoreAspectRatio,
-                            Qt::SmoothTransformation
-                            );
-
-                    //qDebug( QString( "Image size: (%1x%2)").arg(imW).arg(imH).toAscii() );
-                }
-                else
-                {
-                    image = mRenderQtImg;
-                }
-                // ---> Centering image in draw area            
-                glRasterPos2i(mPosX, mPosY);
-                // <--- Centering image in draw area
-
-                imW = image.width();
-                imH = image.height();
-                
-                glDrawPixels(imW, imH, GL_RGBA, GL_UNSIGNED_BYTE, image.bits());
+                image = mRenderQtImg.scaled(QSize(mOutW, mOutH),
+                                            Qt::IgnoreAspectRatio,
+                                            Qt::SmoothTransformation);
             }
             else
             {
-                glRasterPos2i(mPosX, mPosY);
-                glDrawPixels(mRenderQtImg.width(), mRenderQtImg.height(),
-                             GL_RGBA, GL_UNSIGNED_BYTE, mRenderQtImg.bits());
+                image = mRenderQtImg;
             }
+
+            // ---> Centering image in draw area
+            glRasterPos2i(mPosX, mPosY);
+            // <--- Centering image in draw area
+
+            glDrawPixels(image.width(), image.height(), GL_RGBA, GL_UNSIGNED_BYTE, image.bits());
         }
         glPopMatrix();
 
@@ -223,11 +207,27 @@ void ImageViewerOpenGl::renderImage()
  */
 bool ImageViewerOpenGl::showImage(cv::Mat image)
 {
-    bool needResize = image.cols != mOrigImage.cols || image.rows != mOrigImage.rows;
+    return showPreview(image, image.cols, image.rows);
+}
+
+/**
+ * Nastaveni zmenseneho nahledu k vykresleni. Nahled se zobrazi ve velikosti
+ * obrazku, ktery nahrazuje (rozlozeni okna se nezmeni).
+ * 
+ * @param image nahled
+ * @param width sirka plneho obrazku
+ * @param height vyska plneho obrazku
+ * @return true - vse ok; false - neco se pokazilo
+ */
+bool ImageViewerOpenGl::showPreview(cv::Mat image, int width, int height)
+{
+    bool needResize = width != mImageW || height != mImageH;
 
     image.copyTo(mOrigImage);
     
-    mImgRatio = (float) image.cols / (float) image.rows;
+    mImageW = width;
+    mImageH = height;
+    mImgRatio = (float) width / (float) height;
     if (mOrigImage.channels() == 3)
     {
         mRenderQtImg = QImage((const unsigned char*) (mOrigImage.data),
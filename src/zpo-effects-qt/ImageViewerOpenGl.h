@@ -31,6 +31,9 @@ class ImageViewerOpenGl : public QOpenGLWidget
 
         QColor mBgColor; /// Background color
 
+        int mImageW; /// Displayed image width (preview is stretched to it)
+        int mImageH; /// Displayed image height
+
         int mOutH; /// Resized Image height
         int mOutW; /// Resized Image width
         float mImgRatio; /// height/width ratio
@@ -45,10 +48,12 @@ class ImageViewerOpenGl : public QOpenGLWidget
     signals:
         
         void imageSizeChanged( int outW, int outH ); /// Used to resize the image outside the widget
+        void viewportChanged( int x, int y, int width, int height, int targetWidth, int targetHeight ); /// Visible image region and its display size
 
     public slots:
 
         bool showImage(cv::Mat image); /// Used to set the image to be viewed
+        bool showPreview(cv::Mat image, int width, int height); /// Downscaled image shown at width x height
         void setScale(bool scale);
         void setScale(int scale);
 
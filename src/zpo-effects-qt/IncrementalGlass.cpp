@@ -0,0 +1,558 @@
+/*
+ * Soubor: IncrementalGlass.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "IncrementalGlass.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "KernelDispatch.h"
+#include "TaskScheduler.h"
+
+// Nejvyssi soucet jasu bunky (R + G + B) / 3
+static const int MAX_CELL_VALUE = IncrementalGlass::REGION_SIZE * IncrementalGlass::REGION_SIZE * 255;
+
+static const int SEARCH_CELLS = IncrementalGlass::SEARCH_CELLS;
+static const int MAX_CANDIDATES = (2 * SEARCH_CELLS + 1) * (2 * SEARCH_CELLS + 1);
+
+/**
+ * Posun seminka v bunce pro kazdy soucet jasu: srand(soucet) a dve volani
+ * rand() jako v ReferenceFilter::glass. Tabulka se spocita jednou (pri
+ * prvnim pouziti), seminka bunek pak lze urcovat nezavisle, paralelne
+ * i v soucasne bezicich filtrech.
+ *
+ * S glibc se pouzije vlastni stav generatoru (random_r), globalni stav
+ * rand() pouzivany ReferenceFilter::glass v jinem vlakne se tak nemeni.
+ * rand() v glibc je random() se stavem TYPE_3 (128 B), vysledky jsou
+ * shodne. Jinde se vola primo srand/rand (MSVC ma stav pro kazde vlakno).
+ *
+ * @return posuny x, y pro soucty 0 az MAX_CELL_VALUE
+ */
+static const std::vector<unsigned char>& seedOffsets()
+{
+    static const std::vector<unsigned char> table = [] {
+        std::vector<unsigned char> offsets(2 * (MAX_CELL_VALUE + 1));
+#if defined(__GLIBC__)
+        char state[128];
+        random_data data;
+        memset(&data, 0, sizeof(data));
+        initstate_r(0, state, sizeof(state), &data);
+#endif
+        for (int value = 0; value <= MAX_CELL_VALUE; value++)
+        {
+#if defined(__GLIBC__)
+            int32_t x, y;
+            srandom_r(value, &data);
+            random_r(&data, &x);
+            random_r(&data, &y);
+#else
+            srand(value);
+            int x = rand();
+            int y = rand();
+#endif
+            offsets[2 * value] = (unsigned char) (x % IncrementalGlass::REGION_SIZE);
+            offsets[2 * value + 1] = (unsigned char) (y % IncrementalGlass::REGION_SIZE);
+        }
+        return offsets;
+    }();
+
+    return table;
+}
+
+/**
+ * Mezera mezi blokem a bunkou v jedne ose (nejmensi vzdalenost pixelu).
+ *
+ * @param block index bloku
+ * @param cell index bunky
+ * @return mezera v pixelech
+ */
+static int gap(int block, int cell)
+{
+    int cells = std::abs(block - cell);
+    return cells == 0 ? 0 : cells * IncrementalGlass::REGION_SIZE - (IncrementalGlass::REGION_SIZE - 1);
+}
+
+IncrementalGlass::IncrementalGlass()
+    : mCellCols(0)
+    , mCellRows(0)
+    , mBlockCols(0)
+    , mBlockRows(0)
+    , mValid(false)
+    , mUpdatedBlocks(0)
+{
+}
+
+/**
+ * Posun seminka v bunce (srand(soucet) a dve volani rand() jako
+ * v ReferenceFilter::glass), bezpecne z vice vlaken.
+ *
+ * @param value soucet jasu bunky (R + G + B) / 3
+ * @param x vystupni posun x
+ * @param y vystupni posun y
+ */
+void IncrementalGlass::seedOffset(int value, int* x, int* y)
+{
+    const std::vector<unsigned char>& offsets = seedOffsets();
+
+    *x = offsets[2 * value];
+    *y = offsets[2 * value + 1];
+}
+
+/**
+ * Test, zda seminko bunky muze byt nejblizsim seminkem nektereho pixelu
+ * bloku. Vzdalenost pixelu bloku od seminka nejblizsi bunky (bunky bloku,
+ * u bloku bez seminka krajni bunky) je nejvyse B, seminka bunek s mezerou
+ * od bloku vetsi nez B proto nemohou vyhrat ani pri shode.
+ *
+ * @param bx sloupec bloku
+ * @param by radek bloku
+ * @param cx sloupec bunky
+ * @param cy radek bunky
+ * @param cellCols pocet sloupcu bunek se seminkem
+ * @param cellRows pocet radku bunek se seminkem
+ * @return true - bunka je kandidatem bloku
+ */
+bool IncrementalGlass::isCandidate(int bx, int by, int cx, int cy, int cellCols, int cellRows)
+{
+    if (std::abs(bx - cx) > SEARCH_CELLS || std::abs(by - cy) > SEARCH_CELLS)
+    {
+        return false;
+    }
+
+    int ownX = std::min(bx, cellCols - 1);
+    int ownY = std::min(by, cellRows - 1);
+    int bound = (bx - ownX) * REGION_SIZE + REGION_SIZE - 1
+                + (by - ownY) * REGION_SIZE + REGION_SIZE - 1;
+
+    return gap(bx, cx) + gap(by, cy) <= bound;
+}
+
+/**
+ * Zahozeni stavu, dalsi snimek se spocita cely.
+ */
+void IncrementalGlass::reset()
+{
+    mValid = false;
+}
+
+/**
+ * Pocet bloku snimku.
+ *
+ * @return pocet bloku
+ */
+int IncrementalGlass::blockCount() const
+{
+    return mBlockCols * mBlockRows;
+}
+
+/**
+ * Pocet bloku prepocitanych v poslednim snimku.
+ *
+ * @return pocet bloku
+ */
+int IncrementalGlass::updatedBlocks() const
+{
+    return mUpdatedBlocks;
+}
+
+/**
+ * Filtrace dalsiho snimku. Prvni snimek (a snimek jine velikosti) se
+ * spocita cely, dalsi jen v blocich, ktere se zmenily nebo jejichz
+ * kandidat se posunul.
+ *
+ * @param src vstupni snimek (BGR)
+ * @param dst vystupni snimek
+ */
+void IncrementalGlass::filter(const cv::Mat& src, cv::Mat& dst)
+{
+    if (!mValid || src.size() != mSize)
+    {
+        initialize(src.size());
+    }
+
+    int seedCount = mCellCols * mCellRows;
+
+    if (seedCount == 0)
+    {
+        // Obrazek mensi nez bunka nema zadny region
+        src.copyTo(dst);
+        mUpdatedBlocks = blockCount();
+        return;
+    }
+
+    TaskScheduler& scheduler = TaskScheduler::instance();
+    int blocks = blockCount();
+    bool first = !mValid;
+
+    const KernelDispatch::Kernels& kernels = KernelDispatch::active();
+
+    // Zmenene bloky (soucet absolutnich rozdilu proti predchozimu snimku)
+    scheduler.parallelFor(0, mBlockRows, 1, [&](int begin, int end) {
+        for (int by = begin; by < end; by++)
+        {
+            for (int bx = 0; bx < mBlockCols; bx++)
+            {
+                bool changed = first;
+                cv::Rect rect = blockRect(bx, by);
+
+                for (int j = rect.y; j < rect.y + rect.height && !changed; j++)
+                {
+                    changed = kernels.sad(src.ptr(j) + 3 * rect.x, mPrevious.ptr(j) + 3 * rect.x,
+                                          3 * rect.width) != 0;
+                }
+
+                mChanged[by * mBlockCols + bx] = changed ? 1 : 0;
+            }
+        }
+    });
+
+    // Seminka zmenenych bunek (bunka s seminkem je blok se stejnym indexem)
+    scheduler.parallelFor(0, mCellCols, 1, [&](int begin, int end) {
+        for (int cx = begin; cx < end; cx++)
+        {
+            for (int cy = 0; cy < mCellRows; cy++)
+            {
+                bool moved = first;
+                if (mChanged[cy * mBlockCols + cx])
+                {
+                    moved = updateSeed(src, cx, cy) || moved;
+                }
+                mMoved[cx * mCellRows + cy] = moved ? 1 : 0;
+            }
+        }
+    });
+
+    // Bloky s posunutym kandidatem
+    mUpdatedBlocks = 0;
+    for (int b = 0; b < blocks; b++)
+    {
+        bool relabel = first;
+        for (int k = mCandidateStart[b]; k < mCandidateStart[b + 1] && !relabel; k++)
+        {
+            relabel = mMoved[mCandidates[k]] != 0;
+        }
+
+        mRelabel[b] = relabel ? 1 : 0;
+        mUpdatedBlocks += relabel || mChanged[b] ? 1 : 0;
+    }
+
+    // Pri zmene vetsiny bloku je rychlejsi secist regiony znovu
+    bool resum = first || 2 * mUpdatedBlocks > blocks;
+
+    if (!resum)
+    {
+        for (int b = 0; b < blocks; b++)
+        {
+            if (mRelabel[b] || mChanged[b])
+            {
+                addBlock(mPrevious, b % mBlockCols, b / mBlockCols, -1);
+            }
+        }
+    }
+
+    scheduler.parallelFor(0, mBlockRows, 1, [&](int begin, int end) {
+        for (int by = begin; by < end; by++)
+        {
+            for (int bx = 0; bx < mBlockCols; bx++)
+            {
+                if (mRelabel[by * mBlockCols + bx])
+                {
+                    labelBlock(kernels, bx, by);
+                }
+            }
+        }
+    });
+
+    if (resum)
+    {
+        sumRegions(src);
+    }
+    else
+    {
+        for (int b = 0; b < blocks; b++)
+        {
+            if (mRelabel[b] || mChanged[b])
+            {
+                addBlock(src, b % mBlockCols, b / mBlockCols, 1);
+            }
+        }
+    }
+
+    // Prumerne barvy regionu
+    scheduler.parallelFor(0, seedCount, 256, [&](int begin, int end) {
+        const int* counts = &mSums[3 * seedCount];
+
+        for (int s = begin; s < end; s++)
+        {
+            for (int c = 0; c < 3; c++)
+            {
+                int sum = mSums[c * seedCount + s];
+                mColors[3 * s + c] = counts[s] > 0 ? std::min(sum / counts[s], 255) : 0;
+            }
+        }
+    });
+
+    dst.create(src.rows, src.cols, src.type());
+
+    scheduler.parallelFor(0, src.rows, REGION_SIZE, [&](int begin, int end) {
+        for (int j = begin; j < end; j++)
+        {
+            const int* labelRow = mLabels.ptr<int>(j);
+            cv::Vec3b* dstRow = dst.ptr<cv::Vec3b>(j);
+
+            for (int i = 0; i < src.cols; i++)
+            {
+                const int* color = &mColors[3 * labelRow[i]];
+
+                dstRow[i].val[0] = (uchar) color[0];
+                dstRow[i].val[1] = (uchar) color[1];
+                dstRow[i].val[2] = (uchar) color[2];
+            }
+        }
+    });
+
+    // Predchozi snimek pro dalsi porovnani (jen zmenene bloky)
+    scheduler.parallelFor(0, mBlockRows, 1, [&](int begin, int end) {
+        for (int by = begin; by < end; by++)
+        {
+            for (int bx = 0; bx < mBlockCols; bx++)
+            {
+                if (mChanged[by * mBlockCols + bx])
+                {
+                    cv::Rect rect = blockRect(bx, by);
+                    cv::Mat previous = mPrevious(rect);
+                    src(rect).copyTo(previous);
+                }
+            }
+        }
+    });
+
+    mValid = true;
+}
+
+/**
+ * Alokace stavu pro snimky dane velikosti.
+ *
+ * @param size velikost snimku
+ */
+void IncrementalGlass::initialize(cv::Size size)
+{
+    mSize = size;
+
+    // Seminko ma kazda cela bunka mrizky krome posledniho sloupce/radku bunek
+    mCellCols = size.width > REGION_SIZE ? (size.width - REGION_SIZE - 1) / REGION_SIZE + 1 : 0;
+    mCellRows = size.height > REGION_SIZE ? (size.height - REGION_SIZE - 1) / REGION_SIZE + 1 : 0;
+    mBlockCols = (size.width + REGION_SIZE - 1) / REGION_SIZE;
+    mBlockRows = (size.height + REGION_SIZE - 1) / REGION_SIZE;
+
+    int seedCount = mCellCols * mCellRows;
+    int blocks = blockCount();
+
+    mPrevious.create(size, CV_8UC3);
+    mLabels.create(size, CV_32SC1);
+    mSeedX.assign(seedCount, 0);
+    mSeedY.assign(seedCount, 0);
+    mSums.assign(4 * seedCount, 0);
+    mColors.assign(3 * seedCount, 0);
+    mChanged.assign(blocks, 0);
+    mMoved.assign(seedCount, 0);
+    mRelabel.assign(blocks, 0);
+
+    findCandidates();
+    mValid = false;
+}
+
+/**
+ * Kandidati kazdeho bloku: bunky, jejichz seminko muze byt nejblizsi
+ * nekteremu pixelu bloku (isCandidate). Kandidati jsou serazeni podle
+ * indexu seminka (pri shode vzdalenosti vyhrava nizsi index jako
+ * v ImageFilter::glass).
+ */
+void IncrementalGlass::findCandidates()
+{
+    mCandidateStart.assign(blockCount() + 1, 0);
+    mCandidates.clear();
+
+    for (int by = 0; by < mBlockRows; by++)
+    {
+        for (int bx = 0; bx < mBlockCols; bx++)
+        {
+            mCandidateStart[by * mBlockCols + bx] = (int) mCandidates.size();
+
+            for (int cx = std::max(bx - SEARCH_CELLS, 0); cx <= std::min(bx + SEARCH_CELLS, mCellCols - 1); cx++)
+            {
+                for (int cy = std::max(by - SEARCH_CELLS, 0); cy <= std::min(by + SEARCH_CELLS, mCellRows - 1); cy++)
+                {
+                    if (isCandidate(bx, by, cx, cy, mCellCols, mCellRows))
+                    {
+                        mCandidates.push_back(cx * mCellRows + cy);
+                    }
+                }
+            }
+        }
+    }
+
+    mCandidateStart[blockCount()] = (int) mCandidates.size();
+}
+
+/**
+ * Prepocet seminka bunky ze souctu jasu.
+ *
+ * @param src vstupni snimek
+ * @param cx sloupec bunky
+ * @param cy radek bunky
+ * @return true - seminko se posunulo
+ */
+bool IncrementalGlass::updateSeed(const cv::Mat& src, int cx, int cy)
+{
+    int sum = 0;
+
+    for (int l = cy * REGION_SIZE; l < (cy + 1) * REGION_SIZE; l++)
+    {
+        const uchar* row = src.ptr(l) + 3 * cx * REGION_SIZE;
+
+        for (int k = 0; k < 3 * REGION_SIZE; k++)
+        {
+            sum += row[k];
+        }
+    }
+
+    int index = cx * mCellRows + cy;
+    int seedX;
+    int seedY;
+    seedOffset(sum / 3, &seedX, &seedY);
+    seedX += cx * REGION_SIZE;
+    seedY += cy * REGION_SIZE;
+
+    bool moved = seedX != mSeedX[index] || seedY != mSeedY[index];
+
+    mSeedX[index] = seedX;
+    mSeedY[index] = seedY;
+
+    return moved;
+}
+
+/**
+ * Prirazeni pixelu bloku nejblizsimu seminku z kandidatu bloku.
+ *
+ * @param kernels funkce radku
+ * @param bx sloupec bloku
+ * @param by radek bloku
+ */
+void IncrementalGlass::labelBlock(const KernelDispatch::Kernels& kernels, int bx, int by)
+{
+    int candidateX[MAX_CANDIDATES];
+    int candidateY[MAX_CANDIDATES];
+    int labels[REGION_SIZE];
+    int distances[REGION_SIZE];
+
+    cv::Rect rect = blockRect(bx, by);
+    int begin = mCandidateStart[by * mBlockCols + bx];
+    int count = mCandidateStart[by * mBlockCols + bx + 1] - begin;
+
+    // Souradnice x relativne k zacatku bloku
+    for (int k = 0; k < count; k++)
+    {
+        candidateX[k] = mSeedX[mCandidates[begin + k]] - rect.x;
+        candidateY[k] = mSeedY[mCandidates[begin + k]];
+    }
+
+    for (int j = rect.y; j < rect.y + rect.height; j++)
+    {
+        kernels.nearestSeed(candidateX, candidateY, count, j, labels, distances, rect.width);
+
+        int* labelRow = mLabels.ptr<int>(j) + rect.x;
+        for (int i = 0; i < rect.width; i++)
+        {
+            labelRow[i] = mCandidates[begin + labels[i]];
+        }
+    }
+}
+
+/**
+ * Pricteni (odecteni) prispevku pixelu bloku k souctum regionu.
+ *
+ * @param src snimek
+ * @param bx sloupec bloku
+ * @param by radek bloku
+ * @param sign 1 - pricteni, -1 - odecteni
+ */
+void IncrementalGlass::addBlock(const cv::Mat& src, int bx, int by, int sign)
+{
+    cv::Rect rect = blockRect(bx, by);
+    int seedCount = mCellCols * mCellRows;
+    int* sumB = &mSums[0];
+    int* sumG = &mSums[seedCount];
+    int* sumR = &mSums[2 * seedCount];
+    int* counts = &mSums[3 * seedCount];
+
+    for (int j = rect.y; j < rect.y + rect.height; j++)
+    {
+        const cv::Vec3b* srcRow = src.ptr<cv::Vec3b>(j);
+        const int* labelRow = mLabels.ptr<int>(j);
+
+        for (int i = rect.x; i < rect.x + rect.width; i++)
+        {
+            int s = labelRow[i];
+
+            sumB[s] += sign * srcRow[i].val[0];
+            sumG[s] += sign * srcRow[i].val[1];
+            sumR[s] += sign * srcRow[i].val[2];
+            counts[s] += sign;
+        }
+    }
+}
+
+/**
+ * Soucty barev vsech regionu znovu, kazdy kanal a pocty pixelu jako
+ * samostatna uloha.
+ *
+ * @param src vstupni snimek
+ */
+void IncrementalGlass::sumRegions(const cv::Mat& src)
+{
+    int seedCount = mCellCols * mCellRows;
+
+    std::fill(mSums.begin(), mSums.end(), 0);
+
+    TaskScheduler::instance().parallelFor(0, 4, 1, [&](int begin, int end) {
+        for (int c = begin; c < end; c++)
+        {
+            int* sums = &mSums[c * seedCount];
+
+            for (int j = 0; j < src.rows; j++)
+            {
+                const cv::Vec3b* srcRow = src.ptr<cv::Vec3b>(j);
+                const int* labelRow = mLabels.ptr<int>(j);
+
+                for (int i = 0; i < src.cols; i++)
+                {
+                    sums[labelRow[i]] += c < 3 ? srcRow[i].val[c] : 1;
+                }
+            }
+        }
+    });
+}
+
+/**
+ * Oblast bloku ve snimku (krajni bloky mohou byt mensi).
+ *
+ * @param bx sloupec bloku
+ * @param by radek bloku
+ * @return oblast bloku
+ */
+cv::Rect IncrementalGlass::blockRect(int bx, int by) const
+{
+    int x = bx * REGION_SIZE;
+    int y = by * REGION_SIZE;
+
+    return cv::Rect(x, y, std::min(REGION_SIZE, mSize.width - x), std::min(REGION_SIZE, mSize.height - y));
+}
@@ -0,0 +1,89 @@
+/*
+ * Soubor: IncrementalGlass.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef INCREMENTALGLASS_H
+#define	INCREMENTALGLASS_H
+
+#include <vector>
+
+#include <opencv2/core/core.hpp> // cv::Mat
+
+#include "KernelDispatch.h"
+
+/**
+ * Filtr Glass pro sekvenci snimku se stavem mezi snimky. Vysledek je
+ * shodny s ImageFilter::glass.
+ *
+ * Snimek se deli na bloky velikosti bunky mrizky (10x10). Seminko bunky
+ * zavisi jen na souctu jasu bunky a nejblizsi seminko pixelu lezi vzdy
+ * v nekolika okolnich bunkach (kandidati bloku), takze:
+ *  - soucet jasu a seminko se prepocita jen u bloku, ktere se zmenily,
+ *  - prirazeni pixelu seminkum jen u bloku, jejichz kandidat se posunul,
+ *  - soucty barev regionu se u zmenenych bloku upravi odectenim puvodnich
+ *    a prictenim novych prispevku pixelu.
+ * Pri zmene vetsiny bloku se soucty regionu spocitaji znovu.
+ */
+class IncrementalGlass
+{
+    public:
+
+        // Velikost bunky mrizky (jako v ImageFilter::glass)
+        static const int REGION_SIZE = 10;
+
+        // Kandidati lezi nejvyse o tolik bunek od bloku (nejvetsi vzdalenost
+        // pixelu od seminka vlastni bunky je 38 u rohoveho bloku bez seminka)
+        static const int SEARCH_CELLS = 4;
+
+    private:
+
+        cv::Size mSize;
+        int mCellCols;
+        int mCellRows;
+        int mBlockCols;
+        int mBlockRows;
+        bool mValid;
+        int mUpdatedBlocks;
+
+        cv::Mat mPrevious;                     // vstup predchoziho snimku
+        cv::Mat mLabels;                       // index seminka pixelu
+        std::vector<int> mSeedX;
+        std::vector<int> mSeedY;
+        std::vector<int> mSums;                // radky B, G, R, pocet pixelu (po seminkach)
+        std::vector<int> mColors;              // prumerne barvy regionu (B, G, R)
+        std::vector<int> mCandidateStart;      // kandidati bloku b: [start[b], start[b + 1])
+        std::vector<int> mCandidates;          // indexy seminek vzestupne
+        std::vector<unsigned char> mChanged;   // blok se zmenil
+        std::vector<unsigned char> mMoved;     // seminko bunky se posunulo
+        std::vector<unsigned char> mRelabel;   // blok ma posunuteho kandidata
+
+    public:
+
+        IncrementalGlass();
+
+        void filter(const cv::Mat& src, cv::Mat& dst);
+        void reset();
+
+        int blockCount() const;
+        int updatedBlocks() const;
+
+        static void seedOffset(int value, int* x, int* y);
+        static bool isCandidate(int bx, int by, int cx, int cy, int cellCols, int cellRows);
+
+    private:
+
+        void initialize(cv::Size size);
+        void findCandidates();
+        bool updateSeed(const cv::Mat& src, int cx, int cy);
+        void labelBlock(const KernelDispatch::Kernels& kernels, int bx, int by);
+        void addBlock(const cv::Mat& src, int bx, int by, int sign);
+        void sumRegions(const cv::Mat& src);
+        cv::Rect blockRect(int bx, int by) const;
+};
+
+#endif	/* INCREMENTALGLASS_H */
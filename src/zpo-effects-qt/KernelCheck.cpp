@@ -0,0 +1,382 @@
+/*
+ * Soubor: KernelCheck.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "KernelCheck.h"
+
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Stencil3x3.h"
+#include "PixelExpr.h"
+
+typedef std::vector<unsigned char> Bytes;
+
+/**
+ * Porovnani filtrace radku maskou 3x3 dvema variantami.
+ *
+ * @param stencil testovana funkce
+ * @param reference referencni funkce
+ * @param rows radek nad, radek a radek pod
+ * @param width sirka v pixelech
+ * @param channels pocet kanalu
+ * @return true - shodny vysledek
+ */
+static bool sameStencil(KernelDispatch::StencilU8 stencil, KernelDispatch::StencilU8 reference,
+                        const std::vector<Bytes>& rows, int width, int channels)
+{
+    Bytes out(channels * width);
+    Bytes expected(channels * width);
+
+    stencil(rows[0].data(), rows[1].data(), rows[2].data(), out.data(), width);
+    reference(rows[0].data(), rows[1].data(), rows[2].data(), expected.data(), width);
+
+    return out == expected;
+}
+
+/**
+ * Porovnani rozostreni radku maskou 5x5 dvema variantami.
+ *
+ * @param blur testovana funkce
+ * @param reference referencni funkce
+ * @param rows radky y - 2 az y + 2
+ * @param width sirka v pixelech
+ * @param channels pocet kanalu
+ * @return true - shodny vysledek
+ */
+static bool sameBlur(KernelDispatch::BlurU8 blur, KernelDispatch::BlurU8 reference,
+                     const std::vector<Bytes>& rows, int width, int channels)
+{
+    const unsigned char* rowPointers[5];
+    for (int i = 0; i < 5; i++)
+    {
+        rowPointers[i] = rows[i].data();
+    }
+
+    Bytes out(channels * width);
+    Bytes expected(channels * width);
+
+    blur(rowPointers, out.data(), width);
+    reference(rowPointers, expected.data(), width);
+
+    return out == expected;
+}
+
+/**
+ * Nejvetsi odchylka celociselne velikosti gradientu od vypoctu ve float
+ * pres vsechny gradienty, ktere muze dat maska 3x3 s koeficienty do 2
+ * (|dx|, |dy| <= 4 * 255).
+ *
+ * @param pairs vystupni pocet overenych dvojic
+ * @return nejvetsi absolutni odchylka
+ */
+static int magnitudeError(long* pairs)
+{
+    const int range = 4 * 255;
+    int maxError = 0;
+
+    *pairs = 0;
+
+    for (int dx = -range; dx <= range; dx++)
+    {
+        for (int dy = -range; dy <= range; dy++)
+        {
+            int error = PixelExpr::magnitudeFixed(dx, dy) - PixelExpr::magnitudeFloat(dx, dy);
+            error = error < 0 ? -error : error;
+            maxError = error > maxError ? error : maxError;
+        }
+        *pairs += 2 * range + 1;
+    }
+
+    return maxError;
+}
+
+/**
+ * Spusteni kontroly. Kazda varianta se porovna se skalarni pro delky
+ * radku kolem hranic vektoru a pro jeden dlouhy radek, pro kazdou delku
+ * se zadanym poctem nahodnych vstupu.
+ *
+ * @param commandLine argumenty prikazove radky
+ * @return 0 - vsechny varianty davaji shodny vysledek
+ */
+int KernelCheck::run(const CommandLine& commandLine)
+{
+    const int widths[] = {1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33,
+                          63, 64, 65, 127, 128, 129, 1920};
+
+    const KernelDispatch::Kernels& reference = KernelDispatch::scalar();
+
+    std::cout << "active kernels: " << KernelDispatch::active().name << std::endl;
+
+    char line[256];
+    snprintf(line, sizeof(line), "%-10s %8s %6s  %s", "kernels", "rows", "result", "mismatch");
+    std::cout << line << std::endl;
+
+    int failed = 0;
+
+    for (const KernelDispatch::Kernels* kernels : KernelDispatch::available())
+    {
+        std::string mismatch;
+        int rows = 0;
+
+        for (int width : widths)
+        {
+            for (int i = 0; i < commandLine.getIterations() && mismatch.empty(); i++)
+            {
+                mismatch = compare(*kernels, reference, width, width * 1000 + i);
+                rows++;
+            }
+        }
+
+        bool ok = mismatch.empty();
+        failed += ok ? 0 : 1;
+
+        snprintf(line, sizeof(line), "%-10s %8d %6s  %s",
+                 kernels->name, rows, ok ? "OK" : "FAIL", mismatch.c_str());
+        std::cout << line << std::endl;
+    }
+
+    // Mez chyby celociselneho rezimu (ZPO_ARITHMETIC=fixed) je 0
+    long pairs = 0;
+    int error = magnitudeError(&pairs);
+    failed += error == 0 ? 0 : 1;
+
+    std::cout << "fixed-point magnitude: " << pairs << " gradients, max error " << error
+              << (error == 0 ? " (OK)" : " (FAIL)") << std::endl;
+
+    return failed == 0 ? 0 : 1;
+}
+
+/**
+ * Porovnani vsech funkci dvou variant na jednom nahodnem vstupu.
+ *
+ * @param kernels testovana varianta
+ * @param reference referencni varianta
+ * @param width delka radku v pixelech
+ * @param seed seminko generatoru vstupu
+ * @return popis prvni neshody, prazdny retezec pri shode
+ */
+std::string KernelCheck::compare(const KernelDispatch::Kernels& kernels,
+                                 const KernelDispatch::Kernels& reference,
+                                 int width, unsigned int seed)
+{
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<int> byte(0, 255);
+
+    std::vector<Bytes> gray(5, Bytes(width));
+    std::vector<Bytes> bgr(5, Bytes(3 * width));
+    Bytes table(256);
+
+    for (Bytes& row : gray)
+    {
+        for (unsigned char& value : row)
+        {
+            value = (unsigned char) byte(random);
+        }
+    }
+    for (Bytes& row : bgr)
+    {
+        for (unsigned char& value : row)
+        {
+            value = (unsigned char) byte(random);
+        }
+    }
+    for (unsigned char& value : table)
+    {
+        value = (unsigned char) byte(random);
+    }
+
+    if (!sameStencil(kernels.edgeLeft, reference.edgeLeft, gray, width, 1))
+    {
+        return "edgeLeft";
+    }
+    if (!sameStencil(kernels.edgeRight, reference.edgeRight, gray, width, 1))
+    {
+        return "edgeRight";
+    }
+    if (!sameStencil(kernels.edgeDown, reference.edgeDown, gray, width, 1))
+    {
+        return "edgeDown";
+    }
+    if (!sameStencil(kernels.edgeUp, reference.edgeUp, gray, width, 1))
+    {
+        return "edgeUp";
+    }
+    if (!sameStencil(kernels.edgeFourDir, reference.edgeFourDir, gray, width, 1))
+    {
+        return "edgeFourDir";
+    }
+    if (!sameStencil(kernels.prewittMagnitude, reference.prewittMagnitude, gray, width, 1))
+    {
+        return "prewittMagnitude";
+    }
+    if (!sameStencil(kernels.sobelMagnitude, reference.sobelMagnitude, gray, width, 1))
+    {
+        return "sobelMagnitude";
+    }
+    if (!sameStencil(kernels.prewittMagnitudeFixed, reference.prewittMagnitude, gray, width, 1))
+    {
+        return "prewittMagnitudeFixed";
+    }
+    if (!sameStencil(kernels.sobelMagnitudeFixed, reference.sobelMagnitude, gray, width, 1))
+    {
+        return "sobelMagnitudeFixed";
+    }
+    if (!sameStencil(kernels.emboss, reference.emboss, bgr, width, 3))
+    {
+        return "emboss";
+    }
+    if (!sameBlur(kernels.meanBlur, reference.meanBlur, bgr, width, 3))
+    {
+        return "meanBlur";
+    }
+    if (!sameBlur(kernels.gaussianBlur, reference.gaussianBlur, bgr, width, 3))
+    {
+        return "gaussianBlur";
+    }
+    if (!sameBlur(kernels.meanBlurPlanar, reference.meanBlurPlanar, gray, width, 1))
+    {
+        return "meanBlurPlanar";
+    }
+    if (!sameBlur(kernels.gaussianBlurPlanar, reference.gaussianBlurPlanar, gray, width, 1))
+    {
+        return "gaussianBlurPlanar";
+    }
+
+    Bytes out(3 * width);
+    Bytes expected(3 * width);
+
+    kernels.addEdgeColor(gray[0].data(), gray[1].data(), gray[2].data(), bgr[0].data(),
+                         out.data(), width);
+    reference.addEdgeColor(gray[0].data(), gray[1].data(), gray[2].data(), bgr[0].data(),
+                           expected.data(), width);
+    if (out != expected)
+    {
+        return "addEdgeColor";
+    }
+
+    kernels.replaceEdges(bgr[0].data(), gray[0].data(), table.data(), out.data(), width, 220, 30);
+    reference.replaceEdges(bgr[0].data(), gray[0].data(), table.data(), expected.data(),
+                           width, 220, 30);
+    if (out != expected)
+    {
+        return "replaceEdges";
+    }
+
+    if (kernels.sad(gray[0].data(), gray[1].data(), width)
+            != reference.sad(gray[0].data(), gray[1].data(), width)
+        || kernels.sad(bgr[0].data(), bgr[2].data(), 3 * width)
+            != reference.sad(bgr[0].data(), bgr[2].data(), 3 * width))
+    {
+        return "sad";
+    }
+
+    // Planarni varianty: roviny vstupu bgr[0] a ocekavany vysledek podle
+    // prokladane skalarni varianty
+    std::vector<Bytes> planes(9, Bytes(width));
+    for (int r = 0; r < 3; r++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            for (int c = 0; c < 3; c++)
+            {
+                planes[3 * r + c][x] = bgr[r][3 * x + c];
+            }
+        }
+    }
+    const unsigned char* above[3] = {planes[0].data(), planes[1].data(), planes[2].data()};
+    const unsigned char* row[3] = {planes[3].data(), planes[4].data(), planes[5].data()};
+    const unsigned char* below[3] = {planes[6].data(), planes[7].data(), planes[8].data()};
+
+    // Vahy OpenCV 2.4
+    const KernelDispatch::GrayWeights weights = {1868, 9617, 4899, 14};
+
+    Bytes grayOut(width);
+    Bytes grayExpected(width);
+
+    kernels.grayPlanar(above, grayOut.data(), width, weights);
+    for (int x = 0; x < width; x++)
+    {
+        grayExpected[x] = (unsigned char) ((bgr[0][3 * x] * weights.b + bgr[0][3 * x + 1] * weights.g
+                                            + bgr[0][3 * x + 2] * weights.r
+                                            + (1 << (weights.shift - 1))) >> weights.shift);
+    }
+    if (grayOut != grayExpected)
+    {
+        return "grayPlanar";
+    }
+
+    kernels.embossGrayPlanar(above, row, below, grayOut.data(), width, weights);
+    reference.emboss(bgr[0].data(), bgr[1].data(), bgr[2].data(), expected.data(), width);
+    for (int x = 0; x < width; x++)
+    {
+        grayExpected[x] = (unsigned char) ((expected[3 * x] * weights.b + expected[3 * x + 1] * weights.g
+                                            + expected[3 * x + 2] * weights.r
+                                            + (1 << (weights.shift - 1))) >> weights.shift);
+    }
+    if (grayOut != grayExpected)
+    {
+        return "embossGrayPlanar";
+    }
+
+    std::vector<Bytes> planesOut(3, Bytes(width));
+    unsigned char* dst[3] = {planesOut[0].data(), planesOut[1].data(), planesOut[2].data()};
+
+    kernels.addEdgeColorPlanar(gray[0].data(), gray[1].data(), gray[2].data(), above, dst, width);
+    reference.addEdgeColor(gray[0].data(), gray[1].data(), gray[2].data(), bgr[0].data(),
+                           expected.data(), width);
+    for (int x = 0; x < width; x++)
+    {
+        out[3 * x] = planesOut[0][x];
+        out[3 * x + 1] = planesOut[1][x];
+        out[3 * x + 2] = planesOut[2][x];
+    }
+    if (out != expected)
+    {
+        return "addEdgeColorPlanar";
+    }
+
+    kernels.replaceEdgesPlanar(above, gray[0].data(), table.data(), out.data(), width, 220, 30);
+    reference.replaceEdges(bgr[0].data(), gray[0].data(), table.data(), expected.data(),
+                           width, 220, 30);
+    if (out != expected)
+    {
+        return "replaceEdgesPlanar";
+    }
+
+    // Seminka v mrizce jako u filtru glass, vcetne stejne vzdalenych
+    int seedCount = width / 10 + 1;
+    std::vector<int> seedX(seedCount);
+    std::vector<int> seedY(seedCount);
+    std::uniform_int_distribution<int> offset(0, 9);
+
+    for (int s = 0; s < seedCount; s++)
+    {
+        seedX[s] = (s * 10 + offset(random)) % width;
+        seedY[s] = offset(random);
+    }
+
+    int y = offset(random);
+    std::vector<int> labels(width);
+    std::vector<int> distances(width);
+    std::vector<int> expectedLabels(width);
+    std::vector<int> expectedDistances(width);
+
+    kernels.nearestSeed(seedX.data(), seedY.data(), seedCount, y,
+                        labels.data(), distances.data(), width);
+    reference.nearestSeed(seedX.data(), seedY.data(), seedCount, y,
+                          expectedLabels.data(), expectedDistances.data(), width);
+    if (labels != expectedLabels || distances != expectedDistances)
+    {
+        return "nearestSeed";
+    }
+
+    return "";
+}
@@ -0,0 +1,36 @@
+/*
+ * Soubor: KernelCheck.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef KERNELCHECK_H
+#define	KERNELCHECK_H
+
+#include <string>
+
+#include "CommandLine.h"
+#include "KernelDispatch.h"
+
+/**
+ * Kontrola, ze vsechny varianty KernelDispatch podporovane procesorem
+ * davaji na nahodnych radcich ruznych delek stejny vysledek jako skalarni
+ * varianta.
+ */
+class KernelCheck
+{
+    public:
+
+        static int run(const CommandLine& commandLine);
+
+    private:
+
+        static std::string compare(const KernelDispatch::Kernels& kernels,
+                                   const KernelDispatch::Kernels& reference,
+                                   int width, unsigned int seed);
+};
+
+#endif	/* KERNELCHECK_H */
@@ -0,0 +1,156 @@
+/*
+ * Soubor: KernelDispatch.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "KernelDispatch.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+// Varianta nastavena pro aktualni vlakno (nullptr - vychozi varianta)
+static thread_local const KernelDispatch::Kernels* tLocalKernels = nullptr;
+
+/**
+ * Varianta pouzivana filtry: varianta nastavena pro aktualni vlakno, jinak
+ * vychozi varianta vybrana jednou, pri prvnim pouziti.
+ *
+ * @return tabulka funkci
+ */
+const KernelDispatch::Kernels& KernelDispatch::active()
+{
+    static const Kernels& kernels = select();
+
+    return tLocalKernels != nullptr ? *tLocalKernels : kernels;
+}
+
+/**
+ * Nastaveni varianty pro aktualni vlakno. Filtry ziskavaji tabulku
+ * funkci ve volajicim vlakne a ulohy planovace ji dostavaji od nich.
+ *
+ * @param kernels tabulka funkci (nullptr - vychozi varianta)
+ * @return predchozi nastaveni (pro obnoveni)
+ */
+const KernelDispatch::Kernels* KernelDispatch::setLocal(const Kernels* kernels)
+{
+    const Kernels* previous = tLocalKernels;
+    tLocalKernels = kernels;
+
+    return previous;
+}
+
+/**
+ * Skalarni varianta (bez vektorizace), referencni pro ostatni varianty.
+ *
+ * @return tabulka funkci
+ */
+const KernelDispatch::Kernels& KernelDispatch::scalar()
+{
+    return *scalarKernels();
+}
+
+/**
+ * Varianty prelozene v programu a podporovane procesorem, od nejjednodussi.
+ *
+ * @return tabulky funkci
+ */
+std::vector<const KernelDispatch::Kernels*> KernelDispatch::available()
+{
+    std::vector<const Kernels*> kernels;
+
+    for (const Kernels* variant : {scalarKernels(), sse4Kernels(), avx2Kernels(), avx512Kernels()})
+    {
+        if (variant != nullptr && isSupported(variant))
+        {
+            kernels.push_back(variant);
+        }
+    }
+
+    return kernels;
+}
+
+/**
+ * Nalezeni dostupne varianty podle nazvu.
+ *
+ * @param name nazev varianty
+ * @return tabulka funkci, nullptr - varianta neni dostupna
+ */
+const KernelDispatch::Kernels* KernelDispatch::find(const std::string& name)
+{
+    for (const Kernels* kernels : available())
+    {
+        if (name == kernels->name)
+        {
+            return kernels;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * Vyber varianty: ZPO_KERNELS, jinak posledni (nejlepsi) dostupna.
+ *
+ * @return tabulka funkci
+ */
+const KernelDispatch::Kernels& KernelDispatch::select()
+{
+    const char* forced = getenv("ZPO_KERNELS");
+
+    if (forced != nullptr && *forced != '\0')
+    {
+        const Kernels* kernels = find(forced);
+
+        if (kernels != nullptr)
+        {
+            return *kernels;
+        }
+
+        std::cerr << "ZPO_KERNELS: kernel variant '" << forced
+                  << "' is not available, using automatic selection" << std::endl;
+    }
+
+    return *available().back();
+}
+
+/**
+ * Test, zda procesor (a operacni system) podporuje instrukce varianty.
+ *
+ * @param kernels tabulka funkci
+ * @return true - variantu lze spustit
+ */
+bool KernelDispatch::isSupported(const Kernels* kernels)
+{
+    const char* name = kernels->name;
+
+    if (strcmp(name, "scalar") == 0)
+    {
+        return true;
+    }
+
+#ifdef KERNEL_DISPATCH_X86
+    __builtin_cpu_init();
+
+    if (strcmp(name, "sse4") == 0)
+    {
+        return __builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt");
+    }
+    if (strcmp(name, "avx2") == 0)
+    {
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")
+               && __builtin_cpu_supports("bmi2");
+    }
+    if (strcmp(name, "avx512") == 0)
+    {
+        return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")
+               && __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx512dq");
+    }
+#endif
+
+    return false;
+}
@@ -0,0 +1,162 @@
+/*
+ * Soubor: KernelDispatch.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef KERNELDISPATCH_H
+#define	KERNELDISPATCH_H
+
+#include <string>
+#include <vector>
+
+// Varianty pro rozsirene instrukcni sady umi prelozit jen GCC na x86
+// (#pragma GCC target), jinde je k dispozici jen skalarni varianta.
+#if defined(__GNUC__) && !defined(__clang__) && (defined(__x86_64__) || defined(__i386__))
+#define KERNEL_DISPATCH_X86 1
+#endif
+
+/**
+ * Vypocetni smycky filtru prelozene pro nekolik instrukcnich sad.
+ * Vsechny varianty vznikaji ze stejneho zdroje (KernelsImpl.hpp), pri
+ * spusteni se vybere nejlepsi varianta podporovana procesorem.
+ *
+ * Promenna prostredi ZPO_KERNELS (scalar, sse4, avx2, avx512) vynuti
+ * konkretni variantu, napr. pro testovani nebo srovnani vykonu.
+ *
+ * Variantu lze zmenit i jen pro aktualni vlakno (setLocal), napr. podle
+ * vysledku autotuningu pro dany filtr (Autotuner.h).
+ */
+class KernelDispatch
+{
+    public:
+
+        // Filtrace radku maskou 3x3 (Stencil3x3), radky above a below
+        // vybira volajici podle typu okraje
+        typedef void (*StencilU8)(const unsigned char* above, const unsigned char* row,
+                                  const unsigned char* below, unsigned char* dst, int width);
+
+        // Rozostreni radku maskou 5x5, rows jsou radky y - 2 az y + 2
+        // (vybira volajici podle typu okraje), okraj sloupcu REFLECT_101
+        typedef void (*BlurU8)(const unsigned char* const* rows, unsigned char* dst, int width);
+
+        // Vahy prevodu BGR -> sedotonovy obraz v pevne radove carce:
+        // gray = (b * B + g * G + r * R + 2^(shift - 1)) >> shift
+        struct GrayWeights
+        {
+            int b;
+            int g;
+            int r;
+            int shift;
+        };
+
+        /**
+         * Tabulka funkci jedne varianty. Vsechny funkce zpracuji jeden
+         * radek obrazu, obrazy jsou 8bitove, barevne ve formatu BGR.
+         */
+        struct Kernels
+        {
+            const char* name;
+
+            // Smerove hranove filtry (sedotonove, okraj REFLECT_101)
+            StencilU8 edgeLeft;
+            StencilU8 edgeRight;
+            StencilU8 edgeDown;
+            StencilU8 edgeUp;
+
+            // Prumer smerovych hranovych filtru (edgeGrayFourDir)
+            StencilU8 edgeFourDir;
+
+            // Velikost gradientu pro sobelGray (Prewitt) a sobelGray2 (Sobel)
+            StencilU8 prewittMagnitude;
+            StencilU8 sobelMagnitude;
+
+            // Totez jen v celych cislech (ZPO_ARITHMETIC=fixed), shodny vysledek
+            StencilU8 prewittMagnitudeFixed;
+            StencilU8 sobelMagnitudeFixed;
+
+            // Emboss barevneho obrazu (BGR, okraj WRAP)
+            StencilU8 emboss;
+
+            // Rozostreni BGR prumerem 5x5 (sobelColor) a gaussianem 5x5
+            // s vahami / 52 (comics), vysledek shodny s cv::filter2D
+            BlurU8 meanBlur;
+            BlurU8 gaussianBlur;
+
+            // Pricteni hran (edgeFourDir sedotonoveho obrazu) k barvam src
+            // (sobelColor), slabe hrany zatmavi pixel
+            void (*addEdgeColor)(const unsigned char* grayAbove, const unsigned char* grayRow,
+                                 const unsigned char* grayBelow, const unsigned char* src,
+                                 unsigned char* dst, int width);
+
+            // Nahrazeni pixelu, jejichz hrana je po prevodu tabulkou table
+            // silnejsi nez threshold, sedou barvou (comics)
+            void (*replaceEdges)(const unsigned char* src, const unsigned char* edge,
+                                 const unsigned char* table, unsigned char* dst,
+                                 int width, int threshold, int value);
+
+            // Index nejblizsiho seminka (manhattanska vzdalenost) pro radek y
+            void (*nearestSeed)(const int* seedX, const int* seedY, int seedCount, int y,
+                                int* labels, int* distances, int width);
+
+            // Soucet absolutnich rozdilu dvou radku bajtu (zmeny mezi
+            // snimky, FrameProcessor)
+            int (*sad)(const unsigned char* a, const unsigned char* b, int length);
+
+            // Planarni varianty barevnych funkci (PlanarImage.h): barevne
+            // radky jsou pole tri ukazatelu na radky rovin B, G, R
+
+            // Prevod na sedotonovy obraz (jako cvtColor CV_BGR2GRAY)
+            void (*grayPlanar)(const unsigned char* const* src, unsigned char* dst, int width,
+                               const GrayWeights& weights);
+
+            // Emboss rovin (okraj WRAP) prevedeny na sedotonovy obraz
+            // (edgeGrayFourMax), emboss se neuklada
+            void (*embossGrayPlanar)(const unsigned char* const* above,
+                                     const unsigned char* const* row,
+                                     const unsigned char* const* below,
+                                     unsigned char* dst, int width, const GrayWeights& weights);
+
+            // addEdgeColor s planarnim vstupem i vystupem
+            void (*addEdgeColorPlanar)(const unsigned char* grayAbove, const unsigned char* grayRow,
+                                       const unsigned char* grayBelow,
+                                       const unsigned char* const* src,
+                                       unsigned char* const* dst, int width);
+
+            // replaceEdges s planarnim vstupem, vystup je prokladany BGR
+            // (prevod zpet se tak slouci s poslednim krokem filtru)
+            void (*replaceEdgesPlanar)(const unsigned char* const* src, const unsigned char* edge,
+                                       const unsigned char* table, unsigned char* dst,
+                                       int width, int threshold, int value);
+
+            // meanBlur a gaussianBlur jedne roviny
+            BlurU8 meanBlurPlanar;
+            BlurU8 gaussianBlurPlanar;
+        };
+
+    public:
+
+        static const Kernels& active();
+        static const Kernels& scalar();
+        static std::vector<const Kernels*> available();
+        static const Kernels* find(const std::string& name);
+
+        static const Kernels* setLocal(const Kernels* kernels);
+
+    private:
+
+        static const Kernels& select();
+        static bool isSupported(const Kernels* kernels);
+
+        // Definovano v KernelsScalar.cpp, KernelsSse4.cpp, ...; varianty,
+        // ktere nelze prelozit, vraci nullptr
+        static const Kernels* scalarKernels();
+        static const Kernels* sse4Kernels();
+        static const Kernels* avx2Kernels();
+        static const Kernels* avx512Kernels();
+};
+
+#endif	/* KERNELDISPATCH_H */
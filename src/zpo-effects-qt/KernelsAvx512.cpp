@@ -0,0 +1,40 @@
+/*
+ * Soubor: KernelsAvx512.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "KernelDispatch.h"
+
+#include <climits>
+#include <cmath>
+
+#ifdef KERNEL_DISPATCH_X86
+
+// AVX-512 F/BW/VL/DQ (Skylake-SP a novejsi)
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512bw,avx512vl,avx512dq,avx2,fma,bmi,bmi2")
+#pragma GCC optimize("tree-vectorize", "vect-cost-model=dynamic")
+
+#define KERNELS_NAMESPACE KernelsAvx512
+#define KERNELS_NAME "avx512"
+#include "KernelsImpl.hpp"
+
+#pragma GCC pop_options
+
+const KernelDispatch::Kernels* KernelDispatch::avx512Kernels()
+{
+    return &KernelsAvx512::kernels;
+}
+
+#else
+
+const KernelDispatch::Kernels* KernelDispatch::avx512Kernels()
+{
+    return nullptr;
+}
+
+#endif
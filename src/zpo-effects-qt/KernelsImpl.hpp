@@ -0,0 +1,454 @@
+/*
+ * Soubor: KernelsImpl.hpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+// Spolecny zdroj variant KernelDispatch::Kernels. Vklada se do KernelsScalar.cpp,
+// KernelsSse4.cpp, ... az za #pragma GCC target, proto sam nic nevklada;
+// potrebuje KernelDispatch.h, <climits> a <cmath>.
+//
+// Pred vlozenim musi byt definovano KERNELS_NAMESPACE a KERNELS_NAME.
+//
+// Smycky jsou psane bez vetveni a bez aliasu (__restrict), aby je prekladac
+// vektorizoval. Vsechny varianty musi dat bitove shodny vysledek se skalarni
+// variantou, proto se nepouzivaji operace s nepresnym zaokrouhlenim.
+
+namespace KERNELS_NAMESPACE
+{
+
+// Uvnitr jmenneho prostoru varianty, aby se instance sablon prelozene pro
+// ruzne instrukcni sady pri linkovani nesloucily
+#include "Stencil3x3.h"
+#include "PixelExpr.h"
+
+typedef unsigned char uchar;
+
+using PixelExpr::channel;
+using PixelExpr::absolute;
+using PixelExpr::evaluate;
+using PixelExpr::fixedMagnitude;
+using PixelExpr::load;
+using PixelExpr::lut;
+using PixelExpr::magnitude;
+using PixelExpr::saturate;
+using PixelExpr::select;
+using PixelExpr::stencil;
+
+static inline int absInt(int value)
+{
+    return value < 0 ? -value : value;
+}
+
+// Masky hranovych filtru v zapisu konvoluce (jako v ImageFilter.cpp)
+typedef Stencil3x3::Convolution< 1,  0, -1,
+                                 2,  0, -2,
+                                 1,  0, -1> EdgeLeft;
+typedef Stencil3x3::Convolution<-1,  0,  1,
+                                -2,  0,  2,
+                                -1,  0,  1> EdgeRight;
+typedef Stencil3x3::Convolution<-1, -2, -1,
+                                 0,  0,  0,
+                                 1,  2,  1> EdgeDown;
+typedef Stencil3x3::Convolution< 1,  2,  1,
+                                 0,  0,  0,
+                                -1, -2, -1> EdgeUp;
+typedef Stencil3x3::Convolution<-1,  0,  1,
+                                -1,  0,  1,
+                                -1,  0,  1> PrewittX;
+typedef Stencil3x3::Convolution<-1, -1, -1,
+                                 0,  0,  0,
+                                 1,  1,  1> PrewittY;
+typedef Stencil3x3::Convolution<-1,  0,  1,
+                                -2,  0,  2,
+                                -1,  0,  1> SobelX;
+typedef Stencil3x3::Convolution<-1, -2, -1,
+                                 0,  0,  0,
+                                 1,  2,  1> SobelY;
+
+// Emboss je v puvodnim kodu korelace
+typedef Stencil3x3::Correlation<-1, -1,  0,
+                                -1,  0,  1,
+                                 0,  1,  1> Emboss;
+
+template <typename Mask>
+static void edgeRow(const uchar* above, const uchar* row, const uchar* below,
+                    uchar* dst, int width)
+{
+    Stencil3x3::apply<Mask, Stencil3x3::Saturate<0>, 1, Stencil3x3::REFLECT_101>(
+        above, row, below, dst, width);
+}
+
+static void embossRow(const uchar* above, const uchar* row, const uchar* below,
+                      uchar* dst, int width)
+{
+    Stencil3x3::apply<Emboss, Stencil3x3::Saturate<128>, 3, Stencil3x3::WRAP>(
+        above, row, below, dst, width);
+}
+
+/**
+ * Prumer ctyr smerovych hranovych filtru (edgeGrayFourDir), kazdy
+ * saturovany na 0 az 255 jako samostatny filtr. Maska EdgeUp je -EdgeDown
+ * a EdgeLeft je -EdgeRight, saturate(v) + saturate(-v) = min(|v|, 255),
+ * staci proto dve masky (soucty se vejdou do 16 bitu).
+ */
+static inline auto fourDirEdges(const uchar* above, const uchar* row, const uchar* below)
+    -> decltype((min(absolute(stencil<EdgeDown>(above, row, below)), 255)
+                 + min(absolute(stencil<EdgeRight>(above, row, below)), 255)) >> 2)
+{
+    return (min(absolute(stencil<EdgeDown>(above, row, below)), 255)
+            + min(absolute(stencil<EdgeRight>(above, row, below)), 255)) >> 2;
+}
+
+static void edgeFourDirRow(const uchar* above, const uchar* row, const uchar* below,
+                           uchar* dst, int width)
+{
+    evaluate(fourDirEdges(above, row, below), dst, width);
+}
+
+template <typename MaskX, typename MaskY>
+static void magnitudeRow(const uchar* above, const uchar* row, const uchar* below,
+                         uchar* dst, int width)
+{
+    evaluate(magnitude(stencil<MaskX>(above, row, below), stencil<MaskY>(above, row, below)),
+             dst, width);
+}
+
+template <typename MaskX, typename MaskY>
+static void fixedMagnitudeRow(const uchar* above, const uchar* row, const uchar* below,
+                              uchar* dst, int width)
+{
+    evaluate(fixedMagnitude(stencil<MaskX>(above, row, below), stencil<MaskY>(above, row, below)),
+             dst, width);
+}
+
+/**
+ * Puvodni vypocet p + e * 0.299 < 255 ? p + e * 0.299 : 255 (s orezanim
+ * na cele cislo) je pro e <= 255 totozny s min(p + e * 299 / 1000, 255)
+ * v celociselne aritmetice. Deleni 1000 prekladac nevektorizuje, proto
+ * e * W / 1000 = (e * M) >> 16 s konstantou M overenou pro vsechna e 0 az 255
+ * (W = 299, 587, 114 -> M = 19595, 38468, 7472).
+ */
+static void addEdgeColor(const uchar* grayAbove, const uchar* grayRow, const uchar* grayBelow,
+                         const uchar* src, uchar* dst, int width)
+{
+    auto edge = fourDirEdges(grayAbove, grayRow, grayBelow);
+    auto weak = edge < 14;
+
+    evaluate(select(weak, 20, min(channel<3, 0>(src) + (edge * 19595 >> 16), 255)),
+             select(weak, 20, min(channel<3, 1>(src) + (edge * 38468 >> 16), 255)),
+             select(weak, 20, min(channel<3, 2>(src) + (edge * 7472 >> 16), 255)),
+             dst, width);
+}
+
+static void replaceEdges(const uchar* src, const uchar* edge, const uchar* table,
+                         uchar* dst, int width, int threshold, int value)
+{
+    auto strong = lut(table, load(edge)) > threshold;
+
+    evaluate(select(strong, value, channel<3, 0>(src)),
+             select(strong, value, channel<3, 1>(src)),
+             select(strong, value, channel<3, 2>(src)),
+             dst, width);
+}
+
+/**
+ * Vazeny soucet rovin B, G, R se zaokrouhlenim (weights jsou za behu
+ * konstantni, nasobeni se vektorizuje).
+ */
+template <typename B, typename G, typename R>
+static inline auto grayExpr(const B& b, const G& g, const R& r,
+                            const KernelDispatch::GrayWeights& weights)
+    -> decltype((b * 0 + g * 0 + r * 0 + 0) >> 0)
+{
+    return (b * weights.b + g * weights.g + r * weights.r
+            + (1 << (weights.shift - 1))) >> weights.shift;
+}
+
+static void grayPlanar(const uchar* const* src, uchar* dst, int width,
+                       const KernelDispatch::GrayWeights& weights)
+{
+    evaluate(grayExpr(load(src[0]), load(src[1]), load(src[2]), weights), dst, width);
+}
+
+static void embossGrayPlanar(const uchar* const* above, const uchar* const* row,
+                             const uchar* const* below, uchar* dst, int width,
+                             const KernelDispatch::GrayWeights& weights)
+{
+    evaluate(grayExpr(saturate(stencil<Emboss>(above[0], row[0], below[0]) + 128),
+                      saturate(stencil<Emboss>(above[1], row[1], below[1]) + 128),
+                      saturate(stencil<Emboss>(above[2], row[2], below[2]) + 128), weights),
+             dst, width, Stencil3x3::WRAP);
+}
+
+static void addEdgeColorPlanar(const uchar* grayAbove, const uchar* grayRow,
+                               const uchar* grayBelow, const uchar* const* src,
+                               uchar* const* dst, int width)
+{
+    auto edge = fourDirEdges(grayAbove, grayRow, grayBelow);
+    auto weak = edge < 14;
+
+    evaluate(select(weak, 20, min(load(src[0]) + (edge * 19595 >> 16), 255)),
+             select(weak, 20, min(load(src[1]) + (edge * 38468 >> 16), 255)),
+             select(weak, 20, min(load(src[2]) + (edge * 7472 >> 16), 255)),
+             dst[0], dst[1], dst[2], width);
+}
+
+static void replaceEdgesPlanar(const uchar* const* src, const uchar* edge, const uchar* table,
+                               uchar* dst, int width, int threshold, int value)
+{
+    auto strong = lut(table, load(edge)) > threshold;
+
+    evaluate(select(strong, value, load(src[0])),
+             select(strong, value, load(src[1])),
+             select(strong, value, load(src[2])),
+             dst, width);
+}
+
+// Rozostreni maskou 5x5 -----------------------------------------------------
+
+// Pocet pixelu radku zpracovanych najednou (svisle soucty sloupcu se drzi
+// v polich na zasobniku)
+static const int BLUR_CHUNK = 256;
+
+// Svisle casti masek 5x5 (radky rows[0] az rows[4]): prumer je soucet
+// peti radku, gaussian je soucet vnejsich radku s vodorovnymi vahami
+// 1 1 2 1 1 a vnitrnich s vahami 1 2 4 2 1 (stredni radek dvakrat)
+struct MeanColumn
+{
+    static inline int at(const uchar* const* rows, int i)
+    {
+        return rows[0][i] + rows[1][i] + rows[2][i] + rows[3][i] + rows[4][i];
+    }
+};
+
+struct GaussianOuterColumn
+{
+    static inline int at(const uchar* const* rows, int i)
+    {
+        return rows[0][i] + rows[4][i];
+    }
+};
+
+struct GaussianInnerColumn
+{
+    static inline int at(const uchar* const* rows, int i)
+    {
+        return rows[1][i] + 2 * rows[2][i] + rows[3][i];
+    }
+};
+
+/**
+ * Svisle soucty sloupcu x0 - 2 az x1 + 1 do pole column (prvni prvek patri
+ * sloupci x0 - 2), sloupce mimo radek se zrcadli (REFLECT_101). Svisly
+ * soucet zrcadleneho sloupce je soucet sloupce, na ktery se zrcadli.
+ */
+template <int Channels, typename Column>
+static inline void blurColumns(const uchar* const* rows, int* column, int x0, int x1, int width)
+{
+    int inside0 = x0 - 2 > 0 ? x0 - 2 : 0;
+    int inside1 = x1 + 2 < width ? x1 + 2 : width;
+    int base = (x0 - 2) * Channels;
+
+    for (int i = inside0 * Channels; i < inside1 * Channels; i++)
+    {
+        column[i - base] = Column::at(rows, i);
+    }
+
+    for (int x = x0 - 2; x < x1 + 2; x++)
+    {
+        if (x < inside0 || x >= inside1)
+        {
+            int source = Stencil3x3::borderIndex(x, width, Stencil3x3::REFLECT_101);
+
+            for (int c = 0; c < Channels; c++)
+            {
+                column[(x - x0 + 2) * Channels + c] = column[(source - x0 + 2) * Channels + c];
+            }
+        }
+    }
+}
+
+/**
+ * Prumer 5x5 stejne jako cv::filter2D s maskou 1/25 ve float. Soucet
+ * soucinu ve float se od S / 25 lisi o mene nez 0.001 a S / 25 (S cele)
+ * nelezi nikdy blize nez 0.02 k polovine, vysledek je tedy
+ * round(S / 25) = (2S + 25) / 50. Deleni 50 je (n * 20972) >> 20
+ * (overeno pro vsechna n do 2 * 25 * 255 + 25).
+ */
+template <int Channels>
+static void meanBlurRow(const uchar* const* rows, uchar* dst, int width)
+{
+    int column[(BLUR_CHUNK + 4) * Channels];
+
+    for (int x0 = 0; x0 < width; x0 += BLUR_CHUNK)
+    {
+        int x1 = x0 + BLUR_CHUNK < width ? x0 + BLUR_CHUNK : width;
+        int base = (x0 - 2) * Channels;
+
+        blurColumns<Channels, MeanColumn>(rows, column, x0, x1, width);
+
+        for (int i = x0 * Channels; i < x1 * Channels; i++)
+        {
+            const int* c = column + (i - base);
+            int sum = c[-2 * Channels] + c[-Channels] + c[0] + c[Channels] + c[2 * Channels];
+
+            dst[i] = (uchar) (((2 * sum + 25) * 20972) >> 20);
+        }
+    }
+}
+
+/**
+ * Pixel gaussianu, jehoz vazeny soucet W lezi presne na polovine
+ * (W / 52 = n + 0.5): vysledek cv::filter2D zavisi na zaokrouhleni
+ * soucinu a souctu ve float v poradi prvku masky, ktere se zde opakuje.
+ * Soucin prochazi pres volatile, aby ho prekladac se souctem nesloucil
+ * do FMA (jedno zaokrouhleni misto dvou, jiny vysledek).
+ */
+template <int Channels>
+static uchar gaussianTie(const uchar* const* rows, int x, int c, int width)
+{
+    static const int weights[5][5] = {
+        {1, 1, 2, 1, 1},
+        {1, 2, 4, 2, 1},
+        {2, 4, 8, 4, 2},
+        {1, 2, 4, 2, 1},
+        {1, 1, 2, 1, 1},
+    };
+
+    float sum = 0.0f;
+
+    for (int ky = 0; ky < 5; ky++)
+    {
+        for (int kx = 0; kx < 5; kx++)
+        {
+            int column = Stencil3x3::borderIndex(x + kx - 2, width, Stencil3x3::REFLECT_101);
+            volatile float product = (float) weights[ky][kx] / 52.0f
+                                     * (float) rows[ky][Channels * column + c];
+            sum += product;
+        }
+    }
+
+    return (uchar) std::lrint(sum);
+}
+
+/**
+ * Gaussian 5x5 (vahy / 52) stejne jako cv::filter2D s maskou ve float.
+ * Mimo polovinu je vysledek round(W / 52) = (W + 26) / 52 ze stejneho
+ * duvodu jako u prumeru (deleni 52 je (n * 20165) >> 20, overeno pro
+ * n do 52 * 255 + 26); pixely na polovine (asi 2 %) se dopocitaji
+ * presne ve float (gaussianTie).
+ */
+template <int Channels>
+static void gaussianBlurRow(const uchar* const* rows, uchar* dst, int width)
+{
+    int outer[(BLUR_CHUNK + 4) * Channels];
+    int inner[(BLUR_CHUNK + 4) * Channels];
+    uchar tie[BLUR_CHUNK * Channels];
+
+    for (int x0 = 0; x0 < width; x0 += BLUR_CHUNK)
+    {
+        int x1 = x0 + BLUR_CHUNK < width ? x0 + BLUR_CHUNK : width;
+        int base = (x0 - 2) * Channels;
+
+        blurColumns<Channels, GaussianOuterColumn>(rows, outer, x0, x1, width);
+        blurColumns<Channels, GaussianInnerColumn>(rows, inner, x0, x1, width);
+
+        for (int i = x0 * Channels; i < x1 * Channels; i++)
+        {
+            const int* a = outer + (i - base);
+            const int* b = inner + (i - base);
+            int sum = a[-2 * Channels] + a[-Channels] + 2 * a[0] + a[Channels] + a[2 * Channels]
+                      + b[-2 * Channels] + 2 * b[-Channels] + 4 * b[0] + 2 * b[Channels]
+                      + b[2 * Channels];
+            int rounded = ((sum + 26) * 20165) >> 20;
+
+            dst[i] = (uchar) rounded;
+            tie[i - x0 * Channels] = (uchar) (sum + 26 == 52 * rounded);
+        }
+
+        for (int i = x0 * Channels; i < x1 * Channels; i++)
+        {
+            if (tie[i - x0 * Channels])
+            {
+                dst[i] = gaussianTie<Channels>(rows, i / Channels, i % Channels, width);
+            }
+        }
+    }
+}
+
+/**
+ * Seminka v poradi indexu, pri shode vzdalenosti zustava seminko
+ * s nizsim indexem (ostra nerovnost).
+ */
+static void nearestSeed(const int* __restrict seedX, const int* __restrict seedY,
+                        int seedCount, int y, int* __restrict labels,
+                        int* __restrict distances, int width)
+{
+    for (int x = 0; x < width; x++)
+    {
+        distances[x] = INT_MAX;
+        labels[x] = 0;
+    }
+
+    for (int s = 0; s < seedCount; s++)
+    {
+        int sx = seedX[s];
+        int dy = absInt(seedY[s] - y);
+
+        for (int x = 0; x < width; x++)
+        {
+            int dist = absInt(sx - x) + dy;
+            bool closer = dist < distances[x];
+
+            distances[x] = closer ? dist : distances[x];
+            labels[x] = closer ? s : labels[x];
+        }
+    }
+}
+
+/**
+ * Soucet absolutnich rozdilu (prekladac ho vektorizuje na psadbw / vpsadbw).
+ */
+static int sad(const uchar* __restrict a, const uchar* __restrict b, int length)
+{
+    int sum = 0;
+
+    for (int i = 0; i < length; i++)
+    {
+        sum += absInt(a[i] - b[i]);
+    }
+
+    return sum;
+}
+
+static const KernelDispatch::Kernels kernels = {
+    KERNELS_NAME,
+    edgeRow<EdgeLeft>,
+    edgeRow<EdgeRight>,
+    edgeRow<EdgeDown>,
+    edgeRow<EdgeUp>,
+    edgeFourDirRow,
+    magnitudeRow<PrewittX, PrewittY>,
+    magnitudeRow<SobelX, SobelY>,
+    fixedMagnitudeRow<PrewittX, PrewittY>,
+    fixedMagnitudeRow<SobelX, SobelY>,
+    embossRow,
+    meanBlurRow<3>,
+    gaussianBlurRow<3>,
+    addEdgeColor,
+    replaceEdges,
+    nearestSeed,
+    sad,
+    grayPlanar,
+    embossGrayPlanar,
+    addEdgeColorPlanar,
+    replaceEdgesPlanar,
+    meanBlurRow<1>,
+    gaussianBlurRow<1>,
+};
+
+} // namespace KERNELS_NAMESPACE
@@ -0,0 +1,27 @@
+/*
+ * Soubor: KernelsScalar.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "KernelDispatch.h"
+
+#include <climits>
+#include <cmath>
+
+// Referencni varianta: zakladni instrukcni sada, bez vektorizace
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize("no-tree-vectorize")
+#endif
+
+#define KERNELS_NAMESPACE KernelsScalar
+#define KERNELS_NAME "scalar"
+#include "KernelsImpl.hpp"
+
+const KernelDispatch::Kernels* KernelDispatch::scalarKernels()
+{
+    return &KernelsScalar::kernels;
+}
@@ -0,0 +1,40 @@
+/*
+ * Soubor: KernelsSse4.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "KernelDispatch.h"
+
+#include <climits>
+#include <cmath>
+
+#ifdef KERNEL_DISPATCH_X86
+
+// SSE4.2 (Nehalem a novejsi)
+#pragma GCC push_options
+#pragma GCC target("sse4.2,popcnt")
+#pragma GCC optimize("tree-vectorize", "vect-cost-model=dynamic")
+
+#define KERNELS_NAMESPACE KernelsSse4
+#define KERNELS_NAME "sse4"
+#include "KernelsImpl.hpp"
+
+#pragma GCC pop_options
+
+const KernelDispatch::Kernels* KernelDispatch::sse4Kernels()
+{
+    return &KernelsSse4::kernels;
+}
+
+#else
+
+const KernelDispatch::Kernels* KernelDispatch::sse4Kernels()
+{
+    return nullptr;
+}
+
+#endif
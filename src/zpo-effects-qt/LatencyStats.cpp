@@ -0,0 +1,74 @@
+/*
+ * Soubor: LatencyStats.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "LatencyStats.h"
+
+#include <algorithm>
+
+/**
+ * Konstruktor.
+ *
+ * @param capacity pocet uchovavanych vzorku
+ */
+LatencyStats::LatencyStats(size_t capacity)
+    : mNext(0)
+    , mCount(0)
+{
+    mSamples.reserve(std::max(capacity, (size_t) 1));
+}
+
+/**
+ * Pridani vzorku, nejstarsi vzorek se pri plnem bufferu prepise.
+ *
+ * @param milliseconds latence
+ */
+void LatencyStats::add(double milliseconds)
+{
+    if (mSamples.size() < mSamples.capacity())
+    {
+        mSamples.push_back(milliseconds);
+    }
+    else
+    {
+        mSamples[mNext] = milliseconds;
+        mNext = (mNext + 1) % mSamples.size();
+    }
+
+    mCount++;
+}
+
+/**
+ * Percentil uchovanych vzorku (nejblizsi nizsi poradi).
+ *
+ * @param p percentil 0 az 100 (100 - maximum)
+ * @return latence, 0 - bez vzorku
+ */
+double LatencyStats::percentile(double p) const
+{
+    if (mSamples.empty())
+    {
+        return 0;
+    }
+
+    std::vector<double> sorted = mSamples;
+    size_t rank = std::min((size_t) (p / 100.0 * (sorted.size() - 1) + 0.5), sorted.size() - 1);
+    std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+
+    return sorted[rank];
+}
+
+/**
+ * Pocet vsech pridanych vzorku (i prepsanych).
+ *
+ * @return pocet vzorku
+ */
+long long LatencyStats::count() const
+{
+    return mCount;
+}
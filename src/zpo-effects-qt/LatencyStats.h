@@ -0,0 +1,37 @@
+/*
+ * Soubor: LatencyStats.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef LATENCYSTATS_H
+#define	LATENCYSTATS_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Posledni namerene latence (kruhovy buffer pevne velikosti) a jejich
+ * percentily. Neni vlaknove bezpecne, volajici zamyka sam.
+ */
+class LatencyStats
+{
+    private:
+
+        std::vector<double> mSamples;
+        size_t mNext;
+        long long mCount;
+
+    public:
+
+        explicit LatencyStats(size_t capacity = 4096);
+
+        void add(double milliseconds);
+        double percentile(double p) const;
+        long long count() const;
+};
+
+#endif	/* LATENCYSTATS_H */
@@ -0,0 +1,161 @@
+/*
+ * Soubor: LoadGenerator.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "LoadGenerator.h"
+
+#include <atomic>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "LatencyStats.h"
+#include "ServiceProtocol.h"
+
+/**
+ * Odeslani pozadavku FILTER a nacteni vysledku.
+ *
+ * @param fd socket
+ * @param image obrazek (BGR)
+ * @param filterType typ filtru
+ * @param result vystup (buffer se pouziva opakovane)
+ * @return false - chyba spojeni nebo odpoved s chybou
+ */
+static bool filterRemote(int fd, const cv::Mat& image, ImageFilter::Type filterType, cv::Mat& result)
+{
+    ServiceProtocol::Request request = ServiceProtocol::request(ServiceProtocol::FILTER, (int) filterType,
+                                                                image.size(), image.channels());
+    ServiceProtocol::Response response;
+
+    if (!ServiceProtocol::writeFully(fd, &request, sizeof(request))
+        || !ServiceProtocol::writePixels(fd, image)
+        || !ServiceProtocol::readFully(fd, &response, sizeof(response))
+        || !ServiceProtocol::isValid(response) || response.status != ServiceProtocol::OK)
+    {
+        return false;
+    }
+
+    result.create(response.height, response.width, CV_8UC(response.channels));
+
+    return ServiceProtocol::readPixels(fd, result);
+}
+
+/**
+ * Statistiky sluzby (prikaz STATS).
+ *
+ * @param path cesta k socketu
+ * @return text statistik, prazdny pri chybe
+ */
+static std::string remoteStatistics(const std::string& path)
+{
+    int fd = ServiceProtocol::connect(path);
+    ServiceProtocol::Request request = ServiceProtocol::request(ServiceProtocol::STATS, 0, cv::Size(), 0);
+    ServiceProtocol::Response response;
+    std::string text;
+
+    if (ServiceProtocol::writeFully(fd, &request, sizeof(request))
+        && ServiceProtocol::readFully(fd, &response, sizeof(response))
+        && ServiceProtocol::isValid(response))
+    {
+        text.resize(response.length);
+        if (!ServiceProtocol::readFully(fd, &text[0], text.size()))
+        {
+            text.clear();
+        }
+    }
+
+    ServiceProtocol::close(fd);
+
+    return text;
+}
+
+/**
+ * Spusteni mereni.
+ *
+ * @param commandLine argumenty prikazove radky (socket, filtr, velikost,
+ *                    pocet pozadavku a klientu)
+ * @return 0 - vsechny pozadavky uspely
+ */
+int LoadGenerator::run(const CommandLine& commandLine)
+{
+    const std::string& path = commandLine.getInputs().front();
+    ImageFilter::Type filterType = commandLine.getFilterTypes().front();
+    cv::Size size = commandLine.getSizes().empty() ? cv::Size(640, 480) : commandLine.getSizes().front();
+    int clients = commandLine.getWorkers();
+    int requests = commandLine.getIterations();
+
+    std::mutex mutex;
+    LatencyStats latency(clients * requests);
+    std::atomic<int> failed(0);
+    std::vector<std::thread> threads;
+
+    long long start = cv::getTickCount();
+
+    for (int c = 0; c < clients; c++)
+    {
+        threads.emplace_back([&] {
+            int fd = ServiceProtocol::connect(path);
+
+            if (fd < 0)
+            {
+                failed += requests;
+                return;
+            }
+
+            cv::Mat image(size, CV_8UC3);
+            cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(256));
+            cv::Mat result;
+
+            for (int i = 0; i < requests; i++)
+            {
+                long long begin = cv::getTickCount();
+
+                if (!filterRemote(fd, image, filterType, result))
+                {
+                    failed += requests - i;
+                    break;
+                }
+
+                double milliseconds = (cv::getTickCount() - begin) * 1000.0 / cv::getTickFrequency();
+
+                std::lock_guard<std::mutex> lock(mutex);
+                latency.add(milliseconds);
+            }
+
+            ServiceProtocol::close(fd);
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    double seconds = (cv::getTickCount() - start) / cv::getTickFrequency();
+
+    char line[256];
+    snprintf(line, sizeof(line), "%s %dx%d, %d clients: %lld requests in %.2f s, %.1f req/s",
+             ImageFilter::typeName(filterType), size.width, size.height, clients,
+             latency.count(), seconds, seconds > 0 ? latency.count() / seconds : 0.0);
+    std::cout << line << std::endl;
+
+    snprintf(line, sizeof(line), "latency ms: p50 %.3f  p95 %.3f  p99 %.3f  max %.3f",
+             latency.percentile(50), latency.percentile(95), latency.percentile(99), latency.percentile(100));
+    std::cout << line << std::endl;
+
+    if (failed > 0)
+    {
+        std::cerr << failed << " requests failed" << std::endl;
+    }
+
+    std::cout << "service:" << std::endl << remoteStatistics(path);
+
+    return failed == 0 ? 0 : 1;
+}
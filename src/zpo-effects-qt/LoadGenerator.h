@@ -0,0 +1,28 @@
+/*
+ * Soubor: LoadGenerator.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef LOADGENERATOR_H
+#define	LOADGENERATOR_H
+
+#include "CommandLine.h"
+
+/**
+ * Klient filtrovaci sluzby (FilterService.h) pro mereni propustnosti
+ * a latence: --workers soubeznych klientu posila kazdy -n pozadavku
+ * s nahodnym obrazkem. Vypise pozadavky za sekundu, percentily latence
+ * u klientu a statistiky sluzby (STATS).
+ */
+class LoadGenerator
+{
+    public:
+
+        static int run(const CommandLine& commandLine);
+};
+
+#endif	/* LOADGENERATOR_H */
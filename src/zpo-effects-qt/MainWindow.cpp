@@ -18,15 +18,16 @@
 #include <QMessageBox>
 #include <QMetaObject>
 #include <QMetaEnum>
+#include <QStatusBar>
 #include <QVariant>
 
 #include "Debug.h"
+#include "MemoryTracker.h"
 #include "QListWidgetItemFilterType.hpp"
 
 MainWindow::MainWindow(QWidget *parent) 
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
-    , mLoadingDialog(nullptr)
 {
     ui->setupUi(this);
     
@@ -37,6 +38,7 @@ MainWindow::MainWindow(QWidget *parent)
     
     ui->listWidgetFilterType->setEnabled(false);
     ui->checkBoxScale->setEnabled(false);
+    ui->pushButtonSave->setEnabled(false);
     
     center();
     initImage();
@@ -55,6 +57,11 @@ void MainWindow::initImageViewer()
     connect(ui->checkBoxScale, SIGNAL(stateChanged(int)), ui->openGLWidget, SLOT(setScale(int)));
     connect(&mImageSource, SIGNAL(newImage(cv::Mat)), ui->openGLWidget, SLOT(showImage(cv::Mat)));
     connect(&mImageSource, SIGNAL(newImage(cv::Mat)), this, SLOT(imageFiltred()));
+    connect(&mImageSource, SIGNAL(newPreview(cv::Mat,int,int)), 
+            ui->openGLWidget, SLOT(showPreview(cv::Mat,int,int)));
+    connect(&mImageSource, SIGNAL(newPreview(cv::Mat,int,int)), this, SLOT(imageFiltred()));
+    connect(ui->openGLWidget, SIGNAL(viewportChanged(int,int,int,int,int,int)), 
+            &mImageSource, SLOT(setViewport(int,int,int,int,int,int)));
     
 //    connect(ui->checkBoxScale, SIGNAL(stateChanged(int)), ui->imageWidget, SLOT(setScale(int)));
 //    connect(&mImageSource, SIGNAL(newImage(cv::Mat)), ui->imageWidget, SLOT(showImage(cv::Mat)));
@@ -67,6 +74,12 @@ void MainWindow::initImageSource()
 {
     connect(&mImageSource, SIGNAL(errorMessage(std::string,std::string)), 
             this, SLOT(errorMessage(std::string,std::string)));
+    connect(&mImageSource, SIGNAL(filterStatistics(double,qint64,qint64,qint64)), 
+            this, SLOT(showFilterStatistics(double,qint64,qint64,qint64)));
+    connect(&mImageSource, SIGNAL(processingScale(double)), 
+            this, SLOT(showProcessingScale(double)));
+    
+    statusBar()->hide();
 }
 
 /**
@@ -227,9 +240,6 @@ void MainWindow::on_pushButtonImage_clicked()
             QMetaObject::invokeMethod(&mImageSource, "setImage", Q_ARG(cv::Mat, img));
             ui->listWidgetFilterType->setEnabled(false);
             ui->checkBoxScale->setEnabled(false);
-            mLoadingDialog = new LoadingDialog(this);
-            mLoadingDialog->show();
-            
         }
         else
         {
@@ -260,6 +270,32 @@ void MainWindow::on_pushButtonCam_clicked()
     QMetaObject::invokeMethod(&mImageSource, "setCamera");
 }
 
+/**
+ * Filtrace snimku ze sdilene pameti (--shm-input, --shm-output).
+ * 
+ * @param input nazev vstupniho bufferu
+ * @param output nazev vystupniho bufferu (prazdny - bez vystupu)
+ */
+void MainWindow::openSharedMemory(const std::string& input, const std::string& output)
+{
+    QMetaObject::invokeMethod(&mImageSource, "setSharedMemory", 
+                              Q_ARG(std::string, input), Q_ARG(std::string, output));
+}
+
+/**
+ * Reakce na stisk tlacitka pro ulozeni filtrovaneho obrazku. Obrazek se
+ * ulozi v plnem rozliseni, i kdyz se zobrazuje zmenseny.
+ */
+void MainWindow::on_pushButtonSave_clicked()
+{
+    QString fileName = QFileDialog::getSaveFileName(this, tr("Save image"));
+
+    if (!fileName.isNull())
+    {
+        QMetaObject::invokeMethod(&mImageSource, "saveImage", Q_ARG(std::string, fileName.toStdString()));
+    }
+}
+
 /**
  * Reakce na zmenu filtru.
  */
@@ -270,19 +306,63 @@ void MainWindow::on_listWidgetFilterType_currentItemChanged(QListWidgetItem *cur
     ImageFilter::Type filterType = static_cast<QListWidgetItemFilterType*>(current)->getFilterType();
     
     // Je nutny invokeMethod misto primeho volani, aby byl vypocet proveden
-    // v jinem vlakne a nezatezovat GUI.
+    // v jinem vlakne a nezatezovat GUI. U obrazku se hned zobrazi nahled,
+    // seznam filtru proto zustava povoleny (dalsi volba zrusi rozpracovany
+    // vypocet plneho rozliseni).
     QMetaObject::invokeMethod(&mImageSource, 
                              "setFilterType",
                              Qt::QueuedConnection, 
                              Q_ARG(ImageFilter::Type, filterType));
+}
+
+/**
+ * Zapnuti/vypnuti zobrazeni statistik filtrace ve stavovem radku.
+ * 
+ * @param checked true - zobrazovat statistiky
+ */
+void MainWindow::on_checkBoxStatistics_toggled(bool checked)
+{
+    QMetaObject::invokeMethod(&mImageSource, 
+                              "setStatisticsEnabled",
+                              Qt::QueuedConnection, 
+                              Q_ARG(bool, checked));
+    
+    statusBar()->clearMessage();
+    statusBar()->setVisible(checked);
+}
+
+/**
+ * Zobrazeni statistik posledni filtrace ve stavovem radku.
+ * 
+ * @param milliseconds doba filtrace
+ * @param allocatedBytes celkem alokovano behem filtrace
+ * @param allocations pocet alokaci
+ * @param peakBytes spicka zive alokovane pameti
+ */
+void MainWindow::showFilterStatistics(double milliseconds, qint64 allocatedBytes, 
+                                      qint64 allocations, qint64 peakBytes)
+{
+    QString msg = QString("Filter: %1 ms").arg(milliseconds, 0, 'f', 1);
     
-    if (mImageSource.getSourceType() == ImageSource::SourceType::IMAGE)
+    if (MemoryTracker::isSupported())
     {
-        ui->listWidgetFilterType->setEnabled(false);
-        ui->checkBoxScale->setEnabled(false);
-        mLoadingDialog = new LoadingDialog(this);
-        mLoadingDialog->show();
+        msg += QString(", allocated %1 MB in %2 blocks, peak %3 MB")
+                .arg(allocatedBytes / (1024.0 * 1024.0), 0, 'f', 1)
+                .arg(allocations)
+                .arg(peakBytes / (1024.0 * 1024.0), 0, 'f', 1);
     }
+    
+    statusBar()->showMessage(msg);
+}
+
+/**
+ * Zobrazeni meritka, ve kterem se filtruji snimky videa nebo kamery.
+ * 
+ * @param scale meritko (1 - plne rozliseni)
+ */
+void MainWindow::showProcessingScale(double scale)
+{
+    ui->labelResolution->setText(QString("Resolution: %1 %").arg(qRound(scale * 100)));
 }
 
 /**
@@ -297,17 +377,11 @@ void MainWindow::errorMessage(std::string title, std::string msg)
 }
 
 /**
- * Reakce na dokonceni filtrace obrazku.
+ * Reakce na dokonceni filtrace obrazku (nebo jeho nahledu).
  */
 void MainWindow::imageFiltred()
 {
     ui->listWidgetFilterType->setEnabled(true);
     ui->checkBoxScale->setEnabled(true);
-    
-    if (mLoadingDialog != nullptr)
-    {
-        mLoadingDialog->close();
-        delete mLoadingDialog;
-        mLoadingDialog = nullptr;
-    }
+    ui->pushButtonSave->setEnabled(mImageSource.getSourceType() == ImageSource::SourceType::IMAGE);
 }
@@ -16,7 +16,6 @@
 #include <QListWidgetItem>
 
 #include "ImageSource.h"
-#include "LoadingDialog.h"
 
 namespace Ui
 {
@@ -31,23 +30,30 @@ class MainWindow : public QMainWindow
         
         Ui::MainWindow *ui;
         ImageSource mImageSource;
-        LoadingDialog* mLoadingDialog;
         
     public:
         
         explicit MainWindow(QWidget *parent = 0);
         ~MainWindow();
+        
+        void openSharedMemory(const std::string& input, const std::string& output);
 
     private slots:
         
         void on_pushButtonImage_clicked();
         void on_pushButtonVideo_clicked();
         void on_pushButtonCam_clicked();
+        void on_pushButtonSave_clicked();
 
         void on_listWidgetFilterType_currentItemChanged(QListWidgetItem *current, QListWidgetItem *previous);
         
+        void on_checkBoxStatistics_toggled(bool checked);
+        
         void errorMessage(std::string title, std::string msg);
         void imageFiltred();
+        void showFilterStatistics(double milliseconds, qint64 allocatedBytes, 
+                                  qint64 allocations, qint64 peakBytes);
+        void showProcessingScale(double scale);
         
     private:
         
@@ -0,0 +1,381 @@
+/*
+ * Soubor: MemoryTracker.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "MemoryTracker.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+
+#if defined(__GLIBC__)
+    #include <malloc.h> // malloc_usable_size
+    #define MEMORY_TRACKER_MALLOC
+#elif defined(_WIN32)
+    #include <malloc.h> // _msize
+    #define MEMORY_TRACKER_NEW
+#endif
+
+/**
+ * Citace jednoho mereni. Zapisuje do nich vlakno mereni i pracovni vlakna
+ * planovace, proto jsou atomicke.
+ */
+struct MemoryTracker::Measurement
+{
+    std::atomic<long long> allocatedBytes{0};
+    std::atomic<long long> allocations{0};
+    std::atomic<long long> liveBytes{0};
+    std::atomic<long long> peakBytes{0};
+    Measurement* previous = nullptr; // mereni aktivni pred start()
+};
+
+namespace
+{
+    // Pocet probihajicich mereni, bez mereni se alokace nezaznamenavaji
+    // (ani se nezjistuje velikost bloku)
+    std::atomic<int> gActive(0);
+
+    // Vlastni mereni vlakna (start/stop)
+    thread_local MemoryTracker::Measurement tOwn;
+
+    // Mereni, kteremu se pripisuji alokace vlakna (nullptr - zadne)
+    thread_local MemoryTracker::Measurement* tMeasurement = nullptr;
+
+    /**
+     * Mereni, kteremu se pripise alokace aktualniho vlakna.
+     *
+     * @return mereni, nullptr - alokace se nepocita
+     */
+    inline MemoryTracker::Measurement* activeMeasurement()
+    {
+        if (gActive.load(std::memory_order_relaxed) == 0)
+        {
+            return nullptr;
+        }
+
+        return tMeasurement;
+    }
+
+    /**
+     * Zaznam nove alokace.
+     *
+     * @param measurement mereni
+     * @param size skutecna velikost bloku
+     */
+    inline void recordAllocation(MemoryTracker::Measurement& measurement, size_t size)
+    {
+        measurement.allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+        measurement.allocations.fetch_add(1, std::memory_order_relaxed);
+
+        long long live = measurement.liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+        long long peak = measurement.peakBytes.load(std::memory_order_relaxed);
+
+        while (live > peak
+               && !measurement.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    /**
+     * Zaznam uvolneni bloku. Bloky alokovane pred start() snizuji zivou
+     * pamet pod nulu, coz je v poradku - spicka se meri od startu.
+     *
+     * @param measurement mereni
+     * @param size skutecna velikost bloku
+     */
+    inline void recordFree(MemoryTracker::Measurement& measurement, size_t size)
+    {
+        measurement.liveBytes.fetch_sub(size, std::memory_order_relaxed);
+    }
+}
+
+#if defined(MEMORY_TRACKER_MALLOC)
+
+// Nahrazeni alokatoru glibc. Puvodni implementace jsou dostupne pod
+// jmeny __libc_*, takze neni treba dlsym (ktery by sam alokoval).
+extern "C"
+{
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* ptr, size_t size);
+    void* __libc_memalign(size_t alignment, size_t size);
+    void __libc_free(void* ptr);
+}
+
+/**
+ * Zaznam alokace bloku, pokud vlakno meri.
+ *
+ * @param ptr alokovany blok (nebo nullptr)
+ */
+static inline void recordBlock(void* ptr)
+{
+    MemoryTracker::Measurement* measurement = activeMeasurement();
+
+    if (measurement != nullptr && ptr != nullptr)
+    {
+        recordAllocation(*measurement, malloc_usable_size(ptr));
+    }
+}
+
+extern "C"
+{
+    void* malloc(size_t size)
+    {
+        void* ptr = __libc_malloc(size);
+        recordBlock(ptr);
+
+        return ptr;
+    }
+
+    void* calloc(size_t count, size_t size)
+    {
+        void* ptr = __libc_calloc(count, size);
+        recordBlock(ptr);
+
+        return ptr;
+    }
+
+    void* realloc(void* ptr, size_t size)
+    {
+        MemoryTracker::Measurement* measurement = activeMeasurement();
+
+        if (measurement == nullptr)
+        {
+            return __libc_realloc(ptr, size);
+        }
+
+        size_t oldSize = ptr != nullptr ? malloc_usable_size(ptr) : 0;
+        void* newPtr = __libc_realloc(ptr, size);
+
+        if (newPtr != nullptr)
+        {
+            recordFree(*measurement, oldSize);
+            recordAllocation(*measurement, malloc_usable_size(newPtr));
+        }
+        else if (size == 0)
+        {
+            recordFree(*measurement, oldSize); // realloc(ptr, 0) uvolnuje blok
+        }
+
+        return newPtr;
+    }
+
+    void* memalign(size_t alignment, size_t size)
+    {
+        void* ptr = __libc_memalign(alignment, size);
+        recordBlock(ptr);
+
+        return ptr;
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size)
+    {
+        return memalign(alignment, size);
+    }
+
+    int posix_memalign(void** memptr, size_t alignment, size_t size)
+    {
+        if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0)
+        {
+            return EINVAL;
+        }
+
+        void* ptr = memalign(alignment, size);
+
+        if (ptr == nullptr)
+        {
+            return ENOMEM;
+        }
+
+        *memptr = ptr;
+        return 0;
+    }
+
+    void free(void* ptr)
+    {
+        MemoryTracker::Measurement* measurement = activeMeasurement();
+
+        if (measurement != nullptr && ptr != nullptr)
+        {
+            recordFree(*measurement, malloc_usable_size(ptr));
+        }
+
+        __libc_free(ptr);
+    }
+}
+
+#elif defined(MEMORY_TRACKER_NEW)
+
+// Bez glibc lze prenositelne zachytit jen operator new/delete.
+
+/**
+ * Zaznam alokace bloku, pokud vlakno meri.
+ *
+ * @param ptr alokovany blok (nebo nullptr)
+ */
+static inline void recordBlock(void* ptr)
+{
+    MemoryTracker::Measurement* measurement = activeMeasurement();
+
+    if (measurement != nullptr && ptr != nullptr)
+    {
+        recordAllocation(*measurement, _msize(ptr));
+    }
+}
+
+void* operator new(size_t size)
+{
+    void* ptr = malloc(size == 0 ? 1 : size);
+
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    recordBlock(ptr);
+    return ptr;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    void* ptr = malloc(size == 0 ? 1 : size);
+    recordBlock(ptr);
+
+    return ptr;
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept
+{
+    return operator new(size, tag);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    MemoryTracker::Measurement* measurement = activeMeasurement();
+
+    if (measurement != nullptr && ptr != nullptr)
+    {
+        recordFree(*measurement, _msize(ptr));
+    }
+
+    free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    operator delete(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    operator delete(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    operator delete(ptr);
+}
+
+#endif
+
+/**
+ * Test, zda je na teto platforme mozne alokace pocitat.
+ *
+ * @return true - alokace jsou zachyceny
+ */
+bool MemoryTracker::isSupported()
+{
+#if defined(MEMORY_TRACKER_MALLOC) || defined(MEMORY_TRACKER_NEW)
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Vynulovani citacu a zahajeni mereni v aktualnim vlakne.
+ */
+void MemoryTracker::start()
+{
+    if (tMeasurement != &tOwn)
+    {
+        tOwn.previous = tMeasurement;
+        gActive.fetch_add(1);
+    }
+
+    tMeasurement = nullptr;
+    tOwn.allocatedBytes.store(0);
+    tOwn.allocations.store(0);
+    tOwn.liveBytes.store(0);
+    tOwn.peakBytes.store(0);
+    tMeasurement = &tOwn;
+}
+
+/**
+ * Ukonceni mereni v aktualnim vlakne. Alokace se dale pripisuji mereni,
+ * ktere bylo aktivni pred start() (napr. uloha planovace).
+ *
+ * @return namerene hodnoty
+ */
+MemoryTracker::Stats MemoryTracker::stop()
+{
+    if (tMeasurement == &tOwn)
+    {
+        tMeasurement = tOwn.previous;
+        gActive.fetch_sub(1);
+    }
+
+    return current();
+}
+
+/**
+ * Aktualni hodnoty citacu mereni aktualniho vlakna (i behem mereni).
+ *
+ * @return namerene hodnoty
+ */
+MemoryTracker::Stats MemoryTracker::current()
+{
+    Stats stats;
+    stats.allocatedBytes = tOwn.allocatedBytes.load();
+    stats.allocations = tOwn.allocations.load();
+    stats.peakBytes = tOwn.peakBytes.load();
+
+    return stats;
+}
+
+/**
+ * Mereni, kteremu se pripisuji alokace aktualniho vlakna. TaskScheduler si
+ * ho uklada do zadanych uloh.
+ *
+ * @return mereni, nullptr - vlakno nemeri
+ */
+MemoryTracker::Measurement* MemoryTracker::localMeasurement()
+{
+    return tMeasurement;
+}
+
+/**
+ * Pripisovani alokaci aktualniho vlakna jinemu mereni (pracovni vlakno
+ * planovace po dobu ulohy).
+ *
+ * @param measurement mereni (nullptr - alokace nepocitat)
+ * @return predchozi nastaveni (pro obnoveni)
+ */
+MemoryTracker::Measurement* MemoryTracker::setLocalMeasurement(Measurement* measurement)
+{
+    Measurement* previous = tMeasurement;
+    tMeasurement = measurement;
+
+    return previous;
+}
@@ -0,0 +1,51 @@
+/*
+ * Soubor: MemoryTracker.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef MEMORYTRACKER_H
+#define	MEMORYTRACKER_H
+
+/**
+ * Pocitani alokaci na halde mezi start() a stop().
+ *
+ * S glibc jsou zachyceny primo malloc/free (a tedy i operator new a buffery
+ * cv::Mat alokovane pres cv::fastMalloc), na Windows pouze operator new.
+ * Mereni patri vlaknu, ktere ho zahajilo: pocitaji se alokace tohoto vlakna
+ * a uloh TaskScheduler, ktere vlakno zadalo (parallelFor, TaskGroup::run),
+ * i kdyz je vykonavaji pracovni vlakna planovace. Alokace ostatnich vlaken
+ * se nepocitaji, mereni v ruznych vlaknech se tedy neovlivnuji. Mereni
+ * v jednom vlakne nelze vnorovat.
+ *
+ * Dokud zadne mereni nebezi, stoji zachyceni alokace jen jedno cteni
+ * globalniho citace.
+ */
+class MemoryTracker
+{
+    public:
+
+        struct Stats
+        {
+            long long allocatedBytes; /// soucet velikosti vsech alokaci
+            long long allocations;    /// pocet alokaci
+            long long peakBytes;      /// maximum zive pameti alokovane od start()
+        };
+
+        // Citace jednoho mereni (pro predani uloham planovace)
+        struct Measurement;
+
+        static bool isSupported();
+
+        static void start();
+        static Stats stop();
+        static Stats current();
+
+        static Measurement* localMeasurement();
+        static Measurement* setLocalMeasurement(Measurement* measurement);
+};
+
+#endif	/* MEMORYTRACKER_H */
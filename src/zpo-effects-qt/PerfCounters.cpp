@@ -0,0 +1,289 @@
+/*
+ * Soubor: PerfCounters.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "PerfCounters.h"
+
+#ifdef __linux__
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #include <cerrno>
+    #include <cstring>
+    #include <cstdint>
+#endif
+
+#include "TaskScheduler.h"
+
+PerfCounters::Sample::Sample()
+{
+    for (int i = 0; i < COUNTER_COUNT; i++)
+    {
+        value[i] = 0;
+        valid[i] = false;
+    }
+}
+
+/**
+ * Pricteni jineho vzorku, platnost zustava jen u citacu platnych v obou.
+ *
+ * @param other pricitany vzorek
+ * @return this
+ */
+PerfCounters::Sample& PerfCounters::Sample::operator+=(const Sample& other)
+{
+    for (int i = 0; i < COUNTER_COUNT; i++)
+    {
+        value[i] += other.value[i];
+        valid[i] = valid[i] && other.valid[i];
+    }
+
+    return *this;
+}
+
+PerfCounters::PerfCounters()
+    : mThreadCount(0)
+    , mOpen(false)
+{
+}
+
+PerfCounters::~PerfCounters()
+{
+    close();
+}
+
+/**
+ * Nazev citace pro vypisy.
+ *
+ * @param counter citac
+ * @return nazev citace
+ */
+const char* PerfCounters::counterName(Counter counter)
+{
+    switch (counter)
+    {
+        case CYCLES:        return "cycles";
+        case INSTRUCTIONS:  return "instructions";
+        case CACHE_MISSES:  return "LLC-misses";
+        case BRANCH_MISSES: return "branch-misses";
+        default:            return "?";
+    }
+}
+
+#ifdef __linux__
+
+/**
+ * Otevreni citacu pro aktualni vlakno a pracovni vlakna planovace. Citac,
+ * ktery nejde otevrit pro vsechna vlakna, se nepouzije vubec (castecny
+ * soucet by byl zavadejici).
+ *
+ * @return false - zadny citac neni k dispozici
+ */
+bool PerfCounters::open()
+{
+    static const uint64_t configs[COUNTER_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES, // v kernelu mapovano na LLC miss
+        PERF_COUNT_HW_BRANCH_MISSES
+    };
+
+    close();
+
+    // 0 - volajici vlakno
+    std::vector<int> threads(1, 0);
+    std::vector<int> workers = TaskScheduler::instance().workerThreadIds();
+    threads.insert(threads.end(), workers.begin(), workers.end());
+
+    int lastErrno = 0;
+
+    for (int i = 0; i < COUNTER_COUNT; i++)
+    {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = configs[i];
+        attr.disabled = 1;
+        attr.exclude_kernel = 1; // staci perf_event_paranoid <= 2
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        for (int thread : threads)
+        {
+            int fd = syscall(__NR_perf_event_open, &attr, thread, -1, -1, 0);
+
+            if (fd < 0)
+            {
+                lastErrno = errno;
+                break;
+            }
+
+            mFd[i].push_back(fd);
+        }
+
+        if (mFd[i].size() != threads.size())
+        {
+            for (int fd : mFd[i])
+            {
+                ::close(fd);
+            }
+            mFd[i].clear();
+        }
+        else
+        {
+            mOpen = true;
+        }
+    }
+
+    mThreadCount = mOpen ? (int) threads.size() : 0;
+
+    if (!mOpen)
+    {
+        mErrorMessage = std::string("perf_event_open: ") + strerror(lastErrno);
+
+        if (lastErrno == EACCES || lastErrno == EPERM)
+        {
+            mErrorMessage += " (check /proc/sys/kernel/perf_event_paranoid)";
+        }
+        else if (lastErrno == ENOENT || lastErrno == ENODEV || lastErrno == EOPNOTSUPP)
+        {
+            mErrorMessage += " (no PMU available, e.g. virtual machine)";
+        }
+    }
+
+    return mOpen;
+}
+
+/**
+ * Uzavreni citacu.
+ */
+void PerfCounters::close()
+{
+    for (int i = 0; i < COUNTER_COUNT; i++)
+    {
+        for (int fd : mFd[i])
+        {
+            ::close(fd);
+        }
+        mFd[i].clear();
+    }
+
+    mThreadCount = 0;
+    mOpen = false;
+}
+
+/**
+ * Vynulovani a spusteni citacu.
+ */
+void PerfCounters::start()
+{
+    for (int i = 0; i < COUNTER_COUNT; i++)
+    {
+        for (int fd : mFd[i])
+        {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+/**
+ * Zastaveni citacu a precteni hodnot (soucet vsech vlaken). Pri
+ * multiplexovani citacu jadrem jsou hodnoty prepocteny podle pomeru casu,
+ * kdy citac skutecne bezel. Vlakno, ktere behem mereni spalo, prispeje
+ * nulou.
+ *
+ * @return nactene hodnoty
+ */
+PerfCounters::Sample PerfCounters::stop()
+{
+    Sample sample;
+
+    for (int i = 0; i < COUNTER_COUNT; i++)
+    {
+        for (int fd : mFd[i])
+        {
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+
+    for (int i = 0; i < COUNTER_COUNT; i++)
+    {
+        for (int fd : mFd[i])
+        {
+            uint64_t data[3]; // hodnota, time_enabled, time_running
+
+            if (read(fd, data, sizeof(data)) != sizeof(data) || data[2] == 0)
+            {
+                continue; // vlakno nebezelo nebo se citac nedostal na PMU
+            }
+
+            double scale = (double) data[1] / (double) data[2];
+            sample.value[i] += (long long) (data[0] * scale);
+            sample.valid[i] = true;
+        }
+    }
+
+    return sample;
+}
+
+#else
+
+bool PerfCounters::open()
+{
+    mErrorMessage = "hardware counters are supported on Linux only";
+    return false;
+}
+
+void PerfCounters::close()
+{
+    mOpen = false;
+}
+
+void PerfCounters::start()
+{
+}
+
+PerfCounters::Sample PerfCounters::stop()
+{
+    return Sample();
+}
+
+#endif
+
+/**
+ * Test na otevrene citace.
+ *
+ * @return true - alespon jeden citac je otevren
+ */
+bool PerfCounters::isOpen() const
+{
+    return mOpen;
+}
+
+/**
+ * Pocet vlaken, jejichz hodnoty se scitaji.
+ *
+ * @return pocet vlaken (0 - citace nejsou otevrene)
+ */
+int PerfCounters::threadCount() const
+{
+    return mThreadCount;
+}
+
+/**
+ * Duvod, proc se citace nepodarilo otevrit.
+ *
+ * @return chybove hlaseni
+ */
+const std::string& PerfCounters::errorMessage() const
+{
+    return mErrorMessage;
+}
@@ -0,0 +1,77 @@
+/*
+ * Soubor: PerfCounters.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef PERFCOUNTERS_H
+#define	PERFCOUNTERS_H
+
+#include <string>
+#include <vector>
+
+/**
+ * Hardwarove citace vykonu (Linux perf_event_open) pro aktualni vlakno
+ * a vsechna pracovni vlakna planovace (TaskScheduler), na ktera se filtry
+ * rozdeluji. Hodnoty vsech vlaken se scitaji. Pracovni vlakna ale citaji
+ * i ulohy jinych vlaken, ktere bezi soucasne.
+ *
+ * Pokud citace nejsou k dispozici (jiny system, kontejner bez opravneni,
+ * virtualni stroj bez PMU), open() vrati false a errorMessage() obsahuje
+ * duvod. Jednotlive citace mohou chybet i samostatne (napr. LLC miss ve VM),
+ * proto ma kazda hodnota vlastni priznak platnosti.
+ */
+class PerfCounters
+{
+    public:
+
+        enum Counter
+        {
+            CYCLES,
+            INSTRUCTIONS,
+            CACHE_MISSES,
+            BRANCH_MISSES,
+            COUNTER_COUNT
+        };
+
+        struct Sample
+        {
+            long long value[COUNTER_COUNT];
+            bool valid[COUNTER_COUNT];
+
+            Sample();
+
+            Sample& operator+=(const Sample& other);
+        };
+
+    private:
+
+        std::vector<int> mFd[COUNTER_COUNT]; // deskriptor pro kazde vlakno
+        int mThreadCount;
+        bool mOpen;
+        std::string mErrorMessage;
+
+    public:
+
+        PerfCounters();
+        ~PerfCounters();
+
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        bool open();
+        void close();
+        bool isOpen() const;
+        int threadCount() const;
+        const std::string& errorMessage() const;
+
+        void start();
+        Sample stop();
+
+        static const char* counterName(Counter counter);
+};
+
+#endif	/* PERFCOUNTERS_H */
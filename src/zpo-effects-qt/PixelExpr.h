@@ -0,0 +1,490 @@
+/*
+ * Soubor: PixelExpr.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef PIXELEXPR_H
+#define	PIXELEXPR_H
+
+// Stejne jako Stencil3x3.h nic nevklada; musi byt vlozen az za Stencil3x3.h
+// (ve stejnem jmennem prostoru).
+
+/**
+ * Vyrazy nad pixely radku (expression templates). Vyraz jako
+ *
+ *      select(edge < 14, 20, min(channel<3, 0>(blur) + edge * 299 / 1000, 255))
+ *
+ * se pri prekladu slozi do jedine smycky pres radek, zadny mezivysledek se
+ * neuklada do pameti. Listy vyrazu jsou hodnoty radku (load, channel),
+ * konstanty a masky 3x3 (stencil), takze lze slucovat i hranove filtry
+ * s naslednymi bodovymi operacemi.
+ *
+ * Hodnoty jsou cela cisla (int), jen magnitude() pocita s float
+ * (fixedMagnitude() je celociselna varianta se stejnym vysledkem). Porovnani
+ * vraci masku 0 / -1, kterou pouziva select() bez vetveni (kvuli vektorizaci).
+ */
+// Slozene vyrazy (napr. prumer ctyr masek) by prekladac sam nevlozil
+// a smycka by se nevektorizovala
+#ifdef __GNUC__
+#define PIXELEXPR_INLINE inline __attribute__((always_inline))
+#else
+#define PIXELEXPR_INLINE inline
+#endif
+
+namespace PixelExpr
+{
+
+template <typename E>
+struct Expr
+{
+    const E& self() const
+    {
+        return static_cast<const E&>(*this);
+    }
+};
+
+// Listy ----------------------------------------------------------------------
+
+struct Constant : Expr<Constant>
+{
+    int value;
+
+    explicit Constant(int value) : value(value) {}
+
+    PIXELEXPR_INLINE int at(int, int, int) const
+    {
+        return value;
+    }
+};
+
+/**
+ * Hodnota jednokanaloveho radku.
+ */
+template <typename T>
+struct Load : Expr<Load<T> >
+{
+    const T* p;
+
+    explicit Load(const T* p) : p(p) {}
+
+    PIXELEXPR_INLINE int at(int x, int, int) const
+    {
+        return p[x];
+    }
+};
+
+/**
+ * Kanal C radku s Channels kanaly (BGR: Channels = 3, C = 0 modra).
+ */
+template <int Channels, int C>
+struct Channel : Expr<Channel<Channels, C> >
+{
+    const unsigned char* p;
+
+    explicit Channel(const unsigned char* p) : p(p) {}
+
+    PIXELEXPR_INLINE int at(int x, int, int) const
+    {
+        return p[Channels * x + C];
+    }
+};
+
+/**
+ * Vysledek masky 3x3 (Stencil3x3) na jednokanalovem radku.
+ */
+template <typename Mask>
+struct Stencil : Expr<Stencil<Mask> >
+{
+    typedef typename Stencil3x3::Select<Mask::RANGE <= 32767, short, int>::Type Accumulator;
+
+    const unsigned char* above;
+    const unsigned char* row;
+    const unsigned char* below;
+
+    Stencil(const unsigned char* above, const unsigned char* row, const unsigned char* below)
+        : above(above), row(row), below(below) {}
+
+    PIXELEXPR_INLINE int at(int x, int left, int right) const
+    {
+        return Mask::template apply<Accumulator>(above, row, below, left, x, right);
+    }
+};
+
+// Operace --------------------------------------------------------------------
+
+struct Add { static PIXELEXPR_INLINE int apply(int a, int b) { return a + b; } };
+struct Sub { static PIXELEXPR_INLINE int apply(int a, int b) { return a - b; } };
+struct Mul { static PIXELEXPR_INLINE int apply(int a, int b) { return a * b; } };
+struct Div { static PIXELEXPR_INLINE int apply(int a, int b) { return a / b; } };
+struct Shr { static PIXELEXPR_INLINE int apply(int a, int b) { return a >> b; } };
+struct Min { static PIXELEXPR_INLINE int apply(int a, int b) { return a < b ? a : b; } };
+struct Less { static PIXELEXPR_INLINE int apply(int a, int b) { return -(a < b); } };
+struct Greater { static PIXELEXPR_INLINE int apply(int a, int b) { return -(a > b); } };
+
+template <typename Op, typename A, typename B>
+struct Binary : Expr<Binary<Op, A, B> >
+{
+    A a;
+    B b;
+
+    Binary(const A& a, const B& b) : a(a), b(b) {}
+
+    PIXELEXPR_INLINE int at(int x, int left, int right) const
+    {
+        return Op::apply(a.at(x, left, right), b.at(x, left, right));
+    }
+};
+
+/**
+ * mask ? a : b, mask je 0 nebo -1.
+ */
+template <typename M, typename A, typename B>
+struct Blend : Expr<Blend<M, A, B> >
+{
+    M mask;
+    A a;
+    B b;
+
+    Blend(const M& mask, const A& a, const B& b) : mask(mask), a(a), b(b) {}
+
+    PIXELEXPR_INLINE int at(int x, int left, int right) const
+    {
+        int m = mask.at(x, left, right);
+
+        return (a.at(x, left, right) & m) | (b.at(x, left, right) & ~m);
+    }
+};
+
+/**
+ * Absolutni hodnota.
+ */
+template <typename A>
+struct Absolute : Expr<Absolute<A> >
+{
+    A a;
+
+    explicit Absolute(const A& a) : a(a) {}
+
+    PIXELEXPR_INLINE int at(int x, int left, int right) const
+    {
+        int v = a.at(x, left, right);
+
+        return v < 0 ? -v : v;
+    }
+};
+
+/**
+ * Orezani na rozsah 0 az 255.
+ */
+template <typename A>
+struct Saturate : Expr<Saturate<A> >
+{
+    A a;
+
+    explicit Saturate(const A& a) : a(a) {}
+
+    PIXELEXPR_INLINE int at(int x, int left, int right) const
+    {
+        int v = a.at(x, left, right);
+        v = v < 0 ? 0 : v;
+
+        return v > 255 ? 255 : v;
+    }
+};
+
+/**
+ * Prevodni tabulka s 256 polozkami (hodnota vyrazu musi byt 0 az 255).
+ */
+template <typename A>
+struct Lut : Expr<Lut<A> >
+{
+    const unsigned char* table;
+    A a;
+
+    Lut(const unsigned char* table, const A& a) : table(table), a(a) {}
+
+    PIXELEXPR_INLINE int at(int x, int left, int right) const
+    {
+        return table[a.at(x, left, right)];
+    }
+};
+
+/**
+ * round(min(sqrt(dx^2 + dy^2), 255)) pro celociselne gradienty. Soucet
+ * ctvercu je presny (< 2^24), odmocnina je v IEEE 754 presne zaokrouhlena
+ * a odmocnina celeho cisla nelezi blize nez 2^-12 k polovine, takze
+ * v + 0.5f dava stejny vysledek jako round(v) s puvodnim vypoctem ve float.
+ */
+PIXELEXPR_INLINE int magnitudeFloat(int dx, int dy)
+{
+#ifdef __GNUC__
+    float v = __builtin_sqrtf((float) (dx * dx + dy * dy));
+#else
+    float v = std::sqrt((float) (dx * dx + dy * dy));
+#endif
+    int rounded = (int) (v + 0.5f);
+
+    return rounded < 255 ? rounded : 255;
+}
+
+/**
+ * Totez jen v celych cislech, vsechny mezivysledky se vejdou do 16 bitu
+ * bez znamenka. Slozky se orezou na 255 (vetsi slozka da vysledek 255
+ * i bez orezani), soucet ctvercu se saturuje na 65535 (> 255^2). Odmocnina
+ * se pocita po bitech bez vetveni: r = floor(sqrt(n)) a round(sqrt(n)) je
+ * r + 1 prave kdyz n > r^2 + r. Vysledek je shodny s magnitudeFloat pro
+ * vsechny gradienty masek 3x3 (KernelCheck overuje |dx|, |dy| <= 1020).
+ */
+PIXELEXPR_INLINE int sqrtStep(int r, int n, int bit)
+{
+    int t = r | bit;
+    int mask = -(t * t <= n);
+
+    return (t & mask) | (r & ~mask);
+}
+
+PIXELEXPR_INLINE int magnitudeFixed(int dx, int dy)
+{
+    int ax = dx < 0 ? -dx : dx;
+    int ay = dy < 0 ? -dy : dy;
+    ax = ax < 255 ? ax : 255;
+    ay = ay < 255 ? ay : 255;
+
+    int n = ax * ax + ay * ay;
+    n = n < 65535 ? n : 65535;
+
+    // Rozvinuto rucne, smycku by prekladac nevektorizoval
+    int r = sqrtStep(0, n, 128);
+    r = sqrtStep(r, n, 64);
+    r = sqrtStep(r, n, 32);
+    r = sqrtStep(r, n, 16);
+    r = sqrtStep(r, n, 8);
+    r = sqrtStep(r, n, 4);
+    r = sqrtStep(r, n, 2);
+    r = sqrtStep(r, n, 1);
+
+    int rounded = r + (n > r * r + r);
+
+    return rounded < 255 ? rounded : 255;
+}
+
+/**
+ * Velikost gradientu, Fixed vybira celociselny vypocet.
+ */
+template <typename A, typename B, bool Fixed>
+struct Magnitude : Expr<Magnitude<A, B, Fixed> >
+{
+    A gx;
+    B gy;
+
+    Magnitude(const A& gx, const B& gy) : gx(gx), gy(gy) {}
+
+    PIXELEXPR_INLINE int at(int x, int left, int right) const
+    {
+        int dx = gx.at(x, left, right);
+        int dy = gy.at(x, left, right);
+
+        return Fixed ? magnitudeFixed(dx, dy) : magnitudeFloat(dx, dy);
+    }
+};
+
+// Konstrukce vyrazu ----------------------------------------------------------
+
+#define PIXELEXPR_OPERATOR(op, Op)                                             \
+    template <typename A, typename B>                                          \
+    inline Binary<Op, A, B> operator op(const Expr<A>& a, const Expr<B>& b)    \
+    {                                                                          \
+        return Binary<Op, A, B>(a.self(), b.self());                           \
+    }                                                                          \
+    template <typename A>                                                      \
+    inline Binary<Op, A, Constant> operator op(const Expr<A>& a, int b)        \
+    {                                                                          \
+        return Binary<Op, A, Constant>(a.self(), Constant(b));                 \
+    }                                                                          \
+    template <typename B>                                                      \
+    inline Binary<Op, Constant, B> operator op(int a, const Expr<B>& b)        \
+    {                                                                          \
+        return Binary<Op, Constant, B>(Constant(a), b.self());                 \
+    }
+
+PIXELEXPR_OPERATOR(+, Add)
+PIXELEXPR_OPERATOR(-, Sub)
+PIXELEXPR_OPERATOR(*, Mul)
+PIXELEXPR_OPERATOR(/, Div)
+PIXELEXPR_OPERATOR(>>, Shr)
+PIXELEXPR_OPERATOR(<, Less)
+PIXELEXPR_OPERATOR(>, Greater)
+
+#undef PIXELEXPR_OPERATOR
+
+template <typename T>
+inline Load<T> load(const T* p)
+{
+    return Load<T>(p);
+}
+
+template <int Channels, int C>
+inline Channel<Channels, C> channel(const unsigned char* p)
+{
+    return Channel<Channels, C>(p);
+}
+
+template <typename Mask>
+inline Stencil<Mask> stencil(const unsigned char* above, const unsigned char* row,
+                             const unsigned char* below)
+{
+    return Stencil<Mask>(above, row, below);
+}
+
+template <typename A>
+inline Binary<Min, A, Constant> min(const Expr<A>& a, int b)
+{
+    return Binary<Min, A, Constant>(a.self(), Constant(b));
+}
+
+template <typename A>
+inline Absolute<A> absolute(const Expr<A>& a)
+{
+    return Absolute<A>(a.self());
+}
+
+template <typename A>
+inline Saturate<A> saturate(const Expr<A>& a)
+{
+    return Saturate<A>(a.self());
+}
+
+template <typename A>
+inline Lut<A> lut(const unsigned char* table, const Expr<A>& a)
+{
+    return Lut<A>(table, a.self());
+}
+
+template <typename A, typename B>
+inline Magnitude<A, B, false> magnitude(const Expr<A>& gx, const Expr<B>& gy)
+{
+    return Magnitude<A, B, false>(gx.self(), gy.self());
+}
+
+template <typename A, typename B>
+inline Magnitude<A, B, true> fixedMagnitude(const Expr<A>& gx, const Expr<B>& gy)
+{
+    return Magnitude<A, B, true>(gx.self(), gy.self());
+}
+
+template <typename M, typename A, typename B>
+inline Blend<M, A, B> select(const Expr<M>& mask, const Expr<A>& a, const Expr<B>& b)
+{
+    return Blend<M, A, B>(mask.self(), a.self(), b.self());
+}
+
+template <typename M, typename B>
+inline Blend<M, Constant, B> select(const Expr<M>& mask, int a, const Expr<B>& b)
+{
+    return Blend<M, Constant, B>(mask.self(), Constant(a), b.self());
+}
+
+template <typename M, typename A>
+inline Blend<M, A, Constant> select(const Expr<M>& mask, const Expr<A>& a, int b)
+{
+    return Blend<M, A, Constant>(mask.self(), a.self(), Constant(b));
+}
+
+// Vyhodnoceni ----------------------------------------------------------------
+
+/**
+ * Vyhodnoceni vyrazu pro vsechny pixely radku do jednokanaloveho vystupu.
+ * Masky 3x3 ve vyrazu berou okrajove sloupce podle border.
+ *
+ * @param expr vyraz
+ * @param dst vystupni radek
+ * @param width sirka v pixelech
+ * @param border typ okraje
+ */
+template <typename T, typename E>
+void evaluate(const Expr<E>& expr, T* __restrict dst, int width,
+              Stencil3x3::Border border = Stencil3x3::REFLECT_101)
+{
+    const E& e = expr.self();
+
+    for (int x = 1; x < width - 1; x++)
+    {
+        dst[x] = (T) e.at(x, x - 1, x + 1);
+    }
+
+    for (int x = 0; x < width; x = (x == 0 && width > 2) ? width - 1 : x + 1)
+    {
+        dst[x] = (T) e.at(x, Stencil3x3::borderIndex(x - 1, width, border),
+                          Stencil3x3::borderIndex(x + 1, width, border));
+    }
+}
+
+/**
+ * Vyhodnoceni tri vyrazu (kanaly B, G, R) do trikanaloveho vystupu.
+ */
+template <typename E0, typename E1, typename E2>
+void evaluate(const Expr<E0>& expr0, const Expr<E1>& expr1, const Expr<E2>& expr2,
+              unsigned char* __restrict dst, int width,
+              Stencil3x3::Border border = Stencil3x3::REFLECT_101)
+{
+    const E0& e0 = expr0.self();
+    const E1& e1 = expr1.self();
+    const E2& e2 = expr2.self();
+
+    for (int x = 1; x < width - 1; x++)
+    {
+        dst[3 * x] = (unsigned char) e0.at(x, x - 1, x + 1);
+        dst[3 * x + 1] = (unsigned char) e1.at(x, x - 1, x + 1);
+        dst[3 * x + 2] = (unsigned char) e2.at(x, x - 1, x + 1);
+    }
+
+    for (int x = 0; x < width; x = (x == 0 && width > 2) ? width - 1 : x + 1)
+    {
+        int left = Stencil3x3::borderIndex(x - 1, width, border);
+        int right = Stencil3x3::borderIndex(x + 1, width, border);
+
+        dst[3 * x] = (unsigned char) e0.at(x, left, right);
+        dst[3 * x + 1] = (unsigned char) e1.at(x, left, right);
+        dst[3 * x + 2] = (unsigned char) e2.at(x, left, right);
+    }
+}
+
+/**
+ * Vyhodnoceni tri vyrazu do tri jednokanalovych vystupu (roviny B, G, R
+ * planarniho obrazu).
+ */
+template <typename E0, typename E1, typename E2>
+void evaluate(const Expr<E0>& expr0, const Expr<E1>& expr1, const Expr<E2>& expr2,
+              unsigned char* __restrict dst0, unsigned char* __restrict dst1,
+              unsigned char* __restrict dst2, int width,
+              Stencil3x3::Border border = Stencil3x3::REFLECT_101)
+{
+    const E0& e0 = expr0.self();
+    const E1& e1 = expr1.self();
+    const E2& e2 = expr2.self();
+
+    for (int x = 1; x < width - 1; x++)
+    {
+        dst0[x] = (unsigned char) e0.at(x, x - 1, x + 1);
+        dst1[x] = (unsigned char) e1.at(x, x - 1, x + 1);
+        dst2[x] = (unsigned char) e2.at(x, x - 1, x + 1);
+    }
+
+    for (int x = 0; x < width; x = (x == 0 && width > 2) ? width - 1 : x + 1)
+    {
+        int left = Stencil3x3::borderIndex(x - 1, width, border);
+        int right = Stencil3x3::borderIndex(x + 1, width, border);
+
+        dst0[x] = (unsigned char) e0.at(x, left, right);
+        dst1[x] = (unsigned char) e1.at(x, left, right);
+        dst2[x] = (unsigned char) e2.at(x, left, right);
+    }
+}
+
+} // namespace PixelExpr
+
+#endif	/* PIXELEXPR_H */
@@ -0,0 +1,110 @@
+/*
+ * Soubor: PlanarImage.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "PlanarImage.h"
+
+#include "TaskScheduler.h"
+
+// Nejmensi pocet radku prevodu zpracovany jednou ulohou planovace
+static const int CONVERT_GRAIN = 64;
+
+/**
+ * Velikost planarniho obrazu.
+ *
+ * @param imageSize velikost barevneho obrazu
+ * @return velikost jednokanaloveho obrazu se vsemi rovinami
+ */
+cv::Size PlanarImage::size(cv::Size imageSize)
+{
+    return cv::Size(imageSize.width, PLANES * imageSize.height);
+}
+
+/**
+ * Rovina planarniho obrazu.
+ *
+ * @param planar planarni obraz
+ * @param c index roviny (0 - B, 1 - G, 2 - R)
+ * @return vyrez roviny
+ */
+cv::Mat PlanarImage::plane(const cv::Mat& planar, int c)
+{
+    int rows = planar.rows / PLANES;
+
+    return planar.rowRange(c * rows, (c + 1) * rows);
+}
+
+/**
+ * Radky [begin, end) vsech rovin.
+ *
+ * @param planar planarni obraz
+ * @param begin prvni radek
+ * @param end radek za poslednim radkem
+ * @param planes vystupni vyrezy rovin
+ */
+void PlanarImage::planes(const cv::Mat& planar, int begin, int end, cv::Mat planes[PLANES])
+{
+    int rows = planar.rows / PLANES;
+
+    for (int c = 0; c < PLANES; c++)
+    {
+        planes[c] = planar.rowRange(c * rows + begin, c * rows + end);
+    }
+}
+
+/**
+ * Ukazatele na radek y vsech rovin (vstup planarnich funkci radku).
+ *
+ * @param planar planarni obraz
+ * @param y radek
+ * @param rows vystupni ukazatele na radky rovin B, G, R
+ */
+void PlanarImage::rows(cv::Mat& planar, int y, unsigned char* rows[PLANES])
+{
+    int planeRows = planar.rows / PLANES;
+
+    for (int c = 0; c < PLANES; c++)
+    {
+        rows[c] = planar.ptr(c * planeRows + y);
+    }
+}
+
+/**
+ * Prevod prokladaneho BGR obrazu na planarni (paralelne po pruzich radku).
+ *
+ * @param bgr vstupni obraz CV_8UC3
+ * @param planar vystupni planarni obraz (alokuje se, pokud nema spravnou velikost)
+ */
+void PlanarImage::split(const cv::Mat& bgr, cv::Mat& planar)
+{
+    planar.create(size(bgr.size()), CV_8UC1);
+
+    TaskScheduler::instance().parallelFor(0, bgr.rows, CONVERT_GRAIN, [&](int begin, int end) {
+        cv::Mat strip[PLANES];
+        planes(planar, begin, end, strip);
+        cv::split(bgr.rowRange(begin, end), strip);
+    });
+}
+
+/**
+ * Prevod planarniho obrazu na prokladany BGR (paralelne po pruzich radku).
+ *
+ * @param planar vstupni planarni obraz
+ * @param bgr vystupni obraz CV_8UC3
+ */
+void PlanarImage::merge(const cv::Mat& planar, cv::Mat& bgr)
+{
+    bgr.create(planar.rows / PLANES, planar.cols, CV_8UC3);
+
+    TaskScheduler::instance().parallelFor(0, bgr.rows, CONVERT_GRAIN, [&](int begin, int end) {
+        cv::Mat strip[PLANES];
+        planes(planar, begin, end, strip);
+        cv::Mat bgrRows = bgr.rowRange(begin, end);
+        cv::merge(strip, PLANES, bgrRows);
+    });
+}
@@ -0,0 +1,37 @@
+/*
+ * Soubor: PlanarImage.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef PLANARIMAGE_H
+#define	PLANARIMAGE_H
+
+#include <opencv2/core/core.hpp> // cv::Mat
+
+/**
+ * Barevny obraz v planarnim usporadani (roviny misto prokladanych BGR
+ * pixelu). Roviny B, G, R jsou ulozeny pod sebou v jednom 8bitovem
+ * jednokanalovem obrazu se 3 * rows radky, radek y roviny c je radek
+ * c * rows + y. Funkce radku pak zpracuji kazdou rovinu celymi vektory
+ * bez prehazovani kanalu.
+ */
+class PlanarImage
+{
+    public:
+
+        static const int PLANES = 3;
+
+        static cv::Size size(cv::Size imageSize);
+        static cv::Mat plane(const cv::Mat& planar, int c);
+        static void planes(const cv::Mat& planar, int begin, int end, cv::Mat planes[PLANES]);
+        static void rows(cv::Mat& planar, int y, unsigned char* rows[PLANES]);
+
+        static void split(const cv::Mat& bgr, cv::Mat& planar);
+        static void merge(const cv::Mat& planar, cv::Mat& bgr);
+};
+
+#endif	/* PLANARIMAGE_H */
@@ -0,0 +1,258 @@
+/*
+ * Soubor: PnmStream.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "PnmStream.h"
+
+#include <cctype>
+
+PnmReader::PnmReader() : mFile(nullptr), mChannels(0), mRow(0)
+{
+}
+
+PnmReader::~PnmReader()
+{
+    if (mFile != nullptr)
+    {
+        std::fclose(mFile);
+    }
+}
+
+/**
+ * Otevreni souboru a nacteni hlavicky.
+ *
+ * @param path cesta k souboru
+ * @return false - soubor nelze otevrit nebo neni binarni 8bitovy PNM
+ */
+bool PnmReader::open(const std::string& path)
+{
+    mFile = std::fopen(path.c_str(), "rb");
+
+    if (mFile == nullptr)
+    {
+        return false;
+    }
+
+    char magic[2];
+    int width;
+    int height;
+    int maxValue;
+
+    if (std::fread(magic, 1, 2, mFile) != 2 || magic[0] != 'P' || (magic[1] != '5' && magic[1] != '6')
+        || !readHeaderValue(&width) || !readHeaderValue(&height) || !readHeaderValue(&maxValue)
+        || width <= 0 || height <= 0 || maxValue != 255)
+    {
+        return false;
+    }
+
+    // Za maximalni hodnotou nasleduje prave jeden bily znak
+    std::fgetc(mFile);
+
+    mSize = cv::Size(width, height);
+    mChannels = magic[1] == '6' ? 3 : 1;
+    mRow = 0;
+    mBuffer.resize((size_t) width * mChannels);
+
+    return true;
+}
+
+/**
+ * Nacteni dalsich radku obrazku.
+ *
+ * @param rows vystup (BGR CV_8UC3, sirka obrazku), nacte se tolik radku,
+ *             kolik ma
+ * @return false - chyba cteni nebo konec obrazku
+ */
+bool PnmReader::read(cv::Mat& rows)
+{
+    if (mFile == nullptr || mRow + rows.rows > mSize.height)
+    {
+        return false;
+    }
+
+    for (int j = 0; j < rows.rows; j++)
+    {
+        if (std::fread(&mBuffer[0], 1, mBuffer.size(), mFile) != mBuffer.size())
+        {
+            return false;
+        }
+
+        unsigned char* row = rows.ptr(j);
+
+        for (int i = 0; i < mSize.width; i++)
+        {
+            if (mChannels == 3)
+            {
+                row[3 * i] = mBuffer[3 * i + 2];
+                row[3 * i + 1] = mBuffer[3 * i + 1];
+                row[3 * i + 2] = mBuffer[3 * i];
+            }
+            else
+            {
+                row[3 * i] = row[3 * i + 1] = row[3 * i + 2] = mBuffer[i];
+            }
+        }
+    }
+
+    mRow += rows.rows;
+
+    return true;
+}
+
+/**
+ * Velikost obrazku z hlavicky.
+ *
+ * @return velikost
+ */
+cv::Size PnmReader::size() const
+{
+    return mSize;
+}
+
+/**
+ * Pocet kanalu v souboru (1 - P5, 3 - P6).
+ *
+ * @return pocet kanalu
+ */
+int PnmReader::channels() const
+{
+    return mChannels;
+}
+
+/**
+ * Nacteni cisla hlavicky (preskoci bile znaky a komentare).
+ *
+ * @param value vystupni hodnota
+ * @return false - chybna hlavicka
+ */
+bool PnmReader::readHeaderValue(int* value)
+{
+    int c = std::fgetc(mFile);
+
+    while (c == '#' || std::isspace(c))
+    {
+        if (c == '#')
+        {
+            while (c != '\n' && c != EOF)
+            {
+                c = std::fgetc(mFile);
+            }
+        }
+        c = std::fgetc(mFile);
+    }
+
+    if (!std::isdigit(c))
+    {
+        return false;
+    }
+
+    *value = 0;
+
+    while (std::isdigit(c))
+    {
+        if (*value > 100000000)
+        {
+            return false;
+        }
+
+        *value = *value * 10 + (c - '0');
+        c = std::fgetc(mFile);
+    }
+
+    // Oddelovac za cislem vrati, aby ho precetlo dalsi volani (nebo open)
+    std::ungetc(c, mFile);
+
+    return true;
+}
+
+PnmWriter::PnmWriter() : mFile(nullptr), mChannels(0)
+{
+}
+
+PnmWriter::~PnmWriter()
+{
+    close();
+}
+
+/**
+ * Vytvoreni souboru a zapis hlavicky.
+ *
+ * @param path cesta k souboru
+ * @param size velikost obrazku
+ * @param channels 1 - P5, 3 - P6
+ * @return false - soubor nelze vytvorit
+ */
+bool PnmWriter::open(const std::string& path, cv::Size size, int channels)
+{
+    mFile = std::fopen(path.c_str(), "wb");
+
+    if (mFile == nullptr)
+    {
+        return false;
+    }
+
+    mChannels = channels;
+    mBuffer.resize((size_t) size.width * channels);
+
+    return std::fprintf(mFile, "P%d\n%d %d\n255\n", channels == 3 ? 6 : 5, size.width, size.height) > 0;
+}
+
+/**
+ * Zapis dalsich radku.
+ *
+ * @param rows radky (CV_8UC1 nebo BGR CV_8UC3 podle open)
+ * @return false - chyba zapisu
+ */
+bool PnmWriter::write(const cv::Mat& rows)
+{
+    if (mFile == nullptr || rows.channels() != mChannels || rows.cols * mChannels != (int) mBuffer.size())
+    {
+        return false;
+    }
+
+    for (int j = 0; j < rows.rows; j++)
+    {
+        const unsigned char* row = rows.ptr(j);
+
+        if (mChannels == 3)
+        {
+            for (int i = 0; i < rows.cols; i++)
+            {
+                mBuffer[3 * i] = row[3 * i + 2];
+                mBuffer[3 * i + 1] = row[3 * i + 1];
+                mBuffer[3 * i + 2] = row[3 * i];
+            }
+            row = &mBuffer[0];
+        }
+
+        if (std::fwrite(row, 1, mBuffer.size(), mFile) != mBuffer.size())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Uzavreni souboru.
+ *
+ * @return false - chyba pri zapisu zbytku dat
+ */
+bool PnmWriter::close()
+{
+    if (mFile == nullptr)
+    {
+        return true;
+    }
+
+    bool ok = std::fclose(mFile) == 0;
+    mFile = nullptr;
+
+    return ok;
+}
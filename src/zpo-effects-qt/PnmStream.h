@@ -0,0 +1,77 @@
+/*
+ * Soubor: PnmStream.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef PNMSTREAM_H
+#define	PNMSTREAM_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <opencv2/core/core.hpp> // cv::Mat
+
+/**
+ * Cteni binarniho PNM (P5 sedy, P6 RGB, 8 bitu) po radcich. Velikost
+ * obrazku se zna z hlavicky, radky se ctou postupne do BGR bufferu, takze
+ * obrazek nemusi byt v pameti cely (cv::imread to neumi).
+ */
+class PnmReader
+{
+    private:
+
+        std::FILE* mFile;
+        cv::Size mSize;
+        int mChannels;
+        int mRow;                        // dalsi nacteny radek
+        std::vector<unsigned char> mBuffer;
+
+    public:
+
+        PnmReader();
+        ~PnmReader();
+
+        PnmReader(const PnmReader&) = delete;
+        PnmReader& operator=(const PnmReader&) = delete;
+
+        bool open(const std::string& path);
+        bool read(cv::Mat& rows);
+
+        cv::Size size() const;
+        int channels() const;
+
+    private:
+
+        bool readHeaderValue(int* value);
+};
+
+/**
+ * Zapis binarniho PNM (P5 z CV_8UC1, P6 z BGR CV_8UC3) po radcich.
+ */
+class PnmWriter
+{
+    private:
+
+        std::FILE* mFile;
+        int mChannels;
+        std::vector<unsigned char> mBuffer;
+
+    public:
+
+        PnmWriter();
+        ~PnmWriter();
+
+        PnmWriter(const PnmWriter&) = delete;
+        PnmWriter& operator=(const PnmWriter&) = delete;
+
+        bool open(const std::string& path, cv::Size size, int channels);
+        bool write(const cv::Mat& rows);
+        bool close();
+};
+
+#endif	/* PNMSTREAM_H */
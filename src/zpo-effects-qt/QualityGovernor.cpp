@@ -0,0 +1,152 @@
+/*
+ * Soubor: QualityGovernor.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "QualityGovernor.h"
+
+#include <cstdlib>
+
+// Meritka urovni (od plneho rozliseni)
+static const double LEVEL_SCALES[QualityGovernor::LEVEL_COUNT] = {1.0, 0.75, 0.5, 0.25};
+
+// Cast doby snimku pro filtraci (zbytek cteni snimku a zobrazeni)
+static const double TARGET_LOAD = 0.8;
+
+// Vyssi uroven musi podle odhadu zabrat nejvyse tuto cast cile
+static const double UP_MARGIN = 0.7;
+
+// Pocet snimku po sobe nad rozpoctem pred snizenim, s rezervou pred zvysenim
+static const int DOWN_FRAMES = 2;
+static const int UP_FRAMES = 30;
+
+// Vaha noveho mereni v klouzavem prumeru
+static const double AVERAGE_WEIGHT = 0.25;
+
+QualityGovernor::QualityGovernor()
+    : mEnabled(true)
+    , mBudget(0)
+    , mLevel(0)
+    , mAverage(0)
+    , mOverBudget(0)
+    , mHeadroom(0)
+{
+    const char* adaptive = getenv("ZPO_ADAPTIVE_SCALE");
+    mEnabled = adaptive == nullptr || *adaptive == '\0' || atoi(adaptive) != 0;
+}
+
+/**
+ * Nastaveni rozpoctu doby snimku (interval casovace zdroje).
+ *
+ * @param milliseconds doba jednoho snimku v ms (0 - bez omezeni)
+ */
+void QualityGovernor::setBudget(double milliseconds)
+{
+    mBudget = milliseconds;
+}
+
+/**
+ * Navrat na plne rozliseni (novy zdroj snimku).
+ */
+void QualityGovernor::reset()
+{
+    setLevel(0, 0);
+}
+
+/**
+ * Zapocteni doby filtrace dalsiho snimku.
+ *
+ * @param milliseconds doba filtrace snimku v ms
+ * @return true - zmenilo se meritko
+ */
+bool QualityGovernor::update(double milliseconds)
+{
+    if (!mEnabled || mBudget <= 0)
+    {
+        return false;
+    }
+
+    mAverage = mAverage > 0 ? mAverage + AVERAGE_WEIGHT * (milliseconds - mAverage) : milliseconds;
+
+    double target = TARGET_LOAD * mBudget;
+
+    // Doba filtrace je umerna poctu pixelu, tj. druhe mocnine meritka
+    auto predict = [&](int level) {
+        double ratio = levelScale(level) / levelScale(mLevel);
+        return mAverage * ratio * ratio;
+    };
+
+    mOverBudget = mAverage > target ? mOverBudget + 1 : 0;
+
+    if (mOverBudget >= DOWN_FRAMES && mLevel < LEVEL_COUNT - 1)
+    {
+        // Nejvyssi uroven, ktera se podle odhadu vejde do rozpoctu
+        int level = mLevel + 1;
+        while (level < LEVEL_COUNT - 1 && predict(level) > target)
+        {
+            level++;
+        }
+
+        setLevel(level, predict(level));
+        return true;
+    }
+
+    mHeadroom = mLevel > 0 && predict(mLevel - 1) < UP_MARGIN * target ? mHeadroom + 1 : 0;
+
+    if (mHeadroom >= UP_FRAMES)
+    {
+        setLevel(mLevel - 1, predict(mLevel - 1));
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * Aktualni uroven.
+ *
+ * @return uroven (0 - plne rozliseni)
+ */
+int QualityGovernor::level() const
+{
+    return mLevel;
+}
+
+/**
+ * Aktualni meritko zpracovani.
+ *
+ * @return meritko (1 - plne rozliseni)
+ */
+double QualityGovernor::scale() const
+{
+    return levelScale(mLevel);
+}
+
+/**
+ * Meritko urovne.
+ *
+ * @param level uroven
+ * @return meritko
+ */
+double QualityGovernor::levelScale(int level)
+{
+    return LEVEL_SCALES[level];
+}
+
+/**
+ * Prechod na uroven, prumer se nahradi odhadem pro novou uroven.
+ *
+ * @param level uroven
+ * @param predicted odhad doby filtrace na nove urovni
+ */
+void QualityGovernor::setLevel(int level, double predicted)
+{
+    mLevel = level;
+    mAverage = predicted;
+    mOverBudget = 0;
+    mHeadroom = 0;
+}
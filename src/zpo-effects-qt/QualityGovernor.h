@@ -0,0 +1,55 @@
+/*
+ * Soubor: QualityGovernor.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef QUALITYGOVERNOR_H
+#define	QUALITYGOVERNOR_H
+
+/**
+ * Volba meritka zpracovani snimku (1, 3/4, 1/2, 1/4) podle doby filtrace,
+ * aby video a kamera drzely snimkovou frekvenci. Snimkova frekvence ma
+ * prednost pred rozlisenim: pri prekroceni rozpoctu se meritko snizi hned
+ * (pri velkem prekroceni rovnou o vice urovni), zvysi se az po delsi dobe
+ * s rezervou, takze meritko mezi urovnemi nekmita (hystereze).
+ *
+ * ZPO_ADAPTIVE_SCALE=0 volbu vypne (vzdy plne rozliseni).
+ */
+class QualityGovernor
+{
+    public:
+
+        static const int LEVEL_COUNT = 4;
+
+    private:
+
+        bool mEnabled;
+        double mBudget;   // doba snimku v ms
+        int mLevel;
+        double mAverage;  // klouzavy prumer doby filtrace v ms
+        int mOverBudget;  // pocet snimku po sobe nad rozpoctem
+        int mHeadroom;    // pocet snimku po sobe s rezervou pro vyssi uroven
+
+    public:
+
+        QualityGovernor();
+
+        void setBudget(double milliseconds);
+        void reset();
+        bool update(double milliseconds);
+
+        int level() const;
+        double scale() const;
+
+        static double levelScale(int level);
+
+    private:
+
+        void setLevel(int level, double predicted);
+};
+
+#endif	/* QUALITYGOVERNOR_H */
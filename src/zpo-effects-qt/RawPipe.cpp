@@ -0,0 +1,191 @@
+/*
+ * Soubor: RawPipe.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "RawPipe.h"
+
+#include <csignal>
+#include <cstdio>
+#include <thread>
+
+#include <opencv2/imgproc/imgproc.hpp> // cv::cvtColor
+
+#ifdef _WIN32
+    #include <fcntl.h>
+    #include <io.h> // _setmode
+#endif
+
+#include "FrameQueue.h"
+
+// Buffery na kazde strane filtrace (jeden filtruje, druhy se cte/zapisuje)
+static const int BUFFERS = 2;
+
+/**
+ * Nazev formatu pixelu (nazvy ffmpeg).
+ *
+ * @param type typ OpenCV
+ * @return gray nebo bgr24
+ */
+static const char* formatName(int type)
+{
+    return CV_MAT_CN(type) == 1 ? "gray" : "bgr24";
+}
+
+/**
+ * Velikost snimku v bajtech.
+ *
+ * @param image snimek (souvisly)
+ * @return pocet bajtu
+ */
+static size_t frameBytes(const cv::Mat& image)
+{
+    return image.total() * image.elemSize();
+}
+
+/**
+ * Spusteni filtrace. Ctouci vlakno plni volne vstupni buffery (GRAY8 se
+ * prevede na BGR), hlavni vlakno filtruje do volnych vystupnich bufferu
+ * a zapisujici vlakno vystupni buffery zapise a vrati. Buffery obihaji ve
+ * frontach, nic se nealokuje a nekopiruje navic. SIGPIPE se ignoruje,
+ * zavreny vystup se tak projevi jako chyba zapisu.
+ *
+ * @param commandLine argumenty prikazove radky (filtr, velikost, format)
+ * @return navratovy kod programu
+ */
+int RawPipe::run(const CommandLine& commandLine)
+{
+    ImageFilter::Type filterType = commandLine.getFilterTypes().front();
+    cv::Size size = commandLine.getSizes().front();
+    int inputType = commandLine.getInputType();
+    int outputType = ImageFilter::outputType(filterType, CV_8UC3);
+
+#ifdef _WIN32
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+#else
+    // Po zavreni vystupu odberatelem (ukonceny ffmpeg, head) selze zapis
+    // (EPIPE) a program skonci hlasenim a kodem 1, ne signalem SIGPIPE
+    signal(SIGPIPE, SIG_IGN);
+#endif
+
+    // Standardni vystup patri snimkum, hlaseni jdou na chybovy vystup
+    fprintf(stderr, "%s %dx%d: %s -> %s\n", ImageFilter::typeName(filterType), size.width, size.height,
+            formatName(inputType), formatName(outputType));
+
+    FrameQueue freeInputs(BUFFERS);
+    FrameQueue filled(BUFFERS);
+    FrameQueue freeOutputs(BUFFERS);
+    FrameQueue filtered(BUFFERS);
+
+    for (int i = 0; i < BUFFERS; i++)
+    {
+        freeInputs.push(-1, cv::Mat(size, CV_8UC3));
+        freeOutputs.push(-1, cv::Mat(size, outputType));
+    }
+
+    bool incomplete = false;
+    bool writeFailed = false;
+
+    std::thread reader([&] {
+        cv::Mat raw = inputType == CV_8UC3 ? cv::Mat() : cv::Mat(size, inputType);
+        FrameQueue::Frame buffer;
+
+        for (int index = 0; freeInputs.pop(&buffer); index++)
+        {
+            cv::Mat& target = raw.empty() ? buffer.image : raw;
+            size_t count = fread(target.data, 1, frameBytes(target), stdin);
+
+            if (count != frameBytes(target))
+            {
+                incomplete = count > 0;
+                break;
+            }
+
+            if (!raw.empty())
+            {
+                cv::cvtColor(raw, buffer.image, CV_GRAY2BGR);
+            }
+
+            if (!filled.push(index, buffer.image))
+            {
+                break;
+            }
+        }
+
+        filled.close();
+    });
+
+    std::thread writer([&] {
+        FrameQueue::Frame frame;
+
+        while (filtered.pop(&frame))
+        {
+            if (fwrite(frame.image.data, 1, frameBytes(frame.image), stdout) != frameBytes(frame.image))
+            {
+                writeFailed = true;
+                break;
+            }
+
+            freeOutputs.push(-1, frame.image);
+        }
+
+        if (fflush(stdout) != 0)
+        {
+            writeFailed = true;
+        }
+        filtered.close();
+        freeOutputs.close();
+    });
+
+    long long start = cv::getTickCount();
+    int frames = 0;
+    FrameQueue::Frame input;
+    FrameQueue::Frame output;
+
+    while (filled.pop(&input) && freeOutputs.pop(&output))
+    {
+        cv::Mat dst = output.image;
+
+        ImageFilter::filter(input.image, dst, filterType);
+
+        // Filtr s vlastnim vystupnim bufferem
+        if (dst.data != output.image.data)
+        {
+            dst.copyTo(output.image);
+        }
+
+        freeInputs.push(-1, input.image);
+
+        if (!filtered.push(input.index, output.image))
+        {
+            break;
+        }
+        frames++;
+    }
+
+    // Po chybe zapisu se zastavi i cteni
+    filtered.close();
+    filled.close();
+    freeInputs.close();
+    reader.join();
+    writer.join();
+
+    double seconds = (cv::getTickCount() - start) / cv::getTickFrequency();
+    fprintf(stderr, "%d frames in %.2f s, %.1f fps\n", frames, seconds, seconds > 0 ? frames / seconds : 0.0);
+
+    if (incomplete)
+    {
+        fprintf(stderr, "Incomplete frame at end of input (check --size and --pix-fmt)\n");
+    }
+    if (writeFailed)
+    {
+        fprintf(stderr, "Could not write frames to standard output\n");
+    }
+
+    return incomplete || writeFailed ? 1 : 0;
+}
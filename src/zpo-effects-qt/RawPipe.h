@@ -0,0 +1,31 @@
+/*
+ * Soubor: RawPipe.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef RAWPIPE_H
+#define	RAWPIPE_H
+
+#include "CommandLine.h"
+
+/**
+ * Filtrace nekomprimovanych snimku ze standardniho vstupu na standardni
+ * vystup (napr. mezi dvema ffmpeg -f rawvideo). Vstupni snimky jsou BGR24
+ * nebo GRAY8 velikosti --size, vystupni snimky maji format vystupu filtru
+ * (GRAY8 u sedotonovych filtru, jinak BGR24). Cteni, filtrace a zapis
+ * bezi ve vlastnich vlaknech nad dvema vstupnimi a dvema vystupnimi
+ * buffery (double buffering), ktere se alokuji jednou a obihaji mezi
+ * vlakny, takze se I/O prekryva s filtraci bez alokaci na snimek.
+ */
+class RawPipe
+{
+    public:
+
+        static int run(const CommandLine& commandLine);
+};
+
+#endif	/* RAWPIPE_H */
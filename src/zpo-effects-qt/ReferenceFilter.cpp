@@ -0,0 +1,457 @@
+/*
+ * Soubor: ReferenceFilter.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "ReferenceFilter.h"
+
+#include <opencv2/imgproc/imgproc.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using std::vector;
+
+/**
+ * Filtrace obrazu referencni implementaci.
+ *
+ * @param src vstupni obraz
+ * @param dst vystupni filtrovany obraz
+ * @param filterType typ filtru
+ */
+void ReferenceFilter::filter(const cv::Mat& src, cv::Mat& dst, ImageFilter::Type filterType)
+{
+    cv::Mat image = src.clone();
+
+    float left[9] = { 1, 0, -1,
+                      2, 0, -2,
+                      1, 0, -1};
+    float right[9] = {-1, 0, 1,
+                      -2, 0, 2,
+                      -1, 0, 1};
+    float down[9] = {-1, -2, -1,
+                      0,  0,  0,
+                      1,  2,  1};
+    float up[9] = { 1,  2,  1,
+                    0,  0,  0,
+                   -1, -2, -1};
+
+    float prewitt1[9] = {-1,  0,  1,
+                         -1,  0,  1,
+                         -1,  0,  1};
+    float prewitt2[9] = {-1, -1, -1,
+                          0,  0,  0,
+                          1,  1,  1};
+
+    switch (filterType)
+    {
+        case ImageFilter::Type::EdgeGrayLeft:       edgeGray(image, dst, left);                    break;
+        case ImageFilter::Type::EdgeGrayRight:      edgeGray(image, dst, right);                   break;
+        case ImageFilter::Type::EdgeGrayDown:       edgeGray(image, dst, down);                    break;
+        case ImageFilter::Type::EdgeGrayUp:         edgeGray(image, dst, up);                      break;
+        case ImageFilter::Type::EdgeGrayFourDir:    edgeGrayFourDir(image, dst);                   break;
+        case ImageFilter::Type::EdgeGrayFourMax:    edgeGrayFourMax(image, dst);                   break;
+        case ImageFilter::Type::EdgeGrayFourDirEqu: edgeGrayFourDirEqu(image, dst);                break;
+        case ImageFilter::Type::SobelGray:          gradientMagnitude(image, dst, prewitt1, prewitt2); break;
+        case ImageFilter::Type::SobelGray2:         gradientMagnitude(image, dst, right, down);    break;
+        case ImageFilter::Type::SobelColor:         sobelColor(image, dst);                        break;
+        case ImageFilter::Type::Comics:             comics(image, dst);                            break;
+        case ImageFilter::Type::Glass:              glass(image, dst);                             break;
+        default:                                    dst = image;
+    }
+}
+
+/**
+ * Jednoduchy hranovy filtr (edgeGrayLeft, Right, Down, Up): sedotonovy
+ * obraz a konvoluce s maskou.
+ *
+ * @param src vstupni obraz
+ * @param dst vystupni (filtrovany obraz)
+ * @param ker maska 3x3
+ */
+void ReferenceFilter::edgeGray(const cv::Mat& src, cv::Mat& dst, const float ker[9])
+{
+    cv::Mat src_gray;
+
+    cvtColor(src, src_gray, CV_BGR2GRAY);
+
+    cv::Mat kernel = cv::Mat(3, 3, CV_32FC1, (void*) ker).clone();
+
+    cv::flip(kernel, kernel, -1);
+    cv::filter2D(src_gray, dst, -1, kernel);
+}
+
+/**
+ * Prumer ctyr smerovych hranovych filtru.
+ *
+ * @param src vstupni obraz
+ * @param dst vystupni (filtrovany obraz)
+ */
+void ReferenceFilter::edgeGrayFourDir(const cv::Mat& src, cv::Mat& dst)
+{
+    float left[9] = { 1, 0, -1,
+                      2, 0, -2,
+                      1, 0, -1};
+    float right[9] = {-1, 0, 1,
+                      -2, 0, 2,
+                      -1, 0, 1};
+    float down[9] = {-1, -2, -1,
+                      0,  0,  0,
+                      1,  2,  1};
+    float up[9] = { 1,  2,  1,
+                    0,  0,  0,
+                   -1, -2, -1};
+
+    cv::Mat d1;
+    cv::Mat d2;
+    cv::Mat d3;
+    cv::Mat d4;
+
+    edgeGray(src, d1, down);
+    edgeGray(src, d2, up);
+    edgeGray(src, d3, right);
+    edgeGray(src, d4, left);
+
+    dst = cv::Mat::zeros(src.rows, src.cols, d2.type());
+
+    for (int i = 0; i < d1.cols; i++)
+    {
+        for (int j = 0; j < d1.rows; j++)
+        {
+            int v = d1.at<uchar>(j,i) + d2.at<uchar>(j,i) + d3.at<uchar>(j,i) + d4.at<uchar>(j,i);
+            v /= 4;
+
+            dst.at<uchar>(j,i) = (uchar)v;
+        }
+    }
+}
+
+/**
+ * Emboss s cyklickym okrajem a prevodem na sedotonovy obraz.
+ *
+ * @param src vstupni obraz
+ * @param dst vystupni (filtrovany obraz)
+ */
+void ReferenceFilter::edgeGrayFourMax(const cv::Mat& src, cv::Mat& dst)
+{
+    int kerDim = 3;
+    float ker[3][3] = {{-1, -1, 0},
+                       {-1,  0, 1},
+                       { 0,  1, 1}};
+
+    int bias = 128;
+    cv::Mat bgr = cv::Mat::zeros(src.rows, src.cols, src.type());
+
+    for (int i = 0; i < src.cols; i++)
+    {
+        for (int j = 0; j < src.rows; j++)
+        {
+            int red = 0, green = 0, blue = 0;
+
+            for (int x = 0; x < kerDim; x++)
+            {
+                for (int y = 0; y < kerDim; y++)
+                {
+                    int imgX = (j - kerDim / 2 + x + src.rows) % src.rows;
+                    int imgY = (i - kerDim / 2 + y + src.cols) % src.cols;
+                    cv::Vec3b q = src.at<cv::Vec3b>(imgX, imgY);
+
+                    red += q[2] * ker[x][y];
+                    green += q[1] * ker[x][y];
+                    blue += q[0] * ker[x][y];
+                }
+            }
+
+            cv::Vec3b q;
+            q[2] = std::min(std::max(red + bias, 0), 255);
+            q[1] = std::min(std::max(green + bias, 0), 255);
+            q[0] = std::min(std::max(blue + bias, 0), 255);
+
+            bgr.at<cv::Vec3b>(j,i) = q;
+        }
+    }
+
+    cvtColor(bgr, dst, CV_BGR2GRAY);
+}
+
+/**
+ * Prumer ctyr smerovych hranovych filtru s ekvalizaci histogramu.
+ *
+ * @param src vstupni obraz
+ * @param dst vystupni (filtrovany obraz)
+ */
+void ReferenceFilter::edgeGrayFourDirEqu(const cv::Mat& src, cv::Mat& dst)
+{
+    edgeGrayFourDir(src, dst);
+    cv::equalizeHist(dst, dst);
+}
+
+/**
+ * Velikost gradientu ze dvou masek (Prewitt - sobelGray, Sobel - sobelGray2).
+ *
+ * @param src vstupni obraz
+ * @param dst vystupni (filtrovany obraz)
+ * @param ker1 maska gradientu ve smeru x
+ * @param ker2 maska gradientu ve smeru y
+ */
+void ReferenceFilter::gradientMagnitude(const cv::Mat& src, cv::Mat& dst,
+                                        const float ker1[9], const float ker2[9])
+{
+    cv::Mat d1;
+    cv::Mat d2;
+    cv::Mat src_gray;
+
+    cvtColor(src, src_gray, CV_BGR2GRAY);
+
+    cv::Mat kernel1 = cv::Mat(3, 3, CV_32FC1, (void*) ker1).clone();
+    cv::Mat kernel2 = cv::Mat(3, 3, CV_32FC1, (void*) ker2).clone();
+
+    cv::flip(kernel1, kernel1, -1);
+    cv::flip(kernel2, kernel2, -1);
+
+    cv::filter2D(src_gray, d1, CV_32FC1, kernel1);
+    cv::filter2D(src_gray, d2, CV_32FC1, kernel2);
+
+    dst = cv::Mat::zeros(src.rows, src.cols, CV_8U);
+
+    for (int j = 0; j < d1.cols; j++)
+    {
+        for (int i = 0; i < d1.rows; i++)
+        {
+            float f1 = d1.at<float>(i,j) * d1.at<float>(i,j);
+            float f2 = d2.at<float>(i,j) * d2.at<float>(i,j);
+
+            float v = sqrt(f1 + f2);
+
+            if (v > 255)
+            {
+                v = 255;
+            }
+
+            dst.at<uchar>(i,j) = (uchar)round(v);
+        }
+    }
+}
+
+/**
+ * Barevny sobel: rozostreni, pricteni hran k barvam (tmave plochy bez
+ * hran) a dalsi rozostreni.
+ *
+ * @param src vstupni obraz
+ * @param dst vystupni (filtrovany obraz)
+ */
+void ReferenceFilter::sobelColor(const cv::Mat& src, cv::Mat& dst)
+{
+    cv::Mat tmp;
+    cv::Mat blur;
+
+    float mean_sum = 25.0;
+    float mean5x5[25] = {
+        1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum,
+        1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum,
+        1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum,
+        1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum,
+        1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum, 1.0f/mean_sum,
+    };
+
+    cv::Mat meankernel5x5(5, 5, CV_32FC1, mean5x5);
+
+    cv::flip(meankernel5x5, meankernel5x5, -1);
+    cv::filter2D(src, blur, -1, meankernel5x5);
+    edgeGrayFourDir(blur, tmp);
+
+    dst = blur.clone();
+
+    for (int i = 0; i < dst.cols; i++)
+    {
+        for (int j = 0; j < dst.rows; j++)
+        {
+            cv::Vec3b p = dst.at<cv::Vec3b>(j,i);
+            if (tmp.at<uchar>(j,i) < 14)
+            {
+                dst.at<cv::Vec3b>(j,i) = cv::Vec3b(20, 20, 20);
+            }
+            else
+            {
+                if ((p.val[0] + tmp.at<uchar>(j,i) * 0.299) < 255)
+                {
+                    p.val[0] += tmp.at<uchar>(j,i) * 0.299;
+                }
+                else
+                {
+                    p.val[0] = 255;
+                }
+                if ((p.val[1] + tmp.at<uchar>(j,i) * 0.587) < 255)
+                {
+                    p.val[1] += tmp.at<uchar>(j,i) * 0.587;
+                }
+                else
+                {
+                    p.val[1] = 255;
+                }
+                if ((p.val[2] + tmp.at<uchar>(j,i) * 0.114) < 255)
+                {
+                    p.val[2] += tmp.at<uchar>(j,i) * 0.114;
+                }
+                else
+                {
+                    p.val[2] = 255;
+                }
+
+                dst.at<cv::Vec3b>(j,i) = p;
+            }
+        }
+    }
+
+    cv::filter2D(dst, blur, -1, meankernel5x5);
+    dst = blur;
+}
+
+/**
+ * Komiksovy efekt: rozostreni a nahrazeni silnych hran tmavou barvou.
+ *
+ * @param src vstupni obraz
+ * @param dst vystupni (filtrovany obraz)
+ */
+void ReferenceFilter::comics(const cv::Mat& src, cv::Mat& dst)
+{
+    cv::Mat tmp;
+    cv::Mat blur;
+
+    float gaussian_sum = 52.0;
+    float ker5x5[25] = {
+        1.0f/gaussian_sum, 1.0f/gaussian_sum, 2.0f/gaussian_sum, 1.0f/gaussian_sum, 1.0f/gaussian_sum,
+        1.0f/gaussian_sum, 2.0f/gaussian_sum, 4.0f/gaussian_sum, 2.0f/gaussian_sum, 1.0f/gaussian_sum,
+        2.0f/gaussian_sum, 4.0f/gaussian_sum, 8.0f/gaussian_sum, 4.0f/gaussian_sum, 2.0f/gaussian_sum,
+        1.0f/gaussian_sum, 2.0f/gaussian_sum, 4.0f/gaussian_sum, 2.0f/gaussian_sum, 1.0f/gaussian_sum,
+        1.0f/gaussian_sum, 1.0f/gaussian_sum, 2.0f/gaussian_sum, 1.0f/gaussian_sum, 1.0f/gaussian_sum,
+    };
+
+    cv::Mat kernel5x5(5, 5, CV_32FC1, ker5x5);
+
+    cv::flip(kernel5x5, kernel5x5, -1);
+    cv::filter2D(src, blur, -1, kernel5x5);
+
+    edgeGrayFourDirEqu(blur, tmp);
+    int d = 30;
+
+    dst = src.clone();
+
+    for (int i = 0; i < dst.cols; i++)
+    {
+        for (int j = 0; j < dst.rows; j++)
+        {
+            if (tmp.at<uchar>(j, i) > 220)
+            {
+                dst.at<cv::Vec3b>(j, i) = cv::Vec3b(d, d, d);
+            }
+            else
+            {
+                dst.at<cv::Vec3b>(j, i) = blur.at<cv::Vec3b>(j, i);
+            }
+        }
+    }
+}
+
+/**
+ * Efekt skla: Voronoiovy regiony kolem nahodnych seminek v bunkach 10x10
+ * (seminko urcuje jas bunky), region ma prumernou barvu svych pixelu.
+ * Obrazek bez cele bunky (puvodni implementace u nej padala) se kopiruje.
+ *
+ * @param src vstupni obraz
+ * @param dst vystupni (filtrovany obraz)
+ */
+void ReferenceFilter::glass(const cv::Mat& src, cv::Mat& dst)
+{
+    int region_size = 10;
+
+    vector<int> seedX;
+    vector<int> seedY;
+
+    for (int i = 0; i + region_size < src.cols; i = i + region_size)
+    {
+        for (int j = 0; j + region_size < src.rows; j = j + region_size)
+        {
+            int sumR = 0;
+            int sumG = 0;
+            int sumB = 0;
+            for (int k = i; k < (i + region_size); k++)
+            {
+                for (int l = j; l < (j + region_size); l++)
+                {
+                    cv::Vec3b p = src.at<cv::Vec3b>(l, k);
+                    sumR += p.val[2];
+                    sumG += p.val[1];
+                    sumB += p.val[0];
+                }
+            }
+
+            srand((sumR + sumG + sumB) / 3);
+            int vx = rand() % region_size + i;
+            int vy = rand() % region_size + j;
+
+            seedX.push_back(vx);
+            seedY.push_back(vy);
+        }
+    }
+
+    dst = src.clone();
+
+    if (seedX.empty())
+    {
+        return;
+    }
+
+    vector<int> totalR(seedX.size(), 0);
+    vector<int> totalG(seedX.size(), 0);
+    vector<int> totalB(seedX.size(), 0);
+    vector<int> count(seedX.size(), 0);
+    cv::Mat labels(src.rows, src.cols, CV_32SC1);
+
+    for (int i = 0; i < src.cols; i++)
+    {
+        for (int j = 0; j < src.rows; j++)
+        {
+            int nearest = src.cols + src.rows;
+            int nearestSeed = 0;
+
+            for (size_t s = 0; s != seedX.size(); s++)
+            {
+                int dist = abs(seedX[s] - i) + abs(seedY[s] - j);
+
+                if (nearest > dist)
+                {
+                    nearest = dist;
+                    nearestSeed = (int) s;
+                }
+            }
+
+            cv::Vec3b p = src.at<cv::Vec3b>(j, i);
+            totalR[nearestSeed] += p.val[2];
+            totalG[nearestSeed] += p.val[1];
+            totalB[nearestSeed] += p.val[0];
+            count[nearestSeed]++;
+            labels.at<int>(j, i) = nearestSeed;
+        }
+    }
+
+    for (int i = 0; i < src.cols; i++)
+    {
+        for (int j = 0; j < src.rows; j++)
+        {
+            int s = labels.at<int>(j, i);
+            cv::Vec3b q;
+
+            q.val[2] = std::min(totalR[s] / count[s], 255);
+            q.val[1] = std::min(totalG[s] / count[s], 255);
+            q.val[0] = std::min(totalB[s] / count[s], 255);
+
+            dst.at<cv::Vec3b>(j, i) = q;
+        }
+    }
+}
@@ -0,0 +1,47 @@
+/*
+ * Soubor: ReferenceFilter.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef REFERENCEFILTER_H
+#define	REFERENCEFILTER_H
+
+#include <opencv2/core/core.hpp> // cv::Mat
+
+#include "ImageFilter.h"
+
+/**
+ * Puvodni (neoptimalizovane) implementace filtru: cv::filter2D s maskami
+ * ve float a smycky po pixelech. Slouzi jako reference pro kontrolu, ze
+ * optimalizace ImageFilter nemeni vysledek (FilterCheck), a proto se
+ * nesmi menit spolu s ImageFilter.
+ *
+ * Vstup se pred filtraci zkopiruje, vyrez (ROI) se tak filtruje jako
+ * samostatny obraz (okolni pixely rodicovskeho obrazu se nectou).
+ */
+class ReferenceFilter
+{
+    public:
+
+        static void filter(const cv::Mat& src, cv::Mat& dst, ImageFilter::Type filterType);
+
+    private:
+
+        static void edgeGray(const cv::Mat& src, cv::Mat& dst, const float ker[9]);
+        static void edgeGrayFourDir(const cv::Mat& src, cv::Mat& dst);
+        static void edgeGrayFourMax(const cv::Mat& src, cv::Mat& dst);
+        static void edgeGrayFourDirEqu(const cv::Mat& src, cv::Mat& dst);
+
+        static void gradientMagnitude(const cv::Mat& src, cv::Mat& dst,
+                                      const float ker1[9], const float ker2[9]);
+
+        static void sobelColor(const cv::Mat& src, cv::Mat& dst);
+        static void comics(const cv::Mat& src, cv::Mat& dst);
+        static void glass(const cv::Mat& src, cv::Mat& dst);
+};
+
+#endif	/* REFERENCEFILTER_H */
@@ -0,0 +1,97 @@
+/*
+ * Soubor: ReorderBuffer.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "ReorderBuffer.h"
+
+#include <algorithm>
+
+/**
+ * Konstruktor.
+ *
+ * @param capacity nejvyssi pocet snimku v bufferu (aspon 1)
+ */
+ReorderBuffer::ReorderBuffer(size_t capacity)
+    : mFrames(std::max(capacity, (size_t) 1))
+    , mFilled(mFrames.size(), 0)
+    , mNext(0)
+    , mClosed(false)
+{
+}
+
+/**
+ * Vlozeni snimku, ceka, dokud snimek nelezi mene nez capacity snimku za
+ * dalsim vybiranym.
+ *
+ * @param index poradi snimku (kazdy index nejvyse jednou)
+ * @param image snimek (buffer drzi odkaz, data se nekopiruji)
+ * @return false - buffer je uzavren
+ */
+bool ReorderBuffer::push(int index, const cv::Mat& image)
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    int capacity = (int) mFrames.size();
+
+    mSpace.wait(lock, [&] { return mClosed || index < mNext + capacity; });
+
+    if (mClosed)
+    {
+        return false;
+    }
+
+    mFrames[index % capacity] = image;
+    mFilled[index % capacity] = 1;
+
+    if (index == mNext)
+    {
+        mReady.notify_one();
+    }
+
+    return true;
+}
+
+/**
+ * Vybrani dalsiho snimku v poradi, ceka na jeho vlozeni.
+ *
+ * @param frame vystupni snimek
+ * @return false - buffer je uzavren a dalsi snimek nebyl vlozen
+ */
+bool ReorderBuffer::pop(FrameQueue::Frame* frame)
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    int slot = mNext % (int) mFrames.size();
+
+    mReady.wait(lock, [&] { return mClosed || mFilled[slot]; });
+
+    if (!mFilled[slot])
+    {
+        return false;
+    }
+
+    frame->index = mNext;
+    frame->image = mFrames[slot];
+    mFrames[slot].release();
+    mFilled[slot] = 0;
+    mNext++;
+    mSpace.notify_all();
+
+    return true;
+}
+
+/**
+ * Uzavreni bufferu: dalsi vkladani selze, vybirani vrati zbyle snimky
+ * v poradi az do prvni mezery.
+ */
+void ReorderBuffer::close()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mClosed = true;
+    mReady.notify_all();
+    mSpace.notify_all();
+}
@@ -0,0 +1,50 @@
+/*
+ * Soubor: ReorderBuffer.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef REORDERBUFFER_H
+#define	REORDERBUFFER_H
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include <opencv2/core/core.hpp> // cv::Mat
+
+#include "FrameQueue.h"
+
+/**
+ * Obnoveni poradi snimku filtrovanych paralelne nekolika vlakny. Snimky
+ * se vkladaji v libovolnem poradi, vybiraji vzdy v poradi videa. Buffer
+ * ma capacity mist (kruhove podle indexu snimku): snimek, ktery je od
+ * dalsiho vybiraneho o capacity a vic napred, ceka na misto, takze
+ * v bufferu je nejvyse capacity snimku. Snimky se do vlaken rozdeluji
+ * v poradi, dalsi vybirany snimek proto vzdy misto ma.
+ */
+class ReorderBuffer
+{
+    private:
+
+        std::mutex mMutex;
+        std::condition_variable mReady;  // dalsi snimek v poradi je vlozen
+        std::condition_variable mSpace;  // posunul se dalsi vybirany snimek
+        std::vector<cv::Mat> mFrames;
+        std::vector<unsigned char> mFilled;
+        int mNext;                       // dalsi vybirany snimek
+        bool mClosed;
+
+    public:
+
+        explicit ReorderBuffer(size_t capacity);
+
+        bool push(int index, const cv::Mat& image);
+        bool pop(FrameQueue::Frame* frame);
+        void close();
+};
+
+#endif	/* REORDERBUFFER_H */
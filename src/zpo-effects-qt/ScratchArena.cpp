@@ -0,0 +1,74 @@
+/*
+ * Soubor: ScratchArena.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "ScratchArena.h"
+
+#include "BufferPool.h"
+
+// Sada nastavena pro aktualni vlakno (nullptr - vlastni sada vlakna)
+static thread_local ScratchArena* tArena = nullptr;
+
+/**
+ * Ziskani pracovniho bufferu. Obsah bufferu neni definovan.
+ *
+ * @param slot slot mezivysledku
+ * @param size pozadovana velikost
+ * @param type pozadovany typ
+ * @return buffer se zarovnanymi radky
+ */
+cv::Mat& ScratchArena::get(Slot slot, cv::Size size, int type)
+{
+    cv::Mat& mat = mSlots[slot];
+
+    if (mat.size() != size || mat.type() != type || !BufferPool::isExclusive(mat))
+    {
+        mat = BufferPool::createAligned(size, type);
+    }
+
+    return mat;
+}
+
+/**
+ * Uvolneni vsech bufferu.
+ */
+void ScratchArena::clear()
+{
+    for (cv::Mat& mat : mSlots)
+    {
+        mat.release();
+    }
+}
+
+/**
+ * Pracovni buffery aktualniho vlakna (pripadne sada nastavena Scope).
+ *
+ * @return buffery vlakna
+ */
+ScratchArena& ScratchArena::local()
+{
+    static thread_local ScratchArena arena;
+
+    return tArena != nullptr ? *tArena : arena;
+}
+
+/**
+ * Nastaveni sady pro aktualni vlakno.
+ *
+ * @param arena sada (nullptr - vlastni sada vlakna)
+ */
+ScratchArena::Scope::Scope(ScratchArena* arena)
+    : mPrevious(tArena)
+{
+    tArena = arena;
+}
+
+ScratchArena::Scope::~Scope()
+{
+    tArena = mPrevious;
+}
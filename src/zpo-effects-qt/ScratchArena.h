@@ -0,0 +1,80 @@
+/*
+ * Soubor: ScratchArena.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef SCRATCHARENA_H
+#define	SCRATCHARENA_H
+
+#include <opencv2/core/core.hpp> // cv::Mat
+
+/**
+ * Pracovni buffery filtru (mezivysledky). Kazde vlakno ma vlastni sadu,
+ * buffer je alokovan jen pri zmene velikosti nebo typu, takze pri filtraci
+ * videa konstantni velikosti se po prvnim snimku jiz nealokuje.
+ *
+ * Kazdy mezivysledek ma vlastni slot; filtr, ktery vola jiny filtr, nesmi
+ * pouzivat stejny slot jako volany filtr. Ulohy TaskScheduler pouzivaji
+ * jen sloty, ktere nepouziva zadny filtr primo (TILE_*, DISTANCES), protoze
+ * vlakno, ktere uvnitr filtru ceka na ulohy, mezitim vykonava ulohy filtru.
+ * Cele filtry jako ulohy planovace musi mit kazdy vlastni sadu (Scope).
+ */
+class ScratchArena
+{
+    public:
+
+        enum Slot
+        {
+            GRAY,
+            BLUR,
+            TMP,
+            BGR,
+            LABELS,
+            DISTANCES,
+            SEEDS,
+            REGIONS,
+            TILE_BLUR,
+            TILE_GRAY,
+            TILE_COLOR,
+            TILE_SOURCE,
+            PLANES,
+            SLOT_COUNT
+        };
+
+        /**
+         * Nahrazeni sady aktualniho vlakna jinou sadou, na konci bloku se
+         * obnovi predchozi. Ulohy planovace, ktere vlakno mezitim vykona,
+         * pouzivaji tutez sadu (jen sloty TILE_*, DISTANCES).
+         */
+        class Scope
+        {
+            private:
+
+                ScratchArena* mPrevious;
+
+            public:
+
+                explicit Scope(ScratchArena* arena);
+                ~Scope();
+
+                Scope(const Scope&) = delete;
+                Scope& operator=(const Scope&) = delete;
+        };
+
+    private:
+
+        cv::Mat mSlots[SLOT_COUNT];
+
+    public:
+
+        cv::Mat& get(Slot slot, cv::Size size, int type);
+        void clear();
+
+        static ScratchArena& local();
+};
+
+#endif	/* SCRATCHARENA_H */
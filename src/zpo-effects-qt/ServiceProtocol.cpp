@@ -0,0 +1,352 @@
+/*
+ * Soubor: ServiceProtocol.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "ServiceProtocol.h"
+
+#include <cstring>
+
+#ifdef __linux__
+    #include <sys/socket.h>
+    #include <sys/un.h>
+    #include <unistd.h>
+    #include <cerrno>
+#endif
+
+static const char REQUEST_MAGIC[4] = { 'Z', 'P', 'O', 'Q' };
+static const char RESPONSE_MAGIC[4] = { 'Z', 'P', 'O', 'A' };
+
+// Delka fronty nevyrizenych spojeni
+static const int BACKLOG = 128;
+
+/**
+ * Hlavicka pozadavku.
+ *
+ * @param command prikaz
+ * @param filterType typ filtru (ImageFilter::Type)
+ * @param size velikost obrazku
+ * @param channels pocet kanalu obrazku
+ * @return hlavicka
+ */
+ServiceProtocol::Request ServiceProtocol::request(Command command, int filterType, cv::Size size, int channels)
+{
+    Request request;
+    std::memcpy(request.magic, REQUEST_MAGIC, sizeof(REQUEST_MAGIC));
+    request.command = command;
+    request.filterType = filterType;
+    request.width = size.width;
+    request.height = size.height;
+    request.channels = channels;
+
+    return request;
+}
+
+/**
+ * Hlavicka odpovedi.
+ *
+ * @param status vysledek
+ * @param size velikost obrazku
+ * @param channels pocet kanalu obrazku
+ * @param length delka dat za hlavickou
+ * @return hlavicka
+ */
+ServiceProtocol::Response ServiceProtocol::response(Status status, cv::Size size, int channels, int length)
+{
+    Response response;
+    std::memcpy(response.magic, RESPONSE_MAGIC, sizeof(RESPONSE_MAGIC));
+    response.status = status;
+    response.width = size.width;
+    response.height = size.height;
+    response.channels = channels;
+    response.length = length;
+
+    return response;
+}
+
+/**
+ * Kontrola hlavicky pozadavku (u FILTER i velikosti obrazku).
+ *
+ * @param request hlavicka
+ * @return true - pozadavek lze zpracovat
+ */
+bool ServiceProtocol::isValid(const Request& request)
+{
+    if (std::memcmp(request.magic, REQUEST_MAGIC, sizeof(REQUEST_MAGIC)) != 0)
+    {
+        return false;
+    }
+
+    if (request.command == STATS)
+    {
+        return true;
+    }
+
+    return request.command == FILTER && request.channels == 3
+           && request.width > 0 && request.height > 0
+           && (int64_t) request.width * request.height <= MAX_PIXELS;
+}
+
+/**
+ * Kontrola hlavicky odpovedi.
+ *
+ * @param response hlavicka
+ * @return true - hlavicka odpovedi sluzby
+ */
+bool ServiceProtocol::isValid(const Response& response)
+{
+    return std::memcmp(response.magic, RESPONSE_MAGIC, sizeof(RESPONSE_MAGIC)) == 0 && response.length >= 0;
+}
+
+/**
+ * Nacteni pixelu obrazku (radky bez zarovnani).
+ *
+ * @param fd socket
+ * @param image obrazek ocekavane velikosti a typu
+ * @return false - spojeni skoncilo
+ */
+bool ServiceProtocol::readPixels(int fd, cv::Mat& image)
+{
+    size_t rowBytes = image.cols * image.elemSize();
+
+    if (image.isContinuous())
+    {
+        return readFully(fd, image.data, rowBytes * image.rows);
+    }
+
+    for (int j = 0; j < image.rows; j++)
+    {
+        if (!readFully(fd, image.ptr(j), rowBytes))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Zapis pixelu obrazku (radky bez zarovnani).
+ *
+ * @param fd socket
+ * @param image obrazek
+ * @return false - spojeni skoncilo
+ */
+bool ServiceProtocol::writePixels(int fd, const cv::Mat& image)
+{
+    size_t rowBytes = image.cols * image.elemSize();
+
+    if (image.isContinuous())
+    {
+        return writeFully(fd, image.data, rowBytes * image.rows);
+    }
+
+    for (int j = 0; j < image.rows; j++)
+    {
+        if (!writeFully(fd, image.ptr(j), rowBytes))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+#ifdef __linux__
+
+/**
+ * Vytvoreni naslouchajiciho socketu (existujici soubor socketu se smaze).
+ *
+ * @param path cesta k socketu
+ * @return socket, -1 - chyba
+ */
+int ServiceProtocol::listen(const std::string& path)
+{
+    struct sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        return -1;
+    }
+
+    std::strcpy(address.sun_path, path.c_str());
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    ::unlink(path.c_str());
+
+    if (::bind(fd, (struct sockaddr*) &address, sizeof(address)) != 0 || ::listen(fd, BACKLOG) != 0)
+    {
+        ::close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+/**
+ * Prijeti dalsiho spojeni (ceka na klienta).
+ *
+ * @param listener naslouchajici socket
+ * @return socket spojeni, -1 - chyba
+ */
+int ServiceProtocol::accept(int listener)
+{
+    return ::accept(listener, nullptr, nullptr);
+}
+
+/**
+ * Pripojeni k socketu sluzby.
+ *
+ * @param path cesta k socketu
+ * @return socket, -1 - chyba
+ */
+int ServiceProtocol::connect(const std::string& path)
+{
+    struct sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        return -1;
+    }
+
+    std::strcpy(address.sun_path, path.c_str());
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    if (::connect(fd, (struct sockaddr*) &address, sizeof(address)) != 0)
+    {
+        ::close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+/**
+ * Uzavreni socketu.
+ *
+ * @param fd socket
+ */
+void ServiceProtocol::close(int fd)
+{
+    if (fd >= 0)
+    {
+        ::close(fd);
+    }
+}
+
+/**
+ * Nacteni presne length bajtu.
+ *
+ * @param fd socket
+ * @param data vystupni buffer
+ * @param length pocet bajtu
+ * @return false - spojeni skoncilo nebo chyba
+ */
+bool ServiceProtocol::readFully(int fd, void* data, size_t length)
+{
+    char* bytes = (char*) data;
+
+    while (length > 0)
+    {
+        ssize_t count = ::recv(fd, bytes, length, 0);
+
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (count <= 0)
+        {
+            return false;
+        }
+
+        bytes += count;
+        length -= count;
+    }
+
+    return true;
+}
+
+/**
+ * Zapis presne length bajtu (uzavrene spojeni neukonci proces signalem).
+ *
+ * @param fd socket
+ * @param data data
+ * @param length pocet bajtu
+ * @return false - spojeni skoncilo nebo chyba
+ */
+bool ServiceProtocol::writeFully(int fd, const void* data, size_t length)
+{
+    const char* bytes = (const char*) data;
+
+    while (length > 0)
+    {
+        ssize_t count = ::send(fd, bytes, length, MSG_NOSIGNAL);
+
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (count <= 0)
+        {
+            return false;
+        }
+
+        bytes += count;
+        length -= count;
+    }
+
+    return true;
+}
+
+#else
+
+int ServiceProtocol::listen(const std::string&)
+{
+    return -1;
+}
+
+int ServiceProtocol::accept(int)
+{
+    return -1;
+}
+
+int ServiceProtocol::connect(const std::string&)
+{
+    return -1;
+}
+
+void ServiceProtocol::close(int)
+{
+}
+
+bool ServiceProtocol::readFully(int, void*, size_t)
+{
+    return false;
+}
+
+bool ServiceProtocol::writeFully(int, const void*, size_t)
+{
+    return false;
+}
+
+#endif
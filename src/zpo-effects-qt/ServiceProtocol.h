@@ -0,0 +1,83 @@
+/*
+ * Soubor: ServiceProtocol.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef SERVICEPROTOCOL_H
+#define	SERVICEPROTOCOL_H
+
+#include <cstdint>
+#include <string>
+
+#include <opencv2/core/core.hpp> // cv::Mat
+
+/**
+ * Protokol filtrovaci sluzby na Unix domain socketu (FilterService.h).
+ * Klient posila pozadavky a na kazdy ceka odpoved; hlavicky jsou
+ * 32bitova cisla v poradi bajtu stroje (socket je jen lokalni), obrazky
+ * nasleduji jako radky pixelu bez zarovnani. Klientovi tak staci socket,
+ * nemusi linkovat Qt ani OpenCV.
+ */
+class ServiceProtocol
+{
+    public:
+
+        enum Command
+        {
+            FILTER = 1,     // za hlavickou obrazek BGR, odpoved vysledek filtru
+            STATS = 2       // odpoved text statistik sluzby
+        };
+
+        enum Status
+        {
+            OK = 0,
+            BAD_REQUEST = 1,
+            FAILED = 2
+        };
+
+        // Nejvetsi obrazek pozadavku (pixely)
+        static const int32_t MAX_PIXELS = 100000000;
+
+        struct Request
+        {
+            char magic[4];          // "ZPOQ"
+            int32_t command;        // Command
+            int32_t filterType;     // ImageFilter::Type
+            int32_t width;
+            int32_t height;
+            int32_t channels;       // 3 (BGR)
+        };
+
+        struct Response
+        {
+            char magic[4];          // "ZPOA"
+            int32_t status;         // Status
+            int32_t width;
+            int32_t height;
+            int32_t channels;       // 1 nebo 3
+            int32_t length;         // delka dat za hlavickou v bajtech
+        };
+
+    public:
+
+        static Request request(Command command, int filterType, cv::Size size, int channels);
+        static Response response(Status status, cv::Size size, int channels, int length);
+        static bool isValid(const Request& request);
+        static bool isValid(const Response& response);
+
+        static int listen(const std::string& path);
+        static int accept(int listener);
+        static int connect(const std::string& path);
+        static void close(int fd);
+
+        static bool readFully(int fd, void* data, size_t length);
+        static bool writeFully(int fd, const void* data, size_t length);
+        static bool readPixels(int fd, cv::Mat& image);
+        static bool writePixels(int fd, const cv::Mat& image);
+};
+
+#endif	/* SERVICEPROTOCOL_H */
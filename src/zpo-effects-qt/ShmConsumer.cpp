@@ -0,0 +1,91 @@
+/*
+ * Soubor: ShmConsumer.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "ShmConsumer.h"
+
+#include <cstdio>
+#include <iostream>
+
+#include "LatencyStats.h"
+#include "ShmRing.h"
+
+/**
+ * Spusteni ctouciho procesu. Ceka na vytvoreni bufferu a pak odebira
+ * snimky, dokud zapisujici strana neskonci.
+ *
+ * @param commandLine argumenty prikazove radky (buffer)
+ * @return navratovy kod programu
+ */
+int ShmConsumer::run(const CommandLine& commandLine)
+{
+    const std::string& name = commandLine.getShmInput();
+
+    ShmRing ring;
+
+    std::cout << "waiting for " << name << std::endl;
+
+    if (!ring.open(name, -1))
+    {
+        std::cerr << "Could not open shared memory: " << name << std::endl;
+        return 1;
+    }
+
+    ring.markReady();
+
+    LatencyStats latency;
+    uint64_t expected = 0;
+    long long frames = 0;
+    long long outOfOrder = 0;
+    long long start = 0;
+    long long end = 0;
+
+    while (ring.waitReadable(-1))
+    {
+        uint64_t sequence;
+        long long timestamp;
+        cv::Mat frame = ring.beginRead(&sequence, &timestamp);
+        long long now = cv::getTickCount();
+
+        if (frames == 0)
+        {
+            start = now;
+        }
+        else if (sequence != expected)
+        {
+            outOfOrder++;
+        }
+
+        end = now;
+        latency.add((now - timestamp) * 1000.0 / cv::getTickFrequency());
+        expected = sequence + 1;
+        frames++;
+
+        ring.endRead();
+    }
+
+    // Od prvniho do posledniho snimku
+    double seconds = (end - start) / cv::getTickFrequency();
+    cv::Size size = ring.size();
+
+    char line[256];
+    snprintf(line, sizeof(line), "%lld frames %dx%d in %.2f s, %.1f fps",
+             frames, size.width, size.height, seconds, seconds > 0 ? (frames - 1) / seconds : 0.0);
+    std::cout << line << std::endl;
+
+    snprintf(line, sizeof(line), "latency ms: p50 %.3f  p95 %.3f  p99 %.3f  max %.3f",
+             latency.percentile(50), latency.percentile(95), latency.percentile(99), latency.percentile(100));
+    std::cout << line << std::endl;
+
+    if (outOfOrder > 0)
+    {
+        std::cerr << outOfOrder << " frames out of sequence" << std::endl;
+    }
+
+    return frames > 0 && outOfOrder == 0 ? 0 : 1;
+}
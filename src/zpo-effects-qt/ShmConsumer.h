@@ -0,0 +1,28 @@
+/*
+ * Soubor: ShmConsumer.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef SHMCONSUMER_H
+#define	SHMCONSUMER_H
+
+#include "CommandLine.h"
+
+/**
+ * Vzorovy ctouci proces pro mereni latence sdilene pameti (ShmRing.h):
+ * odebira snimky z bufferu --shm-input, dokud zapisujici strana neskonci,
+ * a vypise snimky za sekundu a percentily latence od zapisu snimku
+ * (u retezce pres --shm-filter od zapisu puvodniho snimku).
+ */
+class ShmConsumer
+{
+    public:
+
+        static int run(const CommandLine& commandLine);
+};
+
+#endif	/* SHMCONSUMER_H */
@@ -0,0 +1,94 @@
+/*
+ * Soubor: ShmProducer.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "ShmProducer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "ShmRing.h"
+
+// Mista bufferu (snimky, ktere mohou cekat na ctouci stranu)
+static const int RING_SLOTS = 4;
+
+// Ruzne nahodne snimky, ktere se posilaji dokola
+static const int PATTERN_FRAMES = 4;
+
+/**
+ * Spusteni zapisujiciho procesu.
+ *
+ * @param commandLine argumenty prikazove radky (buffer, velikost, pocet
+ *                    snimku, snimky za sekundu)
+ * @return navratovy kod programu
+ */
+int ShmProducer::run(const CommandLine& commandLine)
+{
+    const std::string& name = commandLine.getShmOutput();
+    cv::Size size = commandLine.getSizes().empty() ? cv::Size(1920, 1080) : commandLine.getSizes().front();
+    int frames = commandLine.getIterations();
+    double fps = commandLine.getFps();
+
+    ShmRing ring;
+
+    if (!ring.create(name, size, CV_8UC3, RING_SLOTS))
+    {
+        std::cerr << "Could not create shared memory: " << name << std::endl;
+        return 1;
+    }
+
+    std::vector<cv::Mat> patterns(PATTERN_FRAMES);
+    for (cv::Mat& pattern : patterns)
+    {
+        pattern.create(size, CV_8UC3);
+        cv::randu(pattern, cv::Scalar::all(0), cv::Scalar::all(256));
+    }
+
+    std::cout << "waiting for reader of " << name << std::endl;
+    ring.waitReady(-1);
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    long long start = cv::getTickCount();
+    int fullWaits = 0;
+
+    for (int i = 0; i < frames; i++)
+    {
+        if (fps > 0)
+        {
+            std::this_thread::sleep_until(begin + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                                      std::chrono::duration<double>(i / fps)));
+        }
+
+        cv::Mat slot = ring.beginWrite();
+
+        if (slot.empty())
+        {
+            // Ctouci strana nestiha, snimek se zdrzi (zadny se nezahodi)
+            fullWaits++;
+            ring.waitWritable(-1);
+            slot = ring.beginWrite();
+        }
+
+        patterns[i % PATTERN_FRAMES].copyTo(slot);
+        ring.commitWrite(cv::getTickCount());
+    }
+
+    ring.finish();
+
+    double seconds = (cv::getTickCount() - start) / cv::getTickFrequency();
+
+    char line[256];
+    snprintf(line, sizeof(line), "%d frames %dx%d in %.2f s, %.1f fps, ring full %d times",
+             frames, size.width, size.height, seconds, seconds > 0 ? frames / seconds : 0.0, fullWaits);
+    std::cout << line << std::endl;
+
+    return 0;
+}
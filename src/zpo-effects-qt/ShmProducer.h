@@ -0,0 +1,28 @@
+/*
+ * Soubor: ShmProducer.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef SHMPRODUCER_H
+#define	SHMPRODUCER_H
+
+#include "CommandLine.h"
+
+/**
+ * Vzorovy zapisujici proces pro mereni latence sdilene pameti (ShmRing.h):
+ * vytvori buffer --shm-output, pocka na ctouci stranu a posle -n snimku
+ * velikosti --size rychlosti --fps (kopie predem vytvorenych nahodnych
+ * snimku, jako by je zapisovala kamera). Cas zapisu nese kazdy snimek.
+ */
+class ShmProducer
+{
+    public:
+
+        static int run(const CommandLine& commandLine);
+};
+
+#endif	/* SHMPRODUCER_H */
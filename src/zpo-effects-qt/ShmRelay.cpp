@@ -0,0 +1,103 @@
+/*
+ * Soubor: ShmRelay.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "ShmRelay.h"
+
+#include <cstdio>
+#include <iostream>
+
+#include "ImageFilter.h"
+#include "LatencyStats.h"
+#include "ShmRing.h"
+
+// Mista vystupniho bufferu
+static const int RING_SLOTS = 4;
+
+/**
+ * Spusteni filtrace. Vystupni buffer se vytvori podle vstupniho, vstupni
+ * strana se pusti, az si vystup pripoji ctouci proces.
+ *
+ * @param commandLine argumenty prikazove radky (buffery, filtr)
+ * @return navratovy kod programu
+ */
+int ShmRelay::run(const CommandLine& commandLine)
+{
+    const std::string& inputName = commandLine.getShmInput();
+    const std::string& outputName = commandLine.getShmOutput();
+    ImageFilter::Type filterType = commandLine.getFilterTypes().front();
+
+    ShmRing input;
+    ShmRing output;
+
+    std::cout << "waiting for " << inputName << std::endl;
+
+    if (!input.open(inputName, -1))
+    {
+        std::cerr << "Could not open shared memory: " << inputName << std::endl;
+        return 1;
+    }
+
+    if (!output.create(outputName, input.size(), ImageFilter::outputType(filterType, input.type()), RING_SLOTS))
+    {
+        std::cerr << "Could not create shared memory: " << outputName << std::endl;
+        return 1;
+    }
+
+    std::cout << "waiting for reader of " << outputName << std::endl;
+    output.waitReady(-1);
+    input.markReady();
+
+    LatencyStats latency;
+    long long frames = 0;
+    long long start = 0;
+
+    while (input.waitReadable(-1))
+    {
+        long long timestamp;
+        cv::Mat src = input.beginRead(nullptr, &timestamp);
+
+        output.waitWritable(-1);
+        cv::Mat slot = output.beginWrite();
+        cv::Mat dst = slot;
+
+        if (frames == 0)
+        {
+            start = cv::getTickCount();
+        }
+
+        ImageFilter::filter(src, dst, filterType);
+
+        // Filtr, ktery vystup nezapsal do mista, ale vytvoril novy
+        if (dst.data != slot.data)
+        {
+            dst.copyTo(slot);
+        }
+
+        output.commitWrite(timestamp);
+        input.endRead();
+
+        latency.add((cv::getTickCount() - timestamp) * 1000.0 / cv::getTickFrequency());
+        frames++;
+    }
+
+    output.finish();
+
+    double seconds = (cv::getTickCount() - start) / cv::getTickFrequency();
+
+    char line[256];
+    snprintf(line, sizeof(line), "%s: %lld frames in %.2f s, %.1f fps",
+             ImageFilter::typeName(filterType), frames, seconds, seconds > 0 ? frames / seconds : 0.0);
+    std::cout << line << std::endl;
+
+    snprintf(line, sizeof(line), "latency ms to output: p50 %.3f  p95 %.3f  p99 %.3f  max %.3f",
+             latency.percentile(50), latency.percentile(95), latency.percentile(99), latency.percentile(100));
+    std::cout << line << std::endl;
+
+    return frames > 0 ? 0 : 1;
+}
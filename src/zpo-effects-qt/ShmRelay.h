@@ -0,0 +1,30 @@
+/*
+ * Soubor: ShmRelay.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef SHMRELAY_H
+#define	SHMRELAY_H
+
+#include "CommandLine.h"
+
+/**
+ * Filtrace snimku ze sdilene pameti do sdilene pameti bez GUI: snimek se
+ * filtruje primo z mista vstupniho bufferu (--shm-input) do mista
+ * vystupniho bufferu (--shm-output, vytvori se podle velikosti vstupu
+ * a vystupniho typu filtru), bez kopirovani snimku. Vystupni
+ * snimek nese cas puvodniho snimku, ctouci strana tak meri latenci celeho
+ * retezce.
+ */
+class ShmRelay
+{
+    public:
+
+        static int run(const CommandLine& commandLine);
+};
+
+#endif	/* SHMRELAY_H */
@@ -0,0 +1,595 @@
+/*
+ * Soubor: ShmRing.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "ShmRing.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#ifdef __linux__
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+// Citace musi byt atomicke bez zamku, jinak je nelze sdilet mezi procesy
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "shared ring requires lock-free 64-bit atomics");
+
+static const char MAGIC[4] = { 'Z', 'P', 'O', 'R' };
+static const int32_t VERSION = 1;
+
+// Zarovnani radku, mist a citacu (radek cache, SIMD)
+static const int ALIGNMENT = 64;
+
+// Pokusy aktivniho cekani, pak predani procesoru a nakonec uspani
+static const int SPIN_ATTEMPTS = 64;
+static const int YIELD_ATTEMPTS = 256;
+static const int SLEEP_MICROSECONDS = 50;
+
+// Interval pokusu o pripojeni k jeste nevytvorenemu bufferu
+static const int OPEN_RETRY_MILLISECONDS = 10;
+
+/**
+ * Hlavicka sdilene pameti. Citace head (zapisujici) a tail (ctouci) jsou
+ * kazdy ve vlastnim radku cache, aby se strany navzajem nezdrzovaly.
+ */
+struct ShmRingHeader
+{
+    char magic[4];
+    int32_t version;
+    int32_t width;
+    int32_t height;
+    int32_t type;
+    int32_t stride;
+    int32_t slotCount;
+    int32_t slotBytes;
+    int32_t dataOffset;
+    std::atomic<int32_t> ready;
+    std::atomic<int32_t> finished;
+
+    alignas(ALIGNMENT) std::atomic<uint64_t> head;
+    alignas(ALIGNMENT) std::atomic<uint64_t> tail;
+};
+
+/**
+ * Hlavicka mista, pixely nasleduji od SLOT_HEADER.
+ */
+struct ShmSlot
+{
+    uint64_t sequence;
+    int64_t timestamp;
+};
+
+static const int DATA_OFFSET = (sizeof(ShmRingHeader) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+static const int SLOT_HEADER = ALIGNMENT;
+
+/**
+ * Cekani v N-tem pokusu (postupne delsi).
+ *
+ * @param attempt poradi pokusu od 0
+ */
+static void backoff(int attempt)
+{
+    if (attempt < SPIN_ATTEMPTS)
+    {
+        return;
+    }
+
+    if (attempt < YIELD_ATTEMPTS)
+    {
+        std::this_thread::yield();
+    }
+    else
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(SLEEP_MICROSECONDS));
+    }
+}
+
+ShmRing::ShmRing()
+    : mHeader(nullptr)
+    , mLength(0)
+    , mOwner(false)
+    , mPosition(0)
+    , mCachedLimit(0)
+{
+}
+
+ShmRing::~ShmRing()
+{
+    close();
+}
+
+bool ShmRing::isOpen() const
+{
+    return mHeader != nullptr;
+}
+
+/**
+ * Ukazatel na misto snimku.
+ *
+ * @param position pozice snimku (poradove cislo)
+ * @return zacatek mista (hlavicka ShmSlot)
+ */
+uchar* ShmRing::slot(uint64_t position) const
+{
+    return (uchar*) mHeader + mHeader->dataOffset + (position % mHeader->slotCount) * (size_t) mHeader->slotBytes;
+}
+
+/**
+ * Test volneho mista. Pozice ctouci strany se cte ze sdilene pameti, jen
+ * kdyz podle posledni prectene hodnoty neni misto volne.
+ *
+ * @return true - lze zapsat dalsi snimek
+ */
+bool ShmRing::writable()
+{
+    if (mPosition - mCachedLimit < (uint64_t) mHeader->slotCount)
+    {
+        return true;
+    }
+
+    mCachedLimit = mHeader->tail.load(std::memory_order_acquire);
+
+    return mPosition - mCachedLimit < (uint64_t) mHeader->slotCount;
+}
+
+/**
+ * Test zapsaneho snimku (pozice zapisujici strany se cte jen v pripade
+ * potreby, viz writable).
+ *
+ * @return true - lze cist dalsi snimek
+ */
+bool ShmRing::readable()
+{
+    if (mPosition < mCachedLimit)
+    {
+        return true;
+    }
+
+    mCachedLimit = mHeader->head.load(std::memory_order_acquire);
+
+    return mPosition < mCachedLimit;
+}
+
+/**
+ * Misto pro zapis dalsiho snimku (jen zapisujici strana). Snimek se zapise
+ * primo do vraceneho pohledu a zverejni funkci commitWrite.
+ *
+ * @return pohled do mista, prazdny - buffer je plny
+ */
+cv::Mat ShmRing::beginWrite()
+{
+    if (!writable())
+    {
+        return cv::Mat();
+    }
+
+    return cv::Mat(mHeader->height, mHeader->width, mHeader->type, slot(mPosition) + SLOT_HEADER,
+                   mHeader->stride);
+}
+
+/**
+ * Zverejneni snimku zapsaneho do mista z beginWrite.
+ *
+ * @param timestamp cas snimku (cv::getTickCount)
+ */
+void ShmRing::commitWrite(long long timestamp)
+{
+    ShmSlot* header = (ShmSlot*) slot(mPosition);
+    header->sequence = mPosition;
+    header->timestamp = timestamp;
+
+    mPosition++;
+    mHeader->head.store(mPosition, std::memory_order_release);
+}
+
+/**
+ * Cekani na volne misto.
+ *
+ * @param timeoutMs nejdelsi cekani v ms (zaporne - bez omezeni)
+ * @return false - vyprsel cas
+ */
+bool ShmRing::waitWritable(int timeoutMs)
+{
+    std::chrono::steady_clock::time_point deadline =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+    for (int attempt = 0; !writable(); attempt++)
+    {
+        if (timeoutMs >= 0 && std::chrono::steady_clock::now() >= deadline)
+        {
+            return false;
+        }
+
+        backoff(attempt);
+    }
+
+    return true;
+}
+
+/**
+ * Cekani, az ctouci strana zacne snimky odebirat (markReady).
+ *
+ * @param timeoutMs nejdelsi cekani v ms (zaporne - bez omezeni)
+ * @return false - vyprsel cas
+ */
+bool ShmRing::waitReady(int timeoutMs)
+{
+    std::chrono::steady_clock::time_point deadline =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+    for (int attempt = 0; mHeader->ready.load(std::memory_order_acquire) == 0; attempt++)
+    {
+        if (timeoutMs >= 0 && std::chrono::steady_clock::now() >= deadline)
+        {
+            return false;
+        }
+
+        backoff(attempt);
+    }
+
+    return true;
+}
+
+/**
+ * Oznameni konce snimku (zapisujici strana), ctouci strana po precteni
+ * zbyvajicich snimku skonci (isFinished).
+ */
+void ShmRing::finish()
+{
+    mHeader->finished.store(1, std::memory_order_release);
+}
+
+/**
+ * Dalsi snimek ke cteni (jen ctouci strana). Pohled plati do endRead,
+ * pak muze zapisujici strana misto prepsat.
+ *
+ * @param sequence poradove cislo snimku (muze byt nullptr)
+ * @param timestamp cas zapisu snimku (muze byt nullptr)
+ * @return pohled do mista, prazdny - neni zapsany snimek
+ */
+cv::Mat ShmRing::beginRead(uint64_t* sequence, long long* timestamp)
+{
+    if (!readable())
+    {
+        return cv::Mat();
+    }
+
+    const ShmSlot* header = (const ShmSlot*) slot(mPosition);
+
+    if (sequence != nullptr)
+    {
+        *sequence = header->sequence;
+    }
+    if (timestamp != nullptr)
+    {
+        *timestamp = header->timestamp;
+    }
+
+    return cv::Mat(mHeader->height, mHeader->width, mHeader->type, slot(mPosition) + SLOT_HEADER,
+                   mHeader->stride);
+}
+
+/**
+ * Uvolneni mista snimku z beginRead.
+ */
+void ShmRing::endRead()
+{
+    mPosition++;
+    mHeader->tail.store(mPosition, std::memory_order_release);
+}
+
+/**
+ * Oznameni zapisujici strane, ze ctouci strana odebira snimky.
+ */
+void ShmRing::markReady()
+{
+    mHeader->ready.store(1, std::memory_order_release);
+}
+
+/**
+ * Cekani na zapsany snimek.
+ *
+ * @param timeoutMs nejdelsi cekani v ms (zaporne - bez omezeni)
+ * @return false - vyprsel cas nebo zapisujici strana skoncila
+ */
+bool ShmRing::waitReadable(int timeoutMs)
+{
+    std::chrono::steady_clock::time_point deadline =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+    for (int attempt = 0; !readable(); attempt++)
+    {
+        if (isFinished() || (timeoutMs >= 0 && std::chrono::steady_clock::now() >= deadline))
+        {
+            return false;
+        }
+
+        backoff(attempt);
+    }
+
+    return true;
+}
+
+/**
+ * Preskoceni starsich snimku, dalsi cteny snimek je posledni zapsany
+ * (nahled, ktery nestiha vsechny snimky, zobrazuje nejnovejsi).
+ *
+ * @return pocet preskocenych snimku
+ */
+int ShmRing::skipToLatest()
+{
+    mCachedLimit = mHeader->head.load(std::memory_order_acquire);
+
+    if (mCachedLimit <= mPosition + 1)
+    {
+        return 0;
+    }
+
+    int skipped = (int) (mCachedLimit - 1 - mPosition);
+    mPosition = mCachedLimit - 1;
+    mHeader->tail.store(mPosition, std::memory_order_release);
+
+    return skipped;
+}
+
+/**
+ * Test konce snimku.
+ *
+ * @return true - zapisujici strana skoncila a vsechny snimky jsou prectene
+ */
+bool ShmRing::isFinished()
+{
+    return mHeader->finished.load(std::memory_order_acquire) != 0 && !readable();
+}
+
+/**
+ * Pripojeni k bufferu (ctouci strana), cteni pokracuje za poslednim
+ * snimkem prectenym predchozim ctenarem.
+ *
+ * @param name nazev bufferu
+ * @param timeoutMs jak dlouho cekat na vytvoreni bufferu v ms (zaporne - bez
+ *                  omezeni)
+ * @return false - buffer neexistuje ani po timeoutMs
+ */
+bool ShmRing::open(const std::string& name, int timeoutMs)
+{
+    close();
+
+    std::chrono::steady_clock::time_point deadline =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+    while (!attach(name))
+    {
+        if (timeoutMs >= 0 && std::chrono::steady_clock::now() >= deadline)
+        {
+            return false;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(OPEN_RETRY_MILLISECONDS));
+    }
+
+    return true;
+}
+
+cv::Size ShmRing::size() const
+{
+    return cv::Size(mHeader->width, mHeader->height);
+}
+
+int ShmRing::type() const
+{
+    return mHeader->type;
+}
+
+int ShmRing::slotCount() const
+{
+    return mHeader->slotCount;
+}
+
+#ifdef __linux__
+
+/**
+ * Nazev objektu sdilene pameti pro shm_open (zacina lomitkem).
+ *
+ * @param name nazev bufferu
+ * @return nazev objektu
+ */
+static std::string objectName(const std::string& name)
+{
+    return !name.empty() && name[0] == '/' ? name : "/" + name;
+}
+
+/**
+ * Typy snimku, ktere buffer prenasi (vstupy a vystupy filtru).
+ *
+ * @param type typ OpenCV z hlavicky
+ * @return true - CV_8UC1 nebo CV_8UC3
+ */
+static bool isSupportedType(int32_t type)
+{
+    return type == CV_8UC1 || type == CV_8UC3;
+}
+
+/**
+ * Vytvoreni bufferu (zapisujici strana). Buffer stejneho nazvu, ktery
+ * zustal po ukoncenem procesu, se nahradi.
+ *
+ * @param name nazev bufferu
+ * @param size velikost snimku
+ * @param type typ OpenCV (napr. CV_8UC3)
+ * @param slotCount pocet mist
+ * @return false - sdilenou pamet nelze vytvorit nebo namapovat
+ */
+bool ShmRing::create(const std::string& name, cv::Size size, int type, int slotCount)
+{
+    close();
+
+    int stride = (size.width * (int) CV_ELEM_SIZE(type) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    size_t slotBytes = SLOT_HEADER + (size_t) stride * size.height;
+    size_t length = DATA_OFFSET + slotBytes * slotCount;
+
+    if (size.width <= 0 || size.height <= 0 || slotCount <= 0 || slotBytes > INT32_MAX)
+    {
+        return false;
+    }
+
+    std::string object = objectName(name);
+    shm_unlink(object.c_str());
+
+    int fd = shm_open(object.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    void* data = MAP_FAILED;
+
+    if (ftruncate(fd, length) == 0)
+    {
+        data = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+
+    ::close(fd);
+
+    if (data == MAP_FAILED)
+    {
+        shm_unlink(object.c_str());
+        return false;
+    }
+
+    mHeader = new (data) ShmRingHeader();
+    mHeader->version = VERSION;
+    mHeader->width = size.width;
+    mHeader->height = size.height;
+    mHeader->type = type;
+    mHeader->stride = stride;
+    mHeader->slotCount = slotCount;
+    mHeader->slotBytes = (int32_t) slotBytes;
+    mHeader->dataOffset = DATA_OFFSET;
+    mHeader->ready.store(0);
+    mHeader->finished.store(0);
+    mHeader->head.store(0);
+    mHeader->tail.store(0);
+
+    // Znacka az po vyplneni hlavicky, ctouci strana jinak buffer odmitne
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(mHeader->magic, MAGIC, sizeof(MAGIC));
+
+    mName = object;
+    mLength = length;
+    mOwner = true;
+    mPosition = 0;
+    mCachedLimit = 0;
+
+    return true;
+}
+
+/**
+ * Namapovani existujiciho bufferu, viz open.
+ *
+ * @param name nazev bufferu
+ * @return false - buffer neexistuje, jeste neni vytvoreny nebo ma neplatnou
+ *         hlavicku (typ, rozmery, mista mimo sdilenou pamet)
+ */
+bool ShmRing::attach(const std::string& name)
+{
+    std::string object = objectName(name);
+    int fd = shm_open(object.c_str(), O_RDWR, 0600);
+
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat info;
+    void* data = MAP_FAILED;
+
+    if (fstat(fd, &info) == 0 && info.st_size >= DATA_OFFSET)
+    {
+        data = mmap(nullptr, info.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+
+    ::close(fd);
+
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+
+    ShmRingHeader* header = (ShmRingHeader*) data;
+    bool valid = std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0;
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if (!valid || header->version != VERSION || header->slotCount <= 0 || header->dataOffset < DATA_OFFSET
+        || header->width <= 0 || header->height <= 0 || !isSupportedType(header->type)
+        || header->stride < (int64_t) header->width * CV_ELEM_SIZE(header->type)
+        || SLOT_HEADER + (int64_t) header->stride * header->height > header->slotBytes
+        || header->dataOffset + (int64_t) header->slotBytes * header->slotCount > (int64_t) info.st_size)
+    {
+        munmap(data, info.st_size);
+        return false;
+    }
+
+    mHeader = header;
+    mName = object;
+    mLength = info.st_size;
+    mOwner = false;
+    mPosition = header->tail.load(std::memory_order_acquire);
+    mCachedLimit = mPosition;
+
+    return true;
+}
+
+/**
+ * Odpojeni od bufferu, zapisujici strana buffer odstrani (pripojena
+ * ctouci strana ho muze docist).
+ */
+void ShmRing::close()
+{
+    if (mHeader == nullptr)
+    {
+        return;
+    }
+
+    munmap(mHeader, mLength);
+
+    if (mOwner)
+    {
+        shm_unlink(mName.c_str());
+    }
+
+    mHeader = nullptr;
+    mLength = 0;
+    mOwner = false;
+}
+
+#else
+
+bool ShmRing::create(const std::string&, cv::Size, int, int)
+{
+    return false;
+}
+
+bool ShmRing::attach(const std::string&)
+{
+    return false;
+}
+
+void ShmRing::close()
+{
+    mHeader = nullptr;
+}
+
+#endif
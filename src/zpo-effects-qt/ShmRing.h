@@ -0,0 +1,88 @@
+/*
+ * Soubor: ShmRing.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef SHMRING_H
+#define	SHMRING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <opencv2/core/core.hpp> // cv::Mat
+
+struct ShmRingHeader;
+
+/**
+ * Kruhovy buffer snimku ve sdilene pameti POSIX (shm_open) pro predavani
+ * snimku mezi procesy bez kopie do socketu nebo souboru. Jeden zapisujici
+ * a jeden ctouci proces (SPSC) bez zamku: zapisujici posouva citac head,
+ * ctouci citac tail (atomicke 64bitove citace v oddelenych radcich cache),
+ * mista pro snimky maji pevnou velikost (sirka, vyska a typ z hlavicky)
+ * a radky zarovnane na 64 B. Kazde misto nese poradove cislo snimku
+ * a cas zapisu (cv::getTickCount, monotonni hodiny spolecne procesum),
+ * ze ktereho ctouci strana meri latenci.
+ *
+ * Buffer vytvari zapisujici strana (zna velikost snimku) a pri close() ho
+ * odstrani; ctouci strana se pripoji funkci open() (muze pockat, nez
+ * zapisujici strana buffer vytvori) a funkci markReady oznami, ze snimky
+ * odebira (zapisujici strana na to muze pockat, waitReady, aby snimky
+ * necekaly v bufferu a nezkreslily latenci). Snimky se zapisuji
+ * a ctou primo v pameti bufferu (beginWrite/commitWrite,
+ * beginRead/endRead), funkce wait* cekaji na volne misto nebo snimek.
+ */
+class ShmRing
+{
+    private:
+
+        std::string mName;
+        ShmRingHeader* mHeader;
+        size_t mLength;
+        bool mOwner;
+        uint64_t mPosition;       // dalsi zapisovany/cteny snimek
+        uint64_t mCachedLimit;    // posledni prectena pozice protistrany
+
+    public:
+
+        ShmRing();
+        ~ShmRing();
+
+        ShmRing(const ShmRing&) = delete;
+        ShmRing& operator=(const ShmRing&) = delete;
+
+        bool create(const std::string& name, cv::Size size, int type, int slotCount);
+        bool open(const std::string& name, int timeoutMs = 0);
+        void close();
+        bool isOpen() const;
+
+        cv::Mat beginWrite();
+        void commitWrite(long long timestamp);
+        bool waitWritable(int timeoutMs);
+        bool waitReady(int timeoutMs);
+        void finish();
+
+        cv::Mat beginRead(uint64_t* sequence = nullptr, long long* timestamp = nullptr);
+        void endRead();
+        void markReady();
+        bool waitReadable(int timeoutMs);
+        int skipToLatest();
+        bool isFinished();
+
+        cv::Size size() const;
+        int type() const;
+        int slotCount() const;
+
+    private:
+
+        bool attach(const std::string& name);
+        uchar* slot(uint64_t position) const;
+        bool readable();
+        bool writable();
+};
+
+#endif	/* SHMRING_H */
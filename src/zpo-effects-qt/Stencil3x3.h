@@ -0,0 +1,257 @@
+/*
+ * Soubor: Stencil3x3.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef STENCIL3X3_H
+#define	STENCIL3X3_H
+
+// Soubor nic nevklada, protoze se vklada i do KernelsImpl.hpp za
+// #pragma GCC target (sablony se pak prelozi pro danou instrukcni sadu).
+
+/**
+ * Filtrace 8bitoveho obrazu celociselnou maskou 3x3, jejiz koeficienty jsou
+ * parametry sablony. Nulove koeficienty se vubec nectou, nasobeni +-1 a +-2
+ * se prelozi na scitani/posun a sirka akumulatoru (16 nebo 32 bitu) se
+ * urci z koeficientu pri prekladu.
+ */
+namespace Stencil3x3
+{
+
+enum Border
+{
+    REFLECT_101, // gfedcb|abcdefgh|gfedcba (vychozi okraj cv::filter2D)
+    WRAP         // cdefgh|abcdefgh|abcdefg
+};
+
+/**
+ * Index radku/sloupce mimo obraz prevedeny dovnitr obrazu. Pro masku 5x5
+ * muze index lezet az dva radky za okrajem, u obrazu vysky 2 se proto
+ * REFLECT_101 odrazi opakovane (jako cv::borderInterpolate).
+ *
+ * @param i index (-2 az n + 1)
+ * @param n pocet radku/sloupcu
+ * @param border typ okraje
+ * @return index v rozsahu 0 az n - 1
+ */
+inline int borderIndex(int i, int n, Border border)
+{
+    if (i >= 0 && i < n)
+    {
+        return i;
+    }
+
+    if (border == WRAP)
+    {
+        return (i + n) % n;
+    }
+
+    if (n == 1)
+    {
+        return 0;
+    }
+
+    while (i < 0 || i >= n)
+    {
+        i = i < 0 ? -i : 2 * n - 2 - i;
+    }
+
+    return i;
+}
+
+template <bool Condition, typename A, typename B>
+struct Select
+{
+    typedef A Type;
+};
+
+template <typename A, typename B>
+struct Select<false, A, B>
+{
+    typedef B Type;
+};
+
+/**
+ * Prispevek jednoho koeficientu masky.
+ */
+template <int K>
+struct Tap
+{
+    static const int ABS = K < 0 ? -K : K;
+
+    template <typename T>
+    static T at(const unsigned char* p, int i)
+    {
+        return (T) (p[i] * K);
+    }
+};
+
+template <>
+struct Tap<0>
+{
+    static const int ABS = 0;
+
+    template <typename T>
+    static T at(const unsigned char*, int)
+    {
+        return 0;
+    }
+};
+
+template <>
+struct Tap<1>
+{
+    static const int ABS = 1;
+
+    template <typename T>
+    static T at(const unsigned char* p, int i)
+    {
+        return p[i];
+    }
+};
+
+template <>
+struct Tap<-1>
+{
+    static const int ABS = 1;
+
+    template <typename T>
+    static T at(const unsigned char* p, int i)
+    {
+        return (T) -p[i];
+    }
+};
+
+template <>
+struct Tap<2>
+{
+    static const int ABS = 2;
+
+    template <typename T>
+    static T at(const unsigned char* p, int i)
+    {
+        return (T) (p[i] << 1);
+    }
+};
+
+template <>
+struct Tap<-2>
+{
+    static const int ABS = 2;
+
+    template <typename T>
+    static T at(const unsigned char* p, int i)
+    {
+        return (T) -(p[i] << 1);
+    }
+};
+
+/**
+ * Maska aplikovana jako korelace (stejne jako cv::filter2D):
+ *
+ *      K00, K01, K02      radek nad
+ *      K10, K11, K12      aktualni radek
+ *      K20, K21, K22      radek pod
+ */
+template <int K00, int K01, int K02,
+          int K10, int K11, int K12,
+          int K20, int K21, int K22>
+struct Correlation
+{
+    // Nejvetsi absolutni hodnota vysledku pro vstup 0 az 255
+    static const int RANGE = 255 * (Tap<K00>::ABS + Tap<K01>::ABS + Tap<K02>::ABS
+                                    + Tap<K10>::ABS + Tap<K11>::ABS + Tap<K12>::ABS
+                                    + Tap<K20>::ABS + Tap<K21>::ABS + Tap<K22>::ABS);
+
+    template <typename T>
+    static T apply(const unsigned char* above, const unsigned char* row,
+                   const unsigned char* below, int left, int x, int right)
+    {
+        return (T) (Tap<K00>::template at<T>(above, left)
+                    + Tap<K01>::template at<T>(above, x)
+                    + Tap<K02>::template at<T>(above, right)
+                    + Tap<K10>::template at<T>(row, left)
+                    + Tap<K11>::template at<T>(row, x)
+                    + Tap<K12>::template at<T>(row, right)
+                    + Tap<K20>::template at<T>(below, left)
+                    + Tap<K21>::template at<T>(below, x)
+                    + Tap<K22>::template at<T>(below, right));
+    }
+};
+
+/**
+ * Maska aplikovana jako konvoluce (otocena o 180 stupnu), odpovida
+ * puvodnimu cv::flip + cv::filter2D.
+ */
+template <int K00, int K01, int K02,
+          int K10, int K11, int K12,
+          int K20, int K21, int K22>
+using Convolution = Correlation<K22, K21, K20,
+                                K12, K11, K10,
+                                K02, K01, K00>;
+
+/**
+ * Vystup do 8bitoveho obrazu: pricteni Bias a saturace na 0 az 255.
+ */
+template <int Bias>
+struct Saturate
+{
+    typedef unsigned char Type;
+
+    static const int RANGE = Bias < 0 ? -Bias : Bias;
+
+    template <typename T>
+    static unsigned char store(T value)
+    {
+        int v = value + Bias;
+        v = v < 0 ? 0 : v;
+
+        return (unsigned char) (v > 255 ? 255 : v);
+    }
+};
+
+/**
+ * Filtrace jednoho radku. Okrajove radky (above, below) vybira volajici,
+ * okrajove sloupce se dopocitaji podle Border.
+ *
+ * @param above radek nad
+ * @param row filtrovany radek
+ * @param below radek pod
+ * @param dst vystupni radek
+ * @param width sirka v pixelech (kazdy ma Channels kanalu)
+ */
+template <typename Mask, typename Output, int Channels, Border B>
+void apply(const unsigned char* __restrict above, const unsigned char* __restrict row,
+           const unsigned char* __restrict below, typename Output::Type* __restrict dst,
+           int width)
+{
+    typedef typename Select<Mask::RANGE + Output::RANGE <= 32767, short, int>::Type Accumulator;
+
+    // Vnitrni pixely po prvcich, soused ve stejnem kanalu je o Channels vedle
+    for (int i = Channels; i < Channels * (width - 1); i++)
+    {
+        dst[i] = Output::store(Mask::template apply<Accumulator>(
+                     above, row, below, i - Channels, i, i + Channels));
+    }
+
+    // Okrajove sloupce (pri sirce 1 a 2 vsechny)
+    for (int x = 0; x < width; x = (x == 0 && width > 2) ? width - 1 : x + 1)
+    {
+        int left = Channels * borderIndex(x - 1, width, B);
+        int right = Channels * borderIndex(x + 1, width, B);
+
+        for (int c = 0; c < Channels; c++)
+        {
+            dst[Channels * x + c] = Output::store(Mask::template apply<Accumulator>(
+                                        above, row, below, left + c, Channels * x + c, right + c));
+        }
+    }
+}
+
+} // namespace Stencil3x3
+
+#endif	/* STENCIL3X3_H */
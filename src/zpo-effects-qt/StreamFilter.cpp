@@ -0,0 +1,419 @@
+/*
+ * Soubor: StreamFilter.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "StreamFilter.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "IncrementalGlass.h"
+#include "KernelDispatch.h"
+#include "TaskScheduler.h"
+
+// Vychozi vyska pruhu (radky obrazku)
+static const int DEFAULT_STRIP_ROWS = 512;
+
+static const int REGION_SIZE = IncrementalGlass::REGION_SIZE;
+static const int SEARCH_CELLS = IncrementalGlass::SEARCH_CELLS;
+static const int MAX_CANDIDATES = (2 * SEARCH_CELLS + 1) * (2 * SEARCH_CELLS + 1);
+
+/**
+ * Posun okna radku obrazku na radky [newTop, newBottom): radky, ktere
+ * v okne zustavaji, se presunou na zacatek, zbytek se docte ze souboru.
+ * Okno se posouva jen dolu.
+ *
+ * @param reader vstupni soubor
+ * @param window buffer okna (aspon newBottom - newTop radku)
+ * @param top prvni radek obrazku v okne (vstup i vystup)
+ * @param bottom radek za poslednim radkem v okne (vstup i vystup)
+ * @param newTop novy prvni radek
+ * @param newBottom novy radek za poslednim
+ * @return false - chyba cteni
+ */
+static bool advanceWindow(PnmReader& reader, cv::Mat& window, int* top, int* bottom,
+                          int newTop, int newBottom)
+{
+    int keep = std::max(std::min(*bottom, newBottom) - newTop, 0);
+    int shift = newTop - *top;
+
+    if (shift > 0)
+    {
+        for (int j = 0; j < keep; j++)
+        {
+            cv::Mat row = window.row(j);
+            window.row(shift + j).copyTo(row);
+        }
+    }
+
+    // Radky mezi starym a novym oknem se prectou a zahodi
+    if (newTop > *bottom)
+    {
+        cv::Mat skipped = window.rowRange(0, 1);
+        for (int j = *bottom; j < newTop; j++)
+        {
+            if (!reader.read(skipped))
+            {
+                return false;
+            }
+        }
+    }
+
+    if (newBottom > newTop + keep)
+    {
+        cv::Mat fresh = window.rowRange(keep, newBottom - newTop);
+        if (!reader.read(fresh))
+        {
+            return false;
+        }
+    }
+
+    *top = newTop;
+    *bottom = newBottom;
+
+    return true;
+}
+
+/**
+ * Test, zda lze filtr pouzit po pruzich.
+ *
+ * @param filterType typ filtru
+ * @return true - filtr s maskami nebo Glass
+ */
+bool StreamFilter::isSupported(ImageFilter::Type filterType)
+{
+    return ImageFilter::stencilRadius(filterType) >= 0 || filterType == ImageFilter::Type::Glass;
+}
+
+// Vyska pruhu nastavena pro aktualni vlakno (0 - podle ZPO_STREAM_ROWS)
+static thread_local int tStripRows = 0;
+
+/**
+ * Vyska pruhu, promenna prostredi ZPO_STREAM_ROWS ji prepise
+ * (setLocalStripRows ma prednost).
+ *
+ * @return vyska pruhu (aspon 1)
+ */
+int StreamFilter::stripRows()
+{
+    if (tStripRows > 0)
+    {
+        return tStripRows;
+    }
+
+    static const char* forced = getenv("ZPO_STREAM_ROWS");
+
+    if (forced != nullptr && *forced != '\0')
+    {
+        return std::max(atoi(forced), 1);
+    }
+
+    return DEFAULT_STRIP_ROWS;
+}
+
+/**
+ * Nastaveni vysky pruhu pro filtraci z aktualniho vlakna (prednost pred
+ * ZPO_STREAM_ROWS), napr. pro kontrolu malych pruhu (FilterCheck).
+ *
+ * @param rows vyska pruhu (0 - podle ZPO_STREAM_ROWS)
+ * @return predchozi nastaveni (pro obnoveni)
+ */
+int StreamFilter::setLocalStripRows(int rows)
+{
+    int previous = tStripRows;
+    tStripRows = std::max(rows, 0);
+
+    return previous;
+}
+
+/**
+ * Filtrace binarniho PNM souboru po pruzich do PNM souboru (P6, u filtru
+ * se sedotonovym vystupem P5).
+ *
+ * @param input vstupni soubor
+ * @param output vystupni soubor
+ * @param filterType typ filtru (isSupported)
+ * @return false - chyba (vypsana na std::cerr)
+ */
+bool StreamFilter::filter(const std::string& input, const std::string& output,
+                          ImageFilter::Type filterType)
+{
+    if (!isSupported(filterType))
+    {
+        std::cerr << "Filter " << ImageFilter::typeName(filterType)
+                  << " depends on the whole image and cannot be streamed" << std::endl;
+        return false;
+    }
+
+    PnmReader reader;
+    if (!reader.open(input))
+    {
+        std::cerr << "Could not stream image: " << input << " (binary 8-bit PGM/PPM expected)" << std::endl;
+        return false;
+    }
+
+    int channels = CV_MAT_CN(ImageFilter::outputType(filterType, CV_8UC3));
+
+    PnmWriter writer;
+    if (!writer.open(output, reader.size(), channels))
+    {
+        std::cerr << "Could not write image: " << output << std::endl;
+        return false;
+    }
+
+    bool ok = filterType == ImageFilter::Type::Glass
+              ? filterGlass(reader, writer)
+              : filterStencil(reader, writer, filterType);
+
+    if (!writer.close() || !ok)
+    {
+        std::cerr << "Could not stream image: " << input << " -> " << output << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Filtrace filtrem s maskami: kazdy pruh se filtruje s polomerem masek
+ * radku nad a pod pruhem, okraj obrazku zustava okrajem okna.
+ *
+ * @param reader vstupni soubor
+ * @param writer vystupni soubor
+ * @param filterType typ filtru
+ * @return false - chyba cteni nebo zapisu
+ */
+bool StreamFilter::filterStencil(PnmReader& reader, PnmWriter& writer, ImageFilter::Type filterType)
+{
+    int radius = ImageFilter::stencilRadius(filterType);
+    int strip = stripRows();
+    cv::Size size = reader.size();
+
+    cv::Mat window(strip + 2 * radius, size.width, CV_8UC3);
+    cv::Mat filtered;
+    int top = 0;
+    int bottom = 0;
+
+    for (int y = 0; y < size.height; y += strip)
+    {
+        int rows = std::min(strip, size.height - y);
+
+        if (!advanceWindow(reader, window, &top, &bottom,
+                           std::max(y - radius, 0), std::min(y + rows + radius, size.height)))
+        {
+            return false;
+        }
+
+        ImageFilter::filter(window.rowRange(0, bottom - top), filtered, filterType);
+
+        if (!writer.write(filtered.rowRange(y - top, y - top + rows)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Filtrace Glass po pruzich zarovnanych na radky bunek. Pro pruh radku
+ * bloku [b0, b1) se spocitaji seminka bunek [b0 - 3S, b1 + 3S), prirazeni
+ * pixelu blokum [b0 - 2S, b1 + 2S) a soucty barev; regiony seminek
+ * [b0 - S, b1 + S) (vsechny regiony pixelu pruhu) jsou pak uplne
+ * (S = SEARCH_CELLS). Kandidati bloku a poradi pri shode vzdalenosti jsou
+ * stejne jako v IncrementalGlass.
+ *
+ * @param reader vstupni soubor
+ * @param writer vystupni soubor
+ * @return false - chyba cteni nebo zapisu
+ */
+bool StreamFilter::filterGlass(PnmReader& reader, PnmWriter& writer)
+{
+    cv::Size size = reader.size();
+
+    int cellCols = size.width > REGION_SIZE ? (size.width - REGION_SIZE - 1) / REGION_SIZE + 1 : 0;
+    int cellRows = size.height > REGION_SIZE ? (size.height - REGION_SIZE - 1) / REGION_SIZE + 1 : 0;
+    int blockCols = (size.width + REGION_SIZE - 1) / REGION_SIZE;
+    int blockRows = (size.height + REGION_SIZE - 1) / REGION_SIZE;
+
+    if (cellCols * cellRows == 0)
+    {
+        // Obrazek mensi nez bunka nema zadny region
+        return filterStencil(reader, writer, ImageFilter::Type::NoFilter);
+    }
+
+    int stripBlocks = std::max(stripRows() / REGION_SIZE, 1);
+    int maxSeedRows = stripBlocks + 6 * SEARCH_CELLS;
+
+    cv::Mat window(maxSeedRows * REGION_SIZE, size.width, CV_8UC3);
+    cv::Mat labels((stripBlocks + 4 * SEARCH_CELLS) * REGION_SIZE, size.width, CV_32SC1);
+    cv::Mat out(stripBlocks * REGION_SIZE, size.width, CV_8UC3);
+    std::vector<int> seedX(cellCols * maxSeedRows);
+    std::vector<int> seedY(cellCols * maxSeedRows);
+    std::vector<int> sums(4 * cellCols * maxSeedRows);
+    std::vector<int> colors(3 * cellCols * maxSeedRows);
+    int top = 0;
+    int bottom = 0;
+
+    TaskScheduler& scheduler = TaskScheduler::instance();
+    const KernelDispatch::Kernels& kernels = KernelDispatch::active();
+
+    for (int b0 = 0; b0 < blockRows; b0 += stripBlocks)
+    {
+        int b1 = std::min(b0 + stripBlocks, blockRows);
+
+        // Radky bunek se seminky a radky bloku s prirazenim pixelu
+        int s0 = std::max(b0 - 3 * SEARCH_CELLS, 0);
+        int s1 = std::min(b1 + 3 * SEARCH_CELLS, cellRows);
+        int l0 = std::max(b0 - 2 * SEARCH_CELLS, 0);
+        int l1 = std::min(b1 + 2 * SEARCH_CELLS, blockRows);
+        int seedRows = s1 - s0;
+        int seedCount = cellCols * seedRows;
+
+        if (!advanceWindow(reader, window, &top, &bottom, s0 * REGION_SIZE,
+                           std::min(std::max(s1, l1) * REGION_SIZE, size.height)))
+        {
+            return false;
+        }
+
+        // Seminka (index cx * seedRows + cy - s0 zachovava poradi indexu glass)
+        scheduler.parallelFor(0, cellCols, 1, [&](int begin, int end) {
+            for (int cx = begin; cx < end; cx++)
+            {
+                for (int cy = s0; cy < s1; cy++)
+                {
+                    int sum = 0;
+
+                    for (int l = cy * REGION_SIZE; l < (cy + 1) * REGION_SIZE; l++)
+                    {
+                        const uchar* row = window.ptr(l - top) + 3 * cx * REGION_SIZE;
+
+                        for (int k = 0; k < 3 * REGION_SIZE; k++)
+                        {
+                            sum += row[k];
+                        }
+                    }
+
+                    int index = cx * seedRows + cy - s0;
+                    IncrementalGlass::seedOffset(sum / 3, &seedX[index], &seedY[index]);
+                    seedX[index] += cx * REGION_SIZE;
+                    seedY[index] += cy * REGION_SIZE;
+                }
+            }
+        });
+
+        // Prirazeni pixelu nejblizsimu seminku z kandidatu bloku
+        scheduler.parallelFor(l0, l1, 1, [&](int begin, int end) {
+            int candidates[MAX_CANDIDATES];
+            int candidateX[MAX_CANDIDATES];
+            int candidateY[MAX_CANDIDATES];
+            int nearest[REGION_SIZE];
+            int distances[REGION_SIZE];
+
+            for (int by = begin; by < end; by++)
+            {
+                int y0 = by * REGION_SIZE;
+                int y1 = std::min(y0 + REGION_SIZE, size.height);
+
+                for (int bx = 0; bx < blockCols; bx++)
+                {
+                    int x0 = bx * REGION_SIZE;
+                    int width = std::min(REGION_SIZE, size.width - x0);
+                    int count = 0;
+
+                    for (int cx = std::max(bx - SEARCH_CELLS, 0); cx <= std::min(bx + SEARCH_CELLS, cellCols - 1); cx++)
+                    {
+                        for (int cy = std::max(by - SEARCH_CELLS, 0); cy <= std::min(by + SEARCH_CELLS, cellRows - 1); cy++)
+                        {
+                            if (IncrementalGlass::isCandidate(bx, by, cx, cy, cellCols, cellRows))
+                            {
+                                int index = cx * seedRows + cy - s0;
+                                candidates[count] = index;
+                                candidateX[count] = seedX[index] - x0;
+                                candidateY[count] = seedY[index];
+                                count++;
+                            }
+                        }
+                    }
+
+                    for (int j = y0; j < y1; j++)
+                    {
+                        kernels.nearestSeed(candidateX, candidateY, count, j, nearest, distances, width);
+
+                        int* labelRow = labels.ptr<int>(j - l0 * REGION_SIZE) + x0;
+                        for (int i = 0; i < width; i++)
+                        {
+                            labelRow[i] = candidates[nearest[i]];
+                        }
+                    }
+                }
+            }
+        });
+
+        // Soucty barev regionu, kazdy kanal a pocty pixelu jako samostatna uloha
+        std::fill(sums.begin(), sums.begin() + 4 * seedCount, 0);
+        int labelRows = std::min(l1 * REGION_SIZE, size.height) - l0 * REGION_SIZE;
+
+        scheduler.parallelFor(0, 4, 1, [&](int begin, int end) {
+            for (int c = begin; c < end; c++)
+            {
+                int* channelSums = &sums[c * seedCount];
+
+                for (int j = 0; j < labelRows; j++)
+                {
+                    const cv::Vec3b* srcRow = window.ptr<cv::Vec3b>(j + l0 * REGION_SIZE - top);
+                    const int* labelRow = labels.ptr<int>(j);
+
+                    for (int i = 0; i < size.width; i++)
+                    {
+                        channelSums[labelRow[i]] += c < 3 ? srcRow[i].val[c] : 1;
+                    }
+                }
+            }
+        });
+
+        const int* counts = &sums[3 * seedCount];
+        for (int s = 0; s < seedCount; s++)
+        {
+            for (int c = 0; c < 3; c++)
+            {
+                colors[3 * s + c] = counts[s] > 0 ? std::min(sums[c * seedCount + s] / counts[s], 255) : 0;
+            }
+        }
+
+        // Vystup pruhu
+        int y0 = b0 * REGION_SIZE;
+        int rows = std::min(b1 * REGION_SIZE, size.height) - y0;
+
+        scheduler.parallelFor(0, rows, REGION_SIZE, [&](int begin, int end) {
+            for (int j = begin; j < end; j++)
+            {
+                const int* labelRow = labels.ptr<int>(j + y0 - l0 * REGION_SIZE);
+                cv::Vec3b* outRow = out.ptr<cv::Vec3b>(j);
+
+                for (int i = 0; i < size.width; i++)
+                {
+                    const int* color = &colors[3 * labelRow[i]];
+
+                    outRow[i].val[0] = (uchar) color[0];
+                    outRow[i].val[1] = (uchar) color[1];
+                    outRow[i].val[2] = (uchar) color[2];
+                }
+            }
+        });
+
+        if (!writer.write(out.rowRange(0, rows)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
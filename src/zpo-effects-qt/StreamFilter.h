@@ -0,0 +1,51 @@
+/*
+ * Soubor: StreamFilter.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef STREAMFILTER_H
+#define	STREAMFILTER_H
+
+#include <string>
+
+#include "ImageFilter.h"
+#include "PnmStream.h"
+
+/**
+ * Filtrace obrazku vetsich nez pamet (PNM) po pruzich radku: vstup se cte
+ * po pruzich, vystup se po pruzich zapisuje, v pameti je jen okno pruhu
+ * s prekryvem. Pamet tak zavisi na sirce obrazku a vysce pruhu
+ * (ZPO_STREAM_ROWS, vychozi 512, pro vlakno setLocalStripRows), ne na
+ * vysce obrazku.
+ *
+ * Filtry s maskami (ImageFilter::stencilRadius) filtruji pruh s prekryvem
+ * polomeru masek, vysledek je shodny s filtraci celeho obrazku. Glass ma
+ * pruhy zarovnane na radky bunek; nejblizsi seminko pixelu lezi nejvyse
+ * SEARCH_CELLS bunek od jeho bloku (IncrementalGlass.h), region seminka
+ * tedy take. Pruh proto pocita seminka 3 x SEARCH_CELLS, prirazeni pixelu
+ * 2 x SEARCH_CELLS radku bunek nad a pod pruhem, soucty barev regionu
+ * zasahujicich do pruhu jsou pak uplne a vysledek je shodny s filtraci
+ * celeho obrazku. Ostatni filtry zavisi na celem obrazu a po pruzich
+ * filtrovat nelze.
+ */
+class StreamFilter
+{
+    public:
+
+        static bool isSupported(ImageFilter::Type filterType);
+        static bool filter(const std::string& input, const std::string& output,
+                           ImageFilter::Type filterType);
+        static int stripRows();
+        static int setLocalStripRows(int rows);
+
+    private:
+
+        static bool filterStencil(PnmReader& reader, PnmWriter& writer, ImageFilter::Type filterType);
+        static bool filterGlass(PnmReader& reader, PnmWriter& writer);
+};
+
+#endif	/* STREAMFILTER_H */
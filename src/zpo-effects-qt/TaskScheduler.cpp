@@ -0,0 +1,635 @@
+/*
+ * Soubor: TaskScheduler.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "TaskScheduler.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#ifdef __linux__
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+// Fronta aktualniho vlakna (-1 - vlakno mimo planovac zatim bez fronty)
+static thread_local int tQueue = -1;
+
+/**
+ * Vlastni fronta vlakna mimo planovac, pri ukonceni vlakna se uvolni.
+ */
+struct ExternalQueue
+{
+    std::atomic<bool>* used = nullptr; // priznak obsazeni fronty v planovaci
+
+    ~ExternalQueue()
+    {
+        // Fronta je prazdna, vlakno dokoncilo vsechny sve skupiny uloh
+        if (used != nullptr)
+        {
+            *used = false;
+        }
+    }
+};
+
+static thread_local ExternalQueue tExternalQueue;
+
+// Nejvyssi pocet casti parallelFor volaneho z aktualniho vlakna (0 - bez omezeni)
+static thread_local int tConcurrency = 0;
+
+// Priznak zruseni vypoctu aktualniho vlakna (nullptr - nelze zrusit)
+static thread_local const std::atomic<bool>* tCancel = nullptr;
+
+/**
+ * Nastaveni priznaku zruseni pro vlakno, ktere vykonava cast parallelFor
+ * (vnorene parallelFor tak lze zrusit stejnym priznakem). Puvodni hodnota
+ * se obnovi i pri vyjimce.
+ */
+struct CancelScope
+{
+    const std::atomic<bool>* previous;
+
+    explicit CancelScope(const std::atomic<bool>* cancel)
+        : previous(TaskScheduler::setLocalCancel(cancel))
+    {
+    }
+
+    ~CancelScope()
+    {
+        TaskScheduler::setLocalCancel(previous);
+    }
+};
+
+/**
+ * Pocet vlaken planovace: ZPO_THREADS, jinak pocet jader.
+ *
+ * @return pocet vlaken vcetne volajiciho
+ */
+static int configuredThreadCount()
+{
+    const char* forced = getenv("ZPO_THREADS");
+
+    if (forced != nullptr && *forced != '\0')
+    {
+        return std::max(atoi(forced), 1);
+    }
+
+    return std::max((int) std::thread::hardware_concurrency(), 1);
+}
+
+/**
+ * Spolecny planovac. Pracovni vlakna se spusti pri prvnim pouziti.
+ *
+ * @return planovac
+ */
+TaskScheduler& TaskScheduler::instance()
+{
+    static TaskScheduler scheduler(configuredThreadCount());
+
+    return scheduler;
+}
+
+/**
+ * Vytvoreni planovace. Vlakno, ktere ceka na ulohy, se na praci podili,
+ * proto se spousti o jedno pracovni vlakno mene.
+ *
+ * @param threadCount pocet vlaken vcetne volajiciho
+ */
+TaskScheduler::TaskScheduler(int threadCount) : mThreadCount(threadCount), mQueued(0), mStop(false)
+{
+    for (int i = 0; i < threadCount + EXTERNAL_QUEUES; i++)
+    {
+        mQueues.push_back(new Queue);
+    }
+
+    for (std::atomic<bool>& used : mExternalUsed)
+    {
+        used = false;
+    }
+
+    for (int i = 1; i < threadCount; i++)
+    {
+        mThreads.push_back(std::thread(&TaskScheduler::workerLoop, this, i));
+    }
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mStop = true;
+    }
+    mWake.notify_all();
+
+    for (std::thread& thread : mThreads)
+    {
+        thread.join();
+    }
+
+    for (Queue* queue : mQueues)
+    {
+        delete queue;
+    }
+}
+
+/**
+ * Pocet vlaken, ktera zpracovavaji ulohy (vcetne cekajiciho).
+ *
+ * @return pocet vlaken
+ */
+int TaskScheduler::threadCount() const
+{
+    return mThreadCount;
+}
+
+/**
+ * Systemova ID pracovnich vlaken (Linux, napr. pro citace vykonu vsech
+ * vlaken, PerfCounters). Ceka, az se vsechna pracovni vlakna spusti.
+ *
+ * @return ID vlaken, prazdny seznam na jinych systemech
+ */
+std::vector<int> TaskScheduler::workerThreadIds()
+{
+#ifdef __linux__
+    std::unique_lock<std::mutex> lock(mSleepMutex);
+    mStarted.wait(lock, [this] { return mThreadIds.size() == mThreads.size(); });
+
+    return mThreadIds;
+#else
+    return std::vector<int>();
+#endif
+}
+
+/**
+ * Paralelni zpracovani rozsahu. Rozsah se deli na poloviny, dokud je vetsi
+ * nez grain; druha polovina se vzdy vlozi do fronty, kde ji muze ukrast
+ * jine vlakno. Funkce se vraci az po zpracovani celeho rozsahu.
+ *
+ * Omezeni setLocalConcurrency zvetsi grain tak, aby casti nebylo vic
+ * (mocnina dvou se rozdeli presne na tolik casti). Pri nastavenem priznaku
+ * zruseni (setLocalCancel) se dosud nezahajene casti preskoci a po jejich
+ * dokonceni se vyhodi Cancelled.
+ *
+ * @param begin zacatek rozsahu
+ * @param end konec rozsahu (za poslednim prvkem)
+ * @param grain nejmensi delka casti zpracovane jednim volanim body
+ * @param body zpracovani casti rozsahu
+ */
+void TaskScheduler::parallelFor(int begin, int end, int grain, const RangeBody& body)
+{
+    const std::atomic<bool>* cancel = tCancel;
+
+    if (cancel == nullptr)
+    {
+        runRange(begin, end, grain, body);
+        return;
+    }
+
+    if (*cancel)
+    {
+        throw Cancelled();
+    }
+
+    auto guarded = [&](int first, int last) {
+        if (!*cancel)
+        {
+            CancelScope scope(cancel);
+            body(first, last);
+        }
+    };
+
+    runRange(begin, end, grain, guarded);
+
+    if (*cancel)
+    {
+        throw Cancelled();
+    }
+}
+
+/**
+ * Zpracovani rozsahu pro parallelFor (bez kontroly zruseni).
+ *
+ * @param begin zacatek rozsahu
+ * @param end konec rozsahu (za poslednim prvkem)
+ * @param grain nejmensi delka casti zpracovane jednim volanim body
+ * @param body zpracovani casti rozsahu
+ */
+void TaskScheduler::runRange(int begin, int end, int grain, const RangeBody& body)
+{
+    grain = std::max(grain, 1);
+
+    if (tConcurrency > 0 && tConcurrency < threadCount())
+    {
+        grain = std::max(grain, (end - begin + tConcurrency - 1) / tConcurrency);
+    }
+
+    if (end - begin <= grain || threadCount() == 1)
+    {
+        if (end > begin)
+        {
+            body(begin, end);
+        }
+        return;
+    }
+
+    TaskGroup group;
+
+    Task task;
+    task.body = &body;
+    task.begin = begin;
+    task.end = end;
+    task.grain = grain;
+    task.group = &group;
+    task.memory = MemoryTracker::localMeasurement();
+
+    group.mPending++;
+    execute(task);
+    group.wait();
+}
+
+/**
+ * Omezeni poctu casti parallelFor a rozpracovanych uloh TaskGroup::run
+ * volanych z aktualniho vlakna (tedy i poctu vlaken, ktera na nich
+ * pracuji). Vnorene parallelFor a skupiny v ulohach se neomezuji.
+ *
+ * @param concurrency nejvyssi pocet casti (0 - bez omezeni)
+ * @return predchozi nastaveni (pro obnoveni)
+ */
+int TaskScheduler::setLocalConcurrency(int concurrency)
+{
+    int previous = tConcurrency;
+    tConcurrency = std::max(concurrency, 0);
+
+    return previous;
+}
+
+/**
+ * Nastaveni priznaku zruseni vypoctu pro aktualni vlakno. Po nastaveni
+ * priznaku na true vyhodi dalsi parallelFor volany z vlakna (tedy
+ * i ImageFilter::filter) vyjimku Cancelled.
+ *
+ * @param cancel priznak zruseni (nullptr - vypocet nelze zrusit)
+ * @return predchozi nastaveni (pro obnoveni)
+ */
+const std::atomic<bool>* TaskScheduler::setLocalCancel(const std::atomic<bool>* cancel)
+{
+    const std::atomic<bool>* previous = tCancel;
+    tCancel = cancel;
+
+    return previous;
+}
+
+/**
+ * Popis vyjimky zruseneho vypoctu.
+ *
+ * @return popis
+ */
+const char* TaskScheduler::Cancelled::what() const noexcept
+{
+    return "Computation cancelled";
+}
+
+/**
+ * Smycka pracovniho vlakna: vlastni ulohy, kradeni, jinak spanek.
+ *
+ * @param index index fronty vlakna
+ */
+void TaskScheduler::workerLoop(int index)
+{
+    tQueue = index;
+
+#ifdef __linux__
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mThreadIds.push_back((int) syscall(SYS_gettid));
+    }
+    mStarted.notify_all();
+#endif
+
+    while (!mStop)
+    {
+        Task task;
+
+        if (pop(task, nullptr))
+        {
+            execute(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mSleepMutex);
+        mWake.wait(lock, [this] { return mStop || mQueued > 0; });
+    }
+}
+
+/**
+ * Vlozeni ulohy na konec fronty aktualniho vlakna.
+ *
+ * @param task uloha (pri uspechu presunuta do fronty)
+ * @return false - fronta je plna, ulohu je treba vykonat hned
+ */
+bool TaskScheduler::push(Task& task)
+{
+    Queue& queue = localQueue();
+
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (queue.count == Queue::CAPACITY)
+        {
+            return false;
+        }
+
+        queue.tasks[(queue.head + queue.count) % Queue::CAPACITY] = std::move(task);
+        queue.count++;
+    }
+
+    mQueued++;
+
+    if (!mThreads.empty())
+    {
+        // Zamek zajisti, ze vlakno, ktere prave usina, zmenu mQueued uvidi
+        {
+            std::lock_guard<std::mutex> lock(mSleepMutex);
+        }
+        mWake.notify_one();
+    }
+
+    return true;
+}
+
+/**
+ * Ziskani ulohy: z konce vlastni fronty, jinak ze zacatku cizi fronty.
+ * Vlakno cekajici na skupinu bere jen ulohy teto skupiny (na konci vlastni
+ * fronty jsou vzdy ulohy prave cekane skupiny, cizi fronty mohou mit ulohy
+ * skupiny i uprostred, ty vykona vlakno, ktere je tam vlozilo).
+ *
+ * @param task vystupni uloha
+ * @param group skupina, nullptr - libovolna uloha
+ * @return false - zadna vhodna uloha neni k dispozici
+ */
+bool TaskScheduler::pop(Task& task, const TaskGroup* group)
+{
+    if (mQueued == 0)
+    {
+        return false;
+    }
+
+    {
+        Queue& own = localQueue();
+        std::lock_guard<std::mutex> lock(own.mutex);
+
+        if (own.count > 0
+            && (group == nullptr || own.tasks[(own.head + own.count - 1) % Queue::CAPACITY].group == group))
+        {
+            own.count--;
+            task = std::move(own.tasks[(own.head + own.count) % Queue::CAPACITY]);
+            mQueued--;
+            return true;
+        }
+    }
+
+    int queueCount = (int) mQueues.size();
+
+    for (int i = 1; i < queueCount; i++)
+    {
+        Queue& victim = *mQueues[(tQueue + i) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+
+        if (victim.count > 0 && (group == nullptr || victim.tasks[victim.head].group == group))
+        {
+            task = std::move(victim.tasks[victim.head]);
+            victim.head = (victim.head + 1) % Queue::CAPACITY;
+            victim.count--;
+            mQueued--;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Vykonani ulohy a oznameni jejiho dokonceni skupine. Vyjimka ulohy se
+ * preda do TaskGroup::wait(). Alokace ulohy se pripisuji mereni vlakna,
+ * ktere ulohu zadalo (MemoryTracker).
+ *
+ * @param task uloha
+ */
+void TaskScheduler::execute(Task& task)
+{
+    TaskGroup* group = task.group;
+    MemoryTracker::Measurement* memory = MemoryTracker::setLocalMeasurement(task.memory);
+
+    try
+    {
+        if (task.body != nullptr)
+        {
+            split(task);
+        }
+        else
+        {
+            task.call(task.function);
+        }
+    }
+    catch (...)
+    {
+        group->fail(std::current_exception());
+    }
+
+    MemoryTracker::setLocalMeasurement(memory);
+    group->finishTask();
+}
+
+/**
+ * Zpracovani casti parallelFor: odstepovani druhych polovin do fronty
+ * a zpracovani zbyvajici prvni casti.
+ *
+ * @param task cast rozsahu
+ */
+void TaskScheduler::split(Task& task)
+{
+    while (task.end - task.begin > task.grain)
+    {
+        int middle = task.begin + (task.end - task.begin) / 2;
+
+        Task right;
+        right.body = task.body;
+        right.begin = middle;
+        right.end = task.end;
+        right.grain = task.grain;
+        right.group = task.group;
+        right.memory = task.memory;
+
+        task.group->mPending++;
+
+        if (!push(right))
+        {
+            // Plna fronta, zbytek rozsahu se zpracuje najednou
+            task.group->mPending--;
+            break;
+        }
+
+        task.group->notifyWork();
+
+        task.end = middle;
+    }
+
+    (*task.body)(task.begin, task.end);
+}
+
+/**
+ * Fronta aktualniho vlakna.
+ *
+ * @return fronta
+ */
+TaskScheduler::Queue& TaskScheduler::localQueue()
+{
+    if (tQueue < 0)
+    {
+        tQueue = claimExternalQueue();
+    }
+
+    return *mQueues[tQueue];
+}
+
+/**
+ * Prideleni vlastni fronty vlaknu mimo planovac.
+ *
+ * @return index fronty, 0 - vsechny vlastni fronty jsou obsazene
+ */
+int TaskScheduler::claimExternalQueue()
+{
+    for (int i = 0; i < EXTERNAL_QUEUES; i++)
+    {
+        if (!mExternalUsed[i].exchange(true))
+        {
+            tExternalQueue.used = &mExternalUsed[i];
+            return mThreadCount + i;
+        }
+    }
+
+    return 0;
+}
+
+TaskGroup::TaskGroup() : mScheduler(TaskScheduler::instance()), mPending(0), mWork(false)
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+    // Ulohy odkazuji na skupinu, skupina proto nesmi zaniknout driv nez ony
+    help();
+}
+
+/**
+ * Vlozeni ulohy TaskGroup::run do fronty. Omezeni setLocalConcurrency
+ * volajiciho vlakna plati i zde: rozpracovanych uloh skupiny je nejvyse
+ * o jednu mene nez omezeni (jednu cast prace ma volajici vlakno), dalsi
+ * ulohy se vykonaji hned ve volajicim vlakne, pri omezeni 1 tedy vsechny.
+ *
+ * @param task uloha
+ */
+void TaskGroup::submit(TaskScheduler::Task& task)
+{
+    task.memory = MemoryTracker::localMeasurement();
+
+    int pending = mPending++;
+    bool limited = tConcurrency > 0 && pending >= tConcurrency - 1;
+
+    if (mScheduler.threadCount() == 1 || limited || !mScheduler.push(task))
+    {
+        mScheduler.execute(task);
+    }
+}
+
+/**
+ * Cekani na dokonceni vsech uloh skupiny. Cekajici vlakno mezitim
+ * vykonava ulohy z front. Prvni vyjimka vyhozena ulohou se zde znovu vyhodi.
+ */
+void TaskGroup::wait()
+{
+    help();
+
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(mErrorMutex);
+        std::swap(error, mError);
+    }
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+/**
+ * Vykonavani uloh skupiny z front, dokud nejsou dokonceny vsechny. Na ulohy
+ * skupiny, ktere prave bezi v jinych vlaknech, se ceka ve spanku; vzbudi
+ * dokonceni posledni ulohy nebo odstepeni dalsi casti parallelFor.
+ */
+void TaskGroup::help()
+{
+    while (mPending > 0)
+    {
+        TaskScheduler::Task task;
+
+        if (mScheduler.pop(task, this))
+        {
+            mScheduler.execute(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mWaitMutex);
+        mWake.wait(lock, [this] { return mPending == 0 || mWork; });
+        mWork = false;
+    }
+
+    // Vlakno, ktere dokoncilo posledni ulohu, muze zamek jeste drzet
+    std::lock_guard<std::mutex> lock(mWaitMutex);
+}
+
+/**
+ * Oznameni dokonceni ulohy skupiny. Snizeni pod zamkem zajisti, ze skupina
+ * nezanikne driv, nez ji oznamujici vlakno prestane pouzivat.
+ */
+void TaskGroup::finishTask()
+{
+    std::lock_guard<std::mutex> lock(mWaitMutex);
+
+    if (--mPending == 0)
+    {
+        mWake.notify_all();
+    }
+}
+
+/**
+ * Vzbuzeni cekajiciho vlakna, ve frontach je dalsi uloha skupiny.
+ */
+void TaskGroup::notifyWork()
+{
+    {
+        std::lock_guard<std::mutex> lock(mWaitMutex);
+        mWork = true;
+    }
+    mWake.notify_all();
+}
+
+/**
+ * Ulozeni vyjimky ulohy (zustava jen prvni).
+ *
+ * @param error vyjimka
+ */
+void TaskGroup::fail(std::exception_ptr error)
+{
+    std::lock_guard<std::mutex> lock(mErrorMutex);
+
+    if (!mError)
+    {
+        mError = error;
+    }
+}
@@ -0,0 +1,261 @@
+/*
+ * Soubor: TaskScheduler.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef TASKSCHEDULER_H
+#define	TASKSCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "MemoryTracker.h"
+
+class TaskGroup;
+
+/**
+ * Planovac uloh s kradenim prace (work stealing). Kazde pracovni vlakno ma
+ * vlastni frontu: ulohy vklada a bere z konce (naposledy vlozena uloha ma
+ * data v cache), ostatni vlakna kradou ze zacatku (nejvetsi kusy prace).
+ *
+ * Vlakno, ktere ceka na dokonceni skupiny uloh (TaskGroup::wait), mezitim
+ * samo vykonava ulohy teto skupiny (i casti odstepene jinymi vlakny),
+ * cizi ulohy nebere. Kdyz zadnou ulohu skupiny nenajde, spi, dokud se
+ * skupina nedokonci nebo se do front nepridaji jeji dalsi casti. Vnorena
+ * paralelizace (parallelFor uvnitr ulohy) proto nevytvari dalsi vlakna.
+ *
+ * Vlakna mimo planovac (GUI, ImageSource, render, sluzba) dostanou pri
+ * prvni uloze vlastni frontu, ze ktere jim kradou pracovni vlakna;
+ * spolecnou frontu 0 pouziji, az kdyz jsou vsechny obsazene.
+ *
+ * Ulohy smi pouzivat ScratchArena::local() jen po dobu sveho behu; vlakno,
+ * ktere ceka ve wait(), muze mezitim vykonat jinou ulohu teze skupiny.
+ *
+ * Pocet vlaken je pocet jader, promenna prostredi ZPO_THREADS ho vynuti
+ * (1 - vse v volajicim vlakne). Pocet casti parallelFor a soucasne
+ * bezicich uloh TaskGroup::run lze omezit i jen pro aktualni vlakno
+ * (setLocalConcurrency, 1 - vse v tomto vlakne), napr. podle vysledku
+ * autotuningu pro dany filtr (Autotuner.h) nebo pro --workers.
+ *
+ * Vypocet lze zrusit priznakem nastavenym pro vlakno (setLocalCancel):
+ * casti parallelFor se po nastaveni priznaku preskoci (i ve vnorenych
+ * parallelFor) a parallelFor vyhodi Cancelled.
+ */
+class TaskScheduler
+{
+    friend class TaskGroup;
+
+    public:
+
+        /**
+         * Odkaz na zpracovani rozsahu [begin, end). Na rozdil od
+         * std::function nic nekopiruje ani nealokuje, jen odkazuje na
+         * funkci volajiciho, ktera existuje po celou dobu parallelFor.
+         */
+        class RangeBody
+        {
+            public:
+
+                template<typename Function, typename = typename std::enable_if<
+                    !std::is_same<typename std::decay<Function>::type, RangeBody>::value>::type>
+                RangeBody(const Function& function)
+                    : mCall(&call<Function>)
+                    , mFunction(&function)
+                {
+                }
+
+                void operator()(int begin, int end) const
+                {
+                    mCall(mFunction, begin, end);
+                }
+
+            private:
+
+                template<typename Function>
+                static void call(const void* function, int begin, int end)
+                {
+                    (*static_cast<const Function*>(function))(begin, end);
+                }
+
+                void (*mCall)(const void* function, int begin, int end);
+                const void* mFunction;
+        };
+
+        // Vyjimka zruseneho vypoctu (setLocalCancel)
+        struct Cancelled : public std::exception
+        {
+            const char* what() const noexcept override;
+        };
+
+    private:
+
+        // Nejvetsi velikost funkce TaskGroup::run (napr. lambda s odkazy)
+        static const size_t FUNCTION_BYTES = 64;
+
+        struct Task
+        {
+            // Obecna uloha (TaskGroup::run), kopie funkce je primo v uloze
+            alignas(std::max_align_t) unsigned char function[FUNCTION_BYTES];
+            void (*call)(void* function) = nullptr;
+            const RangeBody* body = nullptr;    // nebo cast parallelFor
+            int begin = 0;
+            int end = 0;
+            int grain = 1;
+            TaskGroup* group = nullptr;
+            MemoryTracker::Measurement* memory = nullptr; // mereni zadavajiciho vlakna
+        };
+
+        // Fronta s pevnou kapacitou, pri zaplneni se uloha vykona hned
+        struct Queue
+        {
+            static const int CAPACITY = 1024;
+
+            std::mutex mutex;
+            Task tasks[CAPACITY];
+            int head = 0;  // nejstarsi uloha (kradeni)
+            int count = 0;
+        };
+
+    private:
+
+        // Vlastni fronty vlaken mimo planovac
+        static const int EXTERNAL_QUEUES = 32;
+
+        std::vector<std::thread> mThreads;
+        int mThreadCount;
+        // 0 - vlakna mimo planovac bez vlastni fronty, 1.. - pracovni vlakna,
+        // od mThreadCount - vlastni fronty vlaken mimo planovac
+        std::vector<Queue*> mQueues;
+        std::atomic<bool> mExternalUsed[EXTERNAL_QUEUES];
+
+        std::vector<int> mThreadIds; // systemova ID pracovnich vlaken
+        std::condition_variable mStarted;
+
+        std::mutex mSleepMutex;
+        std::condition_variable mWake;
+        std::atomic<int> mQueued;
+        std::atomic<bool> mStop;
+
+    public:
+
+        static TaskScheduler& instance();
+
+        int threadCount() const;
+        std::vector<int> workerThreadIds();
+
+        void parallelFor(int begin, int end, int grain, const RangeBody& body);
+
+        static int setLocalConcurrency(int concurrency);
+        static const std::atomic<bool>* setLocalCancel(const std::atomic<bool>* cancel);
+
+        ~TaskScheduler();
+
+    private:
+
+        explicit TaskScheduler(int threadCount);
+
+        void runRange(int begin, int end, int grain, const RangeBody& body);
+        void workerLoop(int index);
+        bool push(Task& task);
+        bool pop(Task& task, const TaskGroup* group);
+        void execute(Task& task);
+        void split(Task& task);
+
+        Queue& localQueue();
+        int claimExternalQueue();
+};
+
+/**
+ * Skupina uloh, na jejichz dokonceni lze pockat. Zavislosti mezi ulohami se
+ * vyjadruji vnorenim: uloha muze spustit vlastni skupinu a pockat na ni,
+ * navazujici ulohy se spusti az po wait().
+ */
+class TaskGroup
+{
+    friend class TaskScheduler;
+
+    private:
+
+        TaskScheduler& mScheduler;
+        std::atomic<int> mPending;
+
+        // Spanek cekajiciho vlakna (dokonceni skupiny, nove casti ve frontach)
+        std::mutex mWaitMutex;
+        std::condition_variable mWake;
+        bool mWork;
+
+        std::mutex mErrorMutex;
+        std::exception_ptr mError;
+
+    public:
+
+        TaskGroup();
+        ~TaskGroup();
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        template<typename Function>
+        void run(const Function& function);
+        void wait();
+
+    private:
+
+        template<typename Function>
+        static void call(void* function);
+
+        void submit(TaskScheduler::Task& task);
+        void help();
+        void finishTask();
+        void notifyWork();
+        void fail(std::exception_ptr error);
+};
+
+/**
+ * Spusteni ulohy ve skupine. Funkce se zkopiruje primo do ulohy, fronty
+ * tedy nealokuji; musi byt mala a trivialne kopirovatelna (lambda
+ * s odkazy a cisly), vetsi data se predavaji odkazem.
+ *
+ * @param function uloha
+ */
+template<typename Function>
+void TaskGroup::run(const Function& function)
+{
+    static_assert(sizeof(Function) <= TaskScheduler::FUNCTION_BYTES
+                  && alignof(Function) <= alignof(std::max_align_t),
+                  "TaskGroup::run: function too large, capture data by reference");
+    static_assert(std::is_trivially_copyable<Function>::value
+                  && std::is_trivially_destructible<Function>::value,
+                  "TaskGroup::run: function must be trivially copyable");
+
+    TaskScheduler::Task task;
+    new (task.function) Function(function);
+    task.call = &TaskGroup::call<Function>;
+    task.group = this;
+
+    submit(task);
+}
+
+/**
+ * Vykonani funkce ulozene v uloze.
+ *
+ * @param function kopie funkce v uloze
+ */
+template<typename Function>
+void TaskGroup::call(void* function)
+{
+    (*static_cast<Function*>(function))();
+}
+
+#endif	/* TASKSCHEDULER_H */
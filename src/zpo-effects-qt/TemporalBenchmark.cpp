@@ -0,0 +1,169 @@
+/*
+ * Soubor: TemporalBenchmark.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "TemporalBenchmark.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+#include <opencv2/highgui/highgui.hpp> // cv::VideoCapture
+
+#include "FrameProcessor.h"
+
+// Strana a rychlost (pixely na snimek) pohybujiciho se ctverce
+static const int SQUARE_SIZE = 48;
+static const int SQUARE_STEP = 4;
+
+/**
+ * Synteticky snimek s malym pohybem: staticke pozadi (nahodny sum)
+ * a jeden ctverec posunuty o SQUARE_STEP pixelu na snimek.
+ *
+ * @param background pozadi
+ * @param index poradi snimku
+ * @param frame vystupni snimek
+ */
+static void syntheticFrame(const cv::Mat& background, int index, cv::Mat& frame)
+{
+    background.copyTo(frame);
+
+    int side = std::min(SQUARE_SIZE, std::min(frame.cols, frame.rows));
+    int range = std::max(frame.cols - side, 1);
+    int x = (index * SQUARE_STEP) % range;
+    int y = (frame.rows - side) / 2;
+
+    frame(cv::Rect(x, y, side, side)).setTo(cv::Scalar(40, 200, 120));
+}
+
+/**
+ * Spusteni mereni. Pro kazdy filtr se kazdy snimek filtruje cely i jen
+ * po zmenenych dlazdicich, meri se cas obou (bez dekodovani vstupu)
+ * a nejvetsi odchylka vystupu.
+ *
+ * @param commandLine argumenty prikazove radky
+ * @return 0 - pri nulovem prahu (ZPO_DIRTY_THRESHOLD) jsou vystupy shodne
+ */
+int TemporalBenchmark::run(const CommandLine& commandLine)
+{
+    cv::VideoCapture capture;
+    cv::Mat background;
+
+    if (!commandLine.getInputs().empty())
+    {
+        if (!capture.open(commandLine.getInputs().front()))
+        {
+            std::cerr << "Could not load video: " << commandLine.getInputs().front() << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        cv::Size size = commandLine.getSizes().empty() ? cv::Size(640, 480)
+                                                       : commandLine.getSizes().front();
+
+        background.create(size, CV_8UC3);
+        cv::randu(background, cv::Scalar::all(0), cv::Scalar::all(256));
+    }
+
+    char line[256];
+    snprintf(line, sizeof(line), "%-20s %10s %10s %8s %7s %9s %9s %6s",
+             "filter", "full ms", "dirty ms", "speedup", "dirty %", "refreshes", "max error", "result");
+    std::cout << line << std::endl;
+
+    int failed = 0;
+    int frameCount = commandLine.getWarmup() + commandLine.getIterations();
+    double threshold = 0;
+
+    for (ImageFilter::Type filterType : commandLine.getFilterTypes())
+    {
+        FrameProcessor full;
+        FrameProcessor temporal;
+        full.setFilterType(filterType);
+        temporal.setFilterType(filterType);
+        temporal.setTemporal(true);
+        threshold = temporal.getDirtyThreshold();
+
+        if (!temporal.isTemporal())
+        {
+            std::cerr << "Dirty tiles are disabled (ZPO_DIRTY_TILES)" << std::endl;
+            return 1;
+        }
+
+        long long fullTicks = 0;
+        long long temporalTicks = 0;
+        double maxError = 0;
+
+        if (capture.isOpened())
+        {
+            capture.set(CV_CAP_PROP_POS_FRAMES, 0);
+        }
+
+        for (int i = 0; i < frameCount; i++)
+        {
+            if (capture.isOpened())
+            {
+                if (!capture.read(full.input()))
+                {
+                    capture.set(CV_CAP_PROP_POS_FRAMES, 0);
+                    capture.read(full.input());
+                }
+            }
+            else
+            {
+                syntheticFrame(background, i, full.input());
+            }
+
+            full.input().copyTo(temporal.input());
+
+            if (i == commandLine.getWarmup())
+            {
+                temporal.resetStatistics();
+            }
+
+            long long start = cv::getTickCount();
+            cv::Mat expected = full.process();
+            long long middle = cv::getTickCount();
+            cv::Mat output = temporal.process();
+            long long end = cv::getTickCount();
+
+            if (i >= commandLine.getWarmup())
+            {
+                fullTicks += middle - start;
+                temporalTicks += end - middle;
+            }
+
+            maxError = std::max(maxError, cv::norm(output, expected, cv::NORM_INF));
+        }
+
+        const FrameProcessor::Statistics& stats = temporal.statistics();
+        int frames = std::max(commandLine.getIterations(), 1);
+        double fullMs = fullTicks * 1000.0 / cv::getTickFrequency() / frames;
+        double temporalMs = temporalTicks * 1000.0 / cv::getTickFrequency() / frames;
+
+        bool ok = threshold > 0 || maxError == 0;
+        failed += ok ? 0 : 1;
+
+        char dirty[16] = "-";
+        if (stats.tiles > 0)
+        {
+            snprintf(dirty, sizeof(dirty), "%.1f", 100.0 * stats.dirtyTiles / stats.tiles);
+        }
+
+        snprintf(line, sizeof(line), "%-20s %10.3f %10.3f %7.2fx %7s %9lld %9.0f %6s",
+                 ImageFilter::typeName(filterType), fullMs, temporalMs,
+                 temporalMs > 0 ? fullMs / temporalMs : 0.0, dirty, stats.refreshes, maxError,
+                 ok ? "OK" : "FAIL");
+        std::cout << line << std::endl;
+    }
+
+    std::cout << "tile: " << FrameProcessor::TILE_SIZE << "x" << FrameProcessor::TILE_SIZE
+              << ", threshold: " << threshold << std::endl;
+
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,27 @@
+/*
+ * Soubor: TemporalBenchmark.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef TEMPORALBENCHMARK_H
+#define	TEMPORALBENCHMARK_H
+
+#include "CommandLine.h"
+
+/**
+ * Mereni casoveho rezimu FrameProcessor (prepocet jen zmenenych dlazdic)
+ * proti filtraci celych snimku na videu nebo syntetickem zaberu s malym
+ * pohybem. Vystupy obou rezimu se porovnavaji snimek po snimku.
+ */
+class TemporalBenchmark
+{
+    public:
+
+        static int run(const CommandLine& commandLine);
+};
+
+#endif	/* TEMPORALBENCHMARK_H */
@@ -0,0 +1,205 @@
+/*
+ * Soubor: TiledExecutor.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "TiledExecutor.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "PlanarImage.h"
+#include "Stencil3x3.h"
+#include "TaskScheduler.h"
+
+// Velikost pracovnich dat jednoho pruhu (vsechny buffery stupnu), aby se
+// vesla do L2 cache
+static const int TILE_CACHE_BYTES = 512 * 1024;
+
+// Nizsi pruh uz by vetsinu casu pocital prekryvy
+static const int MIN_STRIP_ROWS = 16;
+
+// Vyska pruhu nastavena pro aktualni vlakno (-1 - podle velikosti cache)
+static thread_local int tStripRows = -1;
+
+/**
+ * Buffer pruhu (mezivysledek stupne) v ScratchArena aktualniho vlakna.
+ * Buffer ma stejnou velikost pro vsechny pruhy, alokuje se tedy jen poprve.
+ *
+ * @param slot slot mezivysledku
+ * @param type typ obrazu
+ * @return buffer pruhu
+ */
+cv::Mat& TiledExecutor::Tile::buffer(ScratchArena::Slot slot, int type) const
+{
+    return ScratchArena::local().get(slot, cv::Size(cols, bufferRows), type);
+}
+
+/**
+ * Radky [begin, end) obrazu v bufferu pruhu.
+ *
+ * @param buffer buffer pruhu (radek 0 odpovida radku top obrazu)
+ * @param begin prvni radek obrazu
+ * @param end radek za poslednim radkem obrazu
+ * @return vyrez bufferu
+ */
+cv::Mat TiledExecutor::Tile::rows(cv::Mat& buffer, int begin, int end) const
+{
+    return buffer.rowRange(begin - top, end - top);
+}
+
+/**
+ * Radek y obrazu v bufferu pruhu, radky mimo obraz se zrcadli (REFLECT_101).
+ *
+ * @param buffer buffer pruhu (radek 0 odpovida radku top obrazu)
+ * @param y radek obrazu (-2 az imageRows + 1)
+ * @return ukazatel na radek
+ */
+unsigned char* TiledExecutor::Tile::row(cv::Mat& buffer, int y) const
+{
+    return buffer.ptr(Stencil3x3::borderIndex(y, imageRows, Stencil3x3::REFLECT_101) - top);
+}
+
+/**
+ * Planarni buffer pruhu (roviny B, G, R pod sebou) v ScratchArena
+ * aktualniho vlakna.
+ *
+ * @param slot slot mezivysledku
+ * @return planarni buffer pruhu
+ */
+cv::Mat& TiledExecutor::Tile::planes(ScratchArena::Slot slot) const
+{
+    return ScratchArena::local().get(slot, PlanarImage::size(cv::Size(cols, bufferRows)), CV_8UC1);
+}
+
+/**
+ * Radky [begin, end) obrazu ve vsech rovinach planarniho bufferu pruhu.
+ *
+ * @param planes planarni buffer pruhu
+ * @param begin prvni radek obrazu
+ * @param end radek za poslednim radkem obrazu
+ * @param rows vystupni vyrezy rovin
+ */
+void TiledExecutor::Tile::planeRows(cv::Mat& planes, int begin, int end, cv::Mat rows[3]) const
+{
+    PlanarImage::planes(planes, begin - top, end - top, rows);
+}
+
+/**
+ * Radek y obrazu ve vsech rovinach planarniho bufferu pruhu, radky mimo
+ * obraz se zrcadli (REFLECT_101).
+ *
+ * @param planes planarni buffer pruhu
+ * @param y radek obrazu (-2 az imageRows + 1)
+ * @param rows vystupni ukazatele na radky rovin B, G, R
+ */
+void TiledExecutor::Tile::planeRow(cv::Mat& planes, int y, unsigned char* rows[3]) const
+{
+    PlanarImage::rows(planes, Stencil3x3::borderIndex(y, imageRows, Stencil3x3::REFLECT_101) - top,
+                      rows);
+}
+
+/**
+ * Zpracovani obrazu po pruzich. Pruhy jsou nezavisle a zpracuji se
+ * paralelne (TaskScheduler), kazdy s buffery ve ScratchArena sveho vlakna.
+ * Pro kazdy pruh se postupne spusti vsechny stupne, kazdy na rozsahu
+ * radku, ktery potrebuji nasledujici stupne.
+ *
+ * @param size velikost obrazu
+ * @param stripRows vyska pruhu (0 - cely obraz najednou)
+ * @param stages stupne retezce v poradi zpracovani
+ */
+void TiledExecutor::run(cv::Size size, int stripRows, std::initializer_list<Stage> stages)
+{
+    int imageRows = size.height;
+    int strip = stripRows > 0 ? stripRows : imageRows;
+
+    if (imageRows <= 0)
+    {
+        return;
+    }
+
+    int totalHalo = 0;
+    for (const Stage& stage : stages)
+    {
+        totalHalo += stage.halo;
+    }
+
+    int stripCount = (imageRows + strip - 1) / strip;
+
+    TaskScheduler::instance().parallelFor(0, stripCount, 1, [&](int begin, int end) {
+        Tile tile;
+        tile.imageRows = imageRows;
+        tile.cols = size.width;
+        tile.bufferRows = std::min(strip + 2 * totalHalo, imageRows);
+
+        for (int s = begin; s < end; s++)
+        {
+            int y0 = s * strip;
+            int y1 = std::min(y0 + strip, imageRows);
+
+            tile.top = std::max(y0 - totalHalo, 0);
+            tile.bottom = std::min(y1 + totalHalo, imageRows);
+
+            // Soucet halo stupnu za aktualnim stupnem
+            int halo = totalHalo;
+
+            for (const Stage& stage : stages)
+            {
+                halo -= stage.halo;
+
+                tile.first = std::max(y0 - halo, 0);
+                tile.last = std::min(y1 + halo, imageRows);
+
+                stage.run(tile);
+            }
+        }
+    });
+}
+
+/**
+ * Vyska pruhu, pri ktere se buffery pruhu vejdou do cache. Promenna
+ * prostredi ZPO_TILE_ROWS vyskou pruhu vynuti (0 - bez deleni na pruhy),
+ * jinak plati vyska nastavena pro aktualni vlakno (setLocalStripRows).
+ *
+ * @param cols sirka obrazu
+ * @param bytesPerPixel soucet velikosti pixelu vsech bufferu pruhu
+ * @return vyska pruhu (0 - cely obraz najednou)
+ */
+int TiledExecutor::stripRows(int cols, int bytesPerPixel)
+{
+    static const char* forced = getenv("ZPO_TILE_ROWS");
+
+    if (forced != nullptr && *forced != '\0')
+    {
+        return std::max(atoi(forced), 0);
+    }
+
+    if (tStripRows >= 0)
+    {
+        return tStripRows;
+    }
+
+    int rowBytes = std::max(cols * bytesPerPixel, 1);
+
+    return std::max(TILE_CACHE_BYTES / rowBytes, MIN_STRIP_ROWS);
+}
+
+/**
+ * Nastaveni vysky pruhu pro aktualni vlakno, napr. podle vysledku
+ * autotuningu pro dany filtr a rozliseni.
+ *
+ * @param stripRows vyska pruhu (0 - cely obraz, -1 - podle velikosti cache)
+ * @return predchozi nastaveni (pro obnoveni)
+ */
+int TiledExecutor::setLocalStripRows(int stripRows)
+{
+    int previous = tStripRows;
+    tStripRows = std::max(stripRows, -1);
+
+    return previous;
+}
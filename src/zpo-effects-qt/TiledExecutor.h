@@ -0,0 +1,110 @@
+/*
+ * Soubor: TiledExecutor.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef TILEDEXECUTOR_H
+#define	TILEDEXECUTOR_H
+
+#include <initializer_list>
+
+#include <opencv2/core/core.hpp> // cv::Mat
+
+#include "ScratchArena.h"
+
+/**
+ * Zpracovani retezce filtru (stupnu) po pruzich radku. Mezivysledky maji
+ * velikost jednoho pruhu a zustavaji v cache, misto aby kazdy stupen
+ * prosel cely obraz v pameti.
+ *
+ * Pruhy se prekryvaji: stupen s maskou vysky 2 * halo + 1 potrebuje od
+ * predchozich stupnu o halo radku vic nahore i dole. Stupen pocita svuj
+ * pruh jako samostatny obraz (okraj REFLECT_101), chybne radky u okraje
+ * pruhu lezi jen v prekryvu a do vysledku se nedostanou. U okraje obrazu
+ * je okraj pruhu zaroven okrajem obrazu, vysledek je tedy shodny se
+ * zpracovanim celeho obrazu najednou.
+ *
+ * Pruhy jsou pres celou sirku obrazu, protoze funkce radku (KernelDispatch)
+ * resi okrajove sloupce samy.
+ *
+ * Pruhy se zpracovavaji paralelne, stupne proto smi do sdilenych dat
+ * (napr. histogramu) zapisovat jen se synchronizaci.
+ */
+class TiledExecutor
+{
+    public:
+
+        /**
+         * Pruh zpracovavany jednim stupnem.
+         */
+        struct Tile
+        {
+            int top;       // prvni radek obrazu ulozeny v bufferech pruhu
+            int bottom;    // radek za poslednim radkem v bufferech pruhu
+            int first;     // prvni radek, ktery ma stupen spocitat
+            int last;      // radek za poslednim radkem, ktery ma stupen spocitat
+            int imageRows; // vyska celeho obrazu
+            int cols;      // sirka obrazu
+            int bufferRows;
+
+            cv::Mat& buffer(ScratchArena::Slot slot, int type) const;
+            cv::Mat rows(cv::Mat& buffer, int begin, int end) const;
+            unsigned char* row(cv::Mat& buffer, int y) const;
+
+            // Planarni buffery pruhu (PlanarImage.h)
+            cv::Mat& planes(ScratchArena::Slot slot) const;
+            void planeRows(cv::Mat& planes, int begin, int end, cv::Mat rows[3]) const;
+            void planeRow(cv::Mat& planes, int y, unsigned char* rows[3]) const;
+        };
+
+        /**
+         * Stupen retezce. Spocita radky [first, last) sveho vystupu, vystupy
+         * predchozich stupnu jsou platne v [first - halo, last + halo)
+         * (orezano na obraz). Halo prvniho stupne se tyka vstupniho obrazu.
+         *
+         * Stupen funkci jen odkazuje (bez alokace), stupne se proto predavaji
+         * primo ve volani run.
+         */
+        class Stage
+        {
+            public:
+
+                template<typename Function>
+                Stage(int halo, const Function& function)
+                    : halo(halo)
+                    , mCall(&call<Function>)
+                    , mFunction(&function)
+                {
+                }
+
+                void run(const Tile& tile) const
+                {
+                    mCall(mFunction, tile);
+                }
+
+                int halo;
+
+            private:
+
+                template<typename Function>
+                static void call(const void* function, const Tile& tile)
+                {
+                    (*static_cast<const Function*>(function))(tile);
+                }
+
+                void (*mCall)(const void* function, const Tile& tile);
+                const void* mFunction;
+        };
+
+    public:
+
+        static void run(cv::Size size, int stripRows, std::initializer_list<Stage> stages);
+        static int stripRows(int cols, int bytesPerPixel);
+        static int setLocalStripRows(int stripRows);
+};
+
+#endif	/* TILEDEXECUTOR_H */
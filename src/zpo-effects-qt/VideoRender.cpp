@@ -0,0 +1,250 @@
+/*
+ * Soubor: VideoRender.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "VideoRender.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <opencv2/highgui/highgui.hpp> // cv::VideoCapture, cv::VideoWriter
+
+#include "Autotuner.h"
+#include "BufferPool.h"
+#include "FrameQueue.h"
+#include "ReorderBuffer.h"
+
+// Snimky ve fronte dekodovanych snimku
+static const int QUEUE_FRAMES = 4;
+
+// Mista pro obnoveni poradi na jedno filtrovaci vlakno
+static const int REORDER_FRAMES = 2;
+
+// FPS videa, ktere ho neuvadi
+static const double DEFAULT_FPS = 25;
+
+// Interval vypisu prubehu (sekundy)
+static const double PROGRESS_INTERVAL = 1.0;
+
+/**
+ * Kodek vystupu, promenna prostredi ZPO_RENDER_CODEC (ctyri znaky FOURCC)
+ * ho prepise.
+ *
+ * @return FOURCC kodeku (vychozi MJPG)
+ */
+static int outputCodec()
+{
+    const char* codec = getenv("ZPO_RENDER_CODEC");
+
+    if (codec == nullptr || strlen(codec) != 4)
+    {
+        codec = "MJPG";
+    }
+
+    return CV_FOURCC(codec[0], codec[1], codec[2], codec[3]);
+}
+
+/**
+ * Jeden pruchod filtrace videa do souboru. Dekodovani, filtrace a kodovani
+ * bezi ve vlastnich vlaknech. Jedno filtrovaci vlakno deli kazdy snimek
+ * mezi vlakna planovace (TaskScheduler); pri vice vlaknech (workers)
+ * filtruje kazde vlakno cely snimek samo a poradi snimku pro kodovani
+ * obnovi ReorderBuffer. V pameti jsou nejvyse snimky front, rozpracovane
+ * snimky a snimky cekajici na poradi.
+ *
+ * @param commandLine argumenty prikazove radky (video, filtr, vystupni soubor)
+ * @param workers pocet filtrovacich vlaken
+ * @param fps vystupni snimky za sekundu filtrace (0 - zadny snimek)
+ * @return navratovy kod programu
+ */
+static int renderPass(const CommandLine& commandLine, int workers, double* fps)
+{
+    const std::string& input = commandLine.getInputs().front();
+    const std::string& output = commandLine.getOutputDir();
+    ImageFilter::Type filterType = commandLine.getFilterTypes().front();
+
+    cv::VideoCapture capture;
+
+    if (!capture.open(input))
+    {
+        std::cerr << "Could not load video: " << input << std::endl;
+        return 1;
+    }
+
+    double videoFps = capture.get(CV_CAP_PROP_FPS);
+    if (videoFps <= 0)
+    {
+        videoFps = DEFAULT_FPS;
+    }
+
+    int totalFrames = (int) capture.get(CV_CAP_PROP_FRAME_COUNT);
+    cv::Size size((int) capture.get(CV_CAP_PROP_FRAME_WIDTH), (int) capture.get(CV_CAP_PROP_FRAME_HEIGHT));
+    int outputType = ImageFilter::outputType(filterType, CV_8UC3);
+
+    cv::VideoWriter writer;
+
+    if (!writer.open(output, outputCodec(), videoFps, size, CV_MAT_CN(outputType) == 3))
+    {
+        std::cerr << "Could not write video: " << output << std::endl;
+        return 1;
+    }
+
+    FrameQueue decoded(QUEUE_FRAMES);
+    ReorderBuffer ordered(REORDER_FRAMES * workers);
+
+    // Buffery snimku se vraci do zasobniku, jakmile je dalsi faze uvolni
+    std::mutex outputMutex;
+    BufferPool outputPool((REORDER_FRAMES + 1) * workers + 2);
+
+    long long start = cv::getTickCount();
+    int frames = 0;
+
+    std::thread decoder([&] {
+        BufferPool pool(QUEUE_FRAMES + workers + 2);
+
+        for (int index = 0; ; index++)
+        {
+            cv::Mat frame = pool.acquire(size, CV_8UC3);
+
+            if (!capture.read(frame) || !decoded.push(index, frame))
+            {
+                break;
+            }
+        }
+
+        decoded.close();
+    });
+
+    std::vector<std::thread> filters;
+
+    for (int w = 0; w < workers; w++)
+    {
+        filters.emplace_back([&] {
+            // Vice vlaken filtruje kazde svuj snimek bez deleni mezi vlakna
+            // planovace (ostatni nastaveni autotuningu plati dal)
+            const Autotuner::Config* tuned = Autotuner::lookup(filterType, size);
+            Autotuner::Config config = tuned != nullptr ? *tuned : Autotuner::Config { nullptr, 0, -1, -1 };
+            if (workers > 1)
+            {
+                config.threads = 1;
+            }
+            Autotuner::Scope scope(&config);
+
+            FrameQueue::Frame frame;
+
+            while (decoded.pop(&frame))
+            {
+                cv::Mat dst;
+                {
+                    std::lock_guard<std::mutex> lock(outputMutex);
+                    dst = outputPool.acquire(frame.image.size(), outputType);
+                }
+
+                ImageFilter::filter(frame.image, dst, filterType);
+                frame.image.release();
+
+                if (!ordered.push(frame.index, dst))
+                {
+                    break;
+                }
+            }
+        });
+    }
+
+    std::thread encoder([&] {
+        FrameQueue::Frame frame;
+        long long lastReport = start;
+        bool reported = false;
+
+        while (ordered.pop(&frame))
+        {
+            writer.write(frame.image);
+            frames++;
+
+            long long now = cv::getTickCount();
+            if ((now - lastReport) / cv::getTickFrequency() >= PROGRESS_INTERVAL)
+            {
+                double seconds = (now - start) / cv::getTickFrequency();
+                fprintf(stderr, "\rframe %d/%d  %.1f fps", frames, totalFrames, frames / seconds);
+                lastReport = now;
+                reported = true;
+            }
+        }
+
+        if (reported)
+        {
+            fprintf(stderr, "\n");
+        }
+    });
+
+    decoder.join();
+    for (std::thread& filter : filters)
+    {
+        filter.join();
+    }
+    ordered.close();
+    encoder.join();
+    writer.release();
+
+    double seconds = (cv::getTickCount() - start) / cv::getTickFrequency();
+    double videoSeconds = frames / videoFps;
+    *fps = seconds > 0 ? frames / seconds : 0.0;
+
+    char line[256];
+    snprintf(line, sizeof(line), "%d frames in %.2f s, %.1f fps, %.2fx real time, %d worker%s",
+             frames, seconds, *fps, seconds > 0 ? videoSeconds / seconds : 0.0,
+             workers, workers > 1 ? "s" : "");
+    std::cout << line << std::endl;
+
+    return frames > 0 ? 0 : 1;
+}
+
+/**
+ * Spusteni filtrace videa do souboru. Pri vice hodnotach --workers se video
+ * filtruje postupne s kazdym poctem vlaken (vystup prepise posledni
+ * pruchod) a na konci se vypise srovnani snimku za sekundu.
+ *
+ * @param commandLine argumenty prikazove radky (video, filtr, vystupni soubor)
+ * @return navratovy kod programu
+ */
+int VideoRender::run(const CommandLine& commandLine)
+{
+    std::vector<int> workerCounts = commandLine.getWorkerCounts();
+    std::vector<double> fps(workerCounts.size(), 0.0);
+
+    for (size_t i = 0; i < workerCounts.size(); i++)
+    {
+        int result = renderPass(commandLine, workerCounts[i], &fps[i]);
+
+        if (result != 0)
+        {
+            return result;
+        }
+    }
+
+    if (workerCounts.size() > 1)
+    {
+        char line[256];
+        snprintf(line, sizeof(line), "%8s %8s %8s", "workers", "fps", "speedup");
+        std::cout << line << std::endl;
+
+        for (size_t i = 0; i < workerCounts.size(); i++)
+        {
+            snprintf(line, sizeof(line), "%8d %8.1f %7.2fx", workerCounts[i], fps[i],
+                     fps[0] > 0 ? fps[i] / fps[0] : 0.0);
+            std::cout << line << std::endl;
+        }
+    }
+
+    return 0;
+}
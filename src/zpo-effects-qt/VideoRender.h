@@ -0,0 +1,31 @@
+/*
+ * Soubor: VideoRender.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef VIDEORENDER_H
+#define	VIDEORENDER_H
+
+#include "CommandLine.h"
+
+/**
+ * Filtrace videa do souboru bez prehravani: snimky se dekoduji, filtruji
+ * a koduji (cv::VideoWriter) co nejrychleji, kazda faze ve vlastnim
+ * vlakne spojenem omezenymi frontami (FrameQueue.h), takze faze se
+ * prekryvaji a v pameti je jen nekolik snimku. Snimky mohou filtrovat
+ * soucasne vlakna (--workers), pro kodovani se seradi v ReorderBuffer.
+ * Prubezne se vypisuje pocet zpracovanych snimku a snimky za sekundu,
+ * opakovane --workers porovna vykon pro ruzny pocet vlaken.
+ */
+class VideoRender
+{
+    public:
+
+        static int run(const CommandLine& commandLine);
+};
+
+#endif	/* VIDEORENDER_H */
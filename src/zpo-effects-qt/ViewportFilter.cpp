@@ -0,0 +1,154 @@
+/*
+ * Soubor: ViewportFilter.cpp
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#include "ViewportFilter.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <opencv2/imgproc/imgproc.hpp> // cv::resize
+
+/**
+ * Velikost vystupu filtrace oblasti: oblast zmensena (se zachovanim
+ * pomeru stran) tak, aby se vesla do cilove velikosti. Oblast se nikdy
+ * nezvetsuje.
+ *
+ * @param imageSize velikost obrazku
+ * @param roi oblast obrazku (prazdna - cely obrazek)
+ * @param target cilova velikost (prazdna - plne rozliseni)
+ * @return velikost vystupu
+ */
+cv::Size ViewportFilter::outputSize(cv::Size imageSize, cv::Rect roi, cv::Size target)
+{
+    roi = clampRoi(imageSize, roi);
+
+    if (target.width <= 0 || target.height <= 0
+        || (target.width >= roi.width && target.height >= roi.height))
+    {
+        return roi.size();
+    }
+
+    double scale = std::min((double) target.width / roi.width, (double) target.height / roi.height);
+
+    return cv::Size(std::max((int) std::lround(roi.width * scale), 1),
+                    std::max((int) std::lround(roi.height * scale), 1));
+}
+
+/**
+ * Priblizny pocet pixelu, ktere filtr zpracuje (bez okraje masek).
+ *
+ * @param imageSize velikost obrazku
+ * @param filterType typ filtru
+ * @param roi oblast obrazku (prazdna - cely obrazek)
+ * @param target cilova velikost (prazdna - plne rozliseni)
+ * @return pocet pixelu
+ */
+double ViewportFilter::workPixels(cv::Size imageSize, ImageFilter::Type filterType,
+                                  cv::Rect roi, cv::Size target)
+{
+    roi = clampRoi(imageSize, roi);
+    double output = outputSize(imageSize, roi, target).area();
+
+    if (ImageFilter::stencilRadius(filterType) >= 0)
+    {
+        return output;
+    }
+
+    return (double) imageSize.area() * output / roi.area();
+}
+
+/**
+ * Filtrace oblasti obrazku ve velikosti outputSize. U filtru s maskami se
+ * filtruje jen oblast s okrajem polomeru masek (ve zmensenem meritku
+ * o polomer vic kvuli prumerovani pri zmenseni), okraj obrazku zustava
+ * okrajem filtrovaneho vyrezu.
+ *
+ * @param src vstupni obrazek
+ * @param dst vystup velikosti outputSize
+ * @param filterType typ filtru
+ * @param roi oblast obrazku (prazdna - cely obrazek)
+ * @param target cilova velikost (prazdna - plne rozliseni)
+ */
+void ViewportFilter::filter(const cv::Mat& src, cv::Mat& dst, ImageFilter::Type filterType,
+                            cv::Rect roi, cv::Size target)
+{
+    cv::Rect image(0, 0, src.cols, src.rows);
+    roi = clampRoi(src.size(), roi);
+
+    cv::Size size = outputSize(src.size(), roi, target);
+    bool full = size == roi.size();
+    double scaleX = (double) size.width / roi.width;
+    double scaleY = (double) size.height / roi.height;
+
+    int radius = ImageFilter::stencilRadius(filterType);
+
+    cv::Rect field = image;
+    if (radius >= 0)
+    {
+        int borderX = full ? radius : (int) std::ceil((radius + 1) / scaleX);
+        int borderY = full ? radius : (int) std::ceil((radius + 1) / scaleY);
+
+        field = cv::Rect(roi.x - borderX, roi.y - borderY,
+                         roi.width + 2 * borderX, roi.height + 2 * borderY);
+        field &= image;
+    }
+
+    cv::Mat filtered;
+
+    if (full)
+    {
+        ImageFilter::filter(src(field), filtered, filterType);
+        filtered(roi - field.tl()).copyTo(dst);
+        return;
+    }
+
+    ImageFilter::filter(scaled(src(field), scaleX, scaleY), filtered, filterType);
+
+    // Oblast ve zmensenem vyrezu (zaokrouhleni muze posunout okraj o pixel)
+    cv::Rect part((int) std::lround((roi.x - field.x) * scaleX),
+                  (int) std::lround((roi.y - field.y) * scaleY), size.width, size.height);
+    part.x = std::max(std::min(part.x, filtered.cols - size.width), 0);
+    part.y = std::max(std::min(part.y, filtered.rows - size.height), 0);
+
+    filtered(part).copyTo(dst);
+}
+
+/**
+ * Orezani oblasti na obrazek.
+ *
+ * @param imageSize velikost obrazku
+ * @param roi oblast (prazdna nebo mimo obrazek - cely obrazek)
+ * @return oblast uvnitr obrazku
+ */
+cv::Rect ViewportFilter::clampRoi(cv::Size imageSize, cv::Rect roi)
+{
+    cv::Rect image(0, 0, imageSize.width, imageSize.height);
+    roi &= image;
+
+    return roi.area() > 0 ? roi : image;
+}
+
+/**
+ * Zmenseni obrazku (prumerovanim).
+ *
+ * @param src obrazek
+ * @param scaleX meritko sirky
+ * @param scaleY meritko vysky
+ * @return zmenseny obrazek, aspon 1x1
+ */
+cv::Mat ViewportFilter::scaled(const cv::Mat& src, double scaleX, double scaleY)
+{
+    cv::Size size(std::max((int) std::lround(src.cols * scaleX), 1),
+                  std::max((int) std::lround(src.rows * scaleY), 1));
+
+    cv::Mat result;
+    cv::resize(src, result, size, 0, 0, cv::INTER_AREA);
+
+    return result;
+}
@@ -0,0 +1,41 @@
+/*
+ * Soubor: ViewportFilter.h
+ * Popis:  VUT Brno FIT - Zpracovani obrazu (ZPO)
+ *         Filtrove "efekty" v obrazu
+ * Autori: Frantisek Nemec (xnemec61@stud.fit.vutbr.cz)
+ *         Jan Opalka (xopalk01@stud.fit.vutbr.cz)
+ * Datum:  2026-10-19
+ */
+
+#ifndef VIEWPORTFILTER_H
+#define	VIEWPORTFILTER_H
+
+#include <opencv2/core/core.hpp> // cv::Mat
+
+#include "ImageFilter.h"
+
+/**
+ * Filtrace jen zobrazene casti obrazku (oblast) v rozliseni zobrazeni.
+ * Vyrez s okrajem masek (ImageFilter::stencilRadius) se zmensi na velikost,
+ * ve ktere se oblast zobrazi, a teprve ten se filtruje; prace je tak
+ * umerna velikosti okna, ne obrazku. V plnem rozliseni je vysledek shodny
+ * s vyrezem filtrace celeho obrazku. Filtry zavisle na celem obrazu
+ * (stencilRadius -1) filtruji cely obrazek zmenseny do meritka zobrazeni.
+ */
+class ViewportFilter
+{
+    public:
+
+        static cv::Size outputSize(cv::Size imageSize, cv::Rect roi, cv::Size target);
+        static double workPixels(cv::Size imageSize, ImageFilter::Type filterType,
+                                 cv::Rect roi, cv::Size target);
+        static void filter(const cv::Mat& src, cv::Mat& dst, ImageFilter::Type filterType,
+                           cv::Rect roi, cv::Size target);
+
+    private:
+
+        static cv::Rect clampRoi(cv::Size imageSize, cv::Rect roi);
+        static cv::Mat scaled(const cv::Mat& src, double scaleX, double scaleY);
+};
+
+#endif	/* VIEWPORTFILTER_H */
@@ -10,11 +10,27 @@
 #include <QApplication>
 #include <QMetaType>
 #include <QStyleFactory>
+#include <iostream>
 #include <string>
 #include <opencv2/core/core.hpp> // cv::Mat
 
 #include "MainWindow.h"
 #include "ImageFilter.h"
+#include "CommandLine.h"
+#include "AllocationCheck.h"
+#include "Autotuner.h"
+#include "Batch.h"
+#include "Benchmark.h"
+#include "FilterCheck.h"
+#include "FilterService.h"
+#include "KernelCheck.h"
+#include "LoadGenerator.h"
+#include "RawPipe.h"
+#include "ShmConsumer.h"
+#include "ShmProducer.h"
+#include "ShmRelay.h"
+#include "TemporalBenchmark.h"
+#include "VideoRender.h"
 
 /**
  * Nastaveni fusion stylu.
@@ -64,8 +80,56 @@ void registerMetaTypes()
     qRegisterMetaType<ImageFilter::Type>("ImageFilter::Type");
 }
 
+/**
+ * Spusteni rezimu bez GUI.
+ * 
+ * @param commandLine argumenty prikazove radky
+ * @return navratovy kod programu
+ */
+int runHeadless(const CommandLine& commandLine)
+{
+    switch (commandLine.getMode())
+    {
+        case CommandLine::Mode::BATCH:        return Batch::run(commandLine);
+        case CommandLine::Mode::BENCHMARK:    return Benchmark::run(commandLine);
+        case CommandLine::Mode::ALLOC_CHECK:  return AllocationCheck::run(commandLine);
+        case CommandLine::Mode::KERNEL_CHECK: return KernelCheck::run(commandLine);
+        case CommandLine::Mode::AUTOTUNE:     return Autotuner::run(commandLine);
+        case CommandLine::Mode::VERIFY:       return FilterCheck::run(commandLine);
+        case CommandLine::Mode::TEMPORAL:     return TemporalBenchmark::run(commandLine);
+        case CommandLine::Mode::RENDER:       return VideoRender::run(commandLine);
+        case CommandLine::Mode::SERVE:        return FilterService::run(commandLine);
+        case CommandLine::Mode::LOADGEN:      return LoadGenerator::run(commandLine);
+        case CommandLine::Mode::SHM_PRODUCE:  return ShmProducer::run(commandLine);
+        case CommandLine::Mode::SHM_CONSUME:  return ShmConsumer::run(commandLine);
+        case CommandLine::Mode::SHM_FILTER:   return ShmRelay::run(commandLine);
+        case CommandLine::Mode::PIPE:         return RawPipe::run(commandLine);
+        default:                              return 0;
+    }
+}
+
 int main(int argc, char *argv[])
 {
+    CommandLine commandLine;
+    
+    if (!commandLine.parse(argc, argv))
+    {
+        std::cerr << commandLine.getError() << std::endl << std::endl
+                  << CommandLine::usage(argv[0]);
+        return 1;
+    }
+    
+    if (commandLine.getMode() == CommandLine::Mode::HELP)
+    {
+        std::cout << CommandLine::usage(argv[0]);
+        return 0;
+    }
+    
+    if (commandLine.getMode() != CommandLine::Mode::GUI)
+    {
+        return runHeadless(commandLine);
+    }
+    
     QApplication app(argc, argv);
 
     MainWindow w;
@@ -73,6 +137,11 @@ int main(int argc, char *argv[])
     
     registerMetaTypes();
     
+    if (!commandLine.getShmInput().empty())
+    {
+        w.openSharedMemory(commandLine.getShmInput(), commandLine.getShmOutput());
+    }
+    
     setFusionStyle(app);
 
     return app.exec();
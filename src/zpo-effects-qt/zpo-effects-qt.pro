@@ -13,6 +13,9 @@ greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
 QMAKE_CXXFLAGS += -Wall -Wextra -pedantic
 
+# sqrt bez nastaveni errno, jinak se smycky s odmocninou nevektorizuji
+QMAKE_CXXFLAGS += -fno-math-errno
+
 equals(QT_MAJOR_VERSION, 4) {
     QMAKE_CXXFLAGS += -std=c++11
 }
@@ -20,34 +23,114 @@ equals(QT_MAJOR_VERSION, 5) {
     CONFIG += c++11
 }
 
+# std::thread (TaskScheduler)
+CONFIG += thread
+
+# shm_open (ShmRing)
+unix: LIBS += -lrt
+
 INCLUDEPATH += C:/opencv/build/include
 LIBS += C:/opencv/release/lib/libopencv_core2410.dll.a \
     C:/opencv/release/lib/libopencv_highgui2410.dll.a \
     C:/opencv/release/lib/libopencv_imgproc2410.dll.a
 
 SOURCES += \
+    AllocationCheck.cpp \
+    Autotuner.cpp \
+    Batch.cpp \
+    Benchmark.cpp \
+    BufferPool.cpp \
+    CommandLine.cpp \
+    FilterCheck.cpp \
+    FilterProfiler.cpp \
+    FilterService.cpp \
+    FrameFile.cpp \
+    FrameProcessor.cpp \
+    FrameQueue.cpp \
     ImageFilter.cpp \
+    ImageRefiner.cpp \
     ImageSource.cpp \
     ImageViewerOpenGl.cpp \
-    LabelChanger.cpp \
-    LoadingDialog.cpp \
+    IncrementalGlass.cpp \
+    KernelCheck.cpp \
+    KernelDispatch.cpp \
+    KernelsAvx2.cpp \
+    KernelsAvx512.cpp \
+    KernelsScalar.cpp \
+    KernelsSse4.cpp \
+    LatencyStats.cpp \
+    LoadGenerator.cpp \
     main.cpp \
     MainWindow.cpp \
-    Pixel.cpp \
-    VoronoiPoint.cpp
+    MemoryTracker.cpp \
+    PerfCounters.cpp \
+    PlanarImage.cpp \
+    PnmStream.cpp \
+    QualityGovernor.cpp \
+    RawPipe.cpp \
+    ReferenceFilter.cpp \
+    ReorderBuffer.cpp \
+    ScratchArena.cpp \
+    ServiceProtocol.cpp \
+    ShmConsumer.cpp \
+    ShmProducer.cpp \
+    ShmRelay.cpp \
+    ShmRing.cpp \
+    StreamFilter.cpp \
+    TaskScheduler.cpp \
+    TemporalBenchmark.cpp \
+    TiledExecutor.cpp \
+    VideoRender.cpp \
+    ViewportFilter.cpp
 
 HEADERS  += \
+    AllocationCheck.h \
+    Autotuner.h \
+    Batch.h \
+    Benchmark.h \
+    BufferPool.h \
+    CommandLine.h \
     Debug.h \
+    FilterCheck.h \
+    FilterProfiler.h \
+    FilterService.h \
+    FrameFile.h \
+    FrameProcessor.h \
+    FrameQueue.h \
     ImageFilter.h \
+    ImageRefiner.h \
     ImageSource.h \
     ImageViewerOpenGl.h \
-    LabelChanger.h \
-    LoadingDialog.h \
+    IncrementalGlass.h \
+    KernelCheck.h \
+    KernelDispatch.h \
+    KernelsImpl.hpp \
+    LatencyStats.h \
+    LoadGenerator.h \
     MainWindow.h \
-    Pixel.h \
+    MemoryTracker.h \
+    PerfCounters.h \
+    PixelExpr.h \
+    PlanarImage.h \
+    PnmStream.h \
+    QualityGovernor.h \
+    RawPipe.h \
+    ReferenceFilter.h \
+    ReorderBuffer.h \
     QListWidgetItemFilterType.hpp \
-    VoronoiPoint.h
+    ScratchArena.h \
+    ServiceProtocol.h \
+    ShmConsumer.h \
+    ShmProducer.h \
+    ShmRelay.h \
+    ShmRing.h \
+    Stencil3x3.h \
+    StreamFilter.h \
+    TaskScheduler.h \
+    TemporalBenchmark.h \
+    TiledExecutor.h \
+    VideoRender.h \
+    ViewportFilter.h
 
 FORMS    += \
-    LoadingDialog.ui \
     MainWindow.ui